@@ -7,21 +7,31 @@
  *
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* For mremap(). */
+#endif
+
 #include <stdio.h>
 #include <string.h>
+#include <assert.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
 
 #include "plinth.h"
 
 
-static pl_none pl_node__init( pl_node_t node )
+static pl_none plnd__put_chain( plnd_t plnd, pl_node_t first, pl_node_t last );
+
+
+static pl_none pl_node__init( pl_node_t node, pl_size_t size )
 {
     if ( node ) {
         node->prev = NULL;
         node->next = NULL;
         node->used = 0;
+        node->size = size;
     }
 }
 
@@ -36,7 +46,11 @@ static pl_none plam__use_type( plam_t    plam,
     plam->type = type;
     plam->align = 0;
     plam->host = host;
-    pl_node__init( node );
+    plam->limit = 0;
+    plam->large = NULL;
+    plam->flags = 0;
+    plam->base = PLAM_MARK_NULL;
+    pl_node__init( node, size );
 }
 
 static pl_t plam__align_forward( pl_t ptr, pl_size_t align )
@@ -44,17 +58,89 @@ static pl_t plam__align_forward( pl_t ptr, pl_size_t align )
     return (pl_t)( (pl_size_t)( ptr + ( align - 1 ) ) & ~( align - 1 ) );
 }
 
-static pl_t pl_node__allocate( pl_size_t size, pl_aa_t type, pl_t host, pl_size_t align )
+static pl_size_t pl__page_size( pl_none )
+{
+    return (pl_size_t)sysconf( _SC_PAGESIZE );
+}
+
+static pl_size_t pl_node__map_size( pl_size_t size, pl_size_t flags )
+{
+    if ( flags & PL_MF_HUGETLB ) {
+        return PLINTH_ALIGN_TO( size, PLINTH_HUGE_PAGE_SIZE );
+    } else {
+        return PLINTH_ALIGN_TO( size, pl__page_size() );
+    }
+}
+
+static pl_t pl_node__map( pl_size_t size, pl_size_t flags )
+{
+    pl_t mem;
+    int  prot;
+    int  map;
+
+    prot = PROT_READ | PROT_WRITE;
+    map = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    mem = MAP_FAILED;
+    if ( flags & PL_MF_HUGETLB ) {
+        if ( flags & PL_MF_POPULATE ) {
+            mem = mmap( NULL, size, prot, map | MAP_HUGETLB | MAP_POPULATE, -1, 0 );
+        } else {
+            mem = mmap( NULL, size, prot, map | MAP_HUGETLB, -1, 0 );
+        }
+    }
+
+    if ( mem == MAP_FAILED ) {
+
+        if ( flags & ( PL_MF_HUGE | PL_MF_HUGETLB ) ) {
+            /* No reserved huge pages, use transparent huge pages. */
+            mem = mmap( NULL, size, prot, map, -1, 0 );
+            if ( mem != MAP_FAILED ) {
+                madvise( mem, size, MADV_HUGEPAGE );
+                if ( flags & PL_MF_POPULATE ) {
+                    /* Prefault after madvise, for huge pages. */
+                    for ( pl_size_t i = 0; i < size; i += PLINTH_HUGE_PAGE_SIZE ) {
+                        ( (volatile uint8_t*)mem )[ i ] = 0;
+                    }
+                }
+            }
+        } else if ( flags & PL_MF_POPULATE ) {
+            mem = mmap( NULL, size, prot, map | MAP_POPULATE, -1, 0 );
+        } else {
+            mem = mmap( NULL, size, prot, map, -1, 0 );
+        }
+
+        if ( mem == MAP_FAILED ) {
+            /* GCOV_EXCL_START */
+            return NULL;
+            /* GCOV_EXCL_STOP */
+        }
+    }
+
+    return mem;
+}
+
+static pl_none pl_node__unmap( pl_node_t node )
+{
+    munmap( node, node->size );
+}
+
+static pl_t pl_node__allocate(
+    pl_size_t size, pl_aa_t type, pl_t host, pl_size_t align, pl_size_t flags )
 {
     pl_node_t node;
 
     switch ( type ) {
         case PL_AA_SELF:
-            node = pl_alloc_memory( size );
-            break;
         case PL_AA_HEAP:
-            if ( align == 0 ) {
-                node = pl_alloc_memory( size );
+            if ( align <= 1 ) {
+                if ( flags & PL_MF_NOZERO ) {
+                    node = pl_alloc_only( size );
+                } else {
+                    node = pl_alloc_memory( size );
+                }
+            } else if ( flags & PL_MF_NOZERO ) {
+                node = pl_alloc_aligned_only( size, align );
             } else {
                 node = pl_alloc_aligned( size, align );
             }
@@ -65,6 +151,13 @@ static pl_t pl_node__allocate( pl_size_t size, pl_aa_t type, pl_t host, pl_size_
         case PL_AA_PLBM:
             node = plbm_get( (plbm_t)host );
             break;
+        case PL_AA_PLND:
+            node = plnd_get( (plnd_t)host );
+            break;
+        case PL_AA_MMAP:
+            size = pl_node__map_size( size, flags );
+            node = pl_node__map( size, flags );
+            break;
         /* GCOV_EXCL_START */
         default:
             node = NULL;
@@ -72,12 +165,12 @@ static pl_t pl_node__allocate( pl_size_t size, pl_aa_t type, pl_t host, pl_size_
             /* GCOV_EXCL_STOP */
     }
 
-    pl_node__init( node );
+    pl_node__init( node, size );
 
     return node;
 }
 
-static pl_node_t pl_node__del( pl_node_t node, pl_size_t size, pl_aa_t type, pl_t host )
+static pl_node_t pl_node__del( pl_node_t node, pl_aa_t type, pl_t host )
 {
     if ( node ) {
 
@@ -120,7 +213,7 @@ static pl_node_t pl_node__del( pl_node_t node, pl_size_t size, pl_aa_t type, pl_
                 while ( left ) {
                     cur = left;
                     left = left->prev;
-                    plam_put( (plam_t)host, size );
+                    plam_put( (plam_t)host, cur->size );
                 }
                 break;
             case PL_AA_PLBM:
@@ -135,6 +228,28 @@ static pl_node_t pl_node__del( pl_node_t node, pl_size_t size, pl_aa_t type, pl_
                     plbm_put( (plbm_t)host, cur );
                 }
                 break;
+            case PL_AA_PLND:
+                right = node;
+                while ( left->prev ) {
+                    left = left->prev;
+                }
+                while ( right->next ) {
+                    right = right->next;
+                }
+                plnd__put_chain( (plnd_t)host, left, right );
+                break;
+            case PL_AA_MMAP:
+                while ( right ) {
+                    cur = right;
+                    right = right->next;
+                    pl_node__unmap( cur );
+                }
+                while ( left ) {
+                    cur = left;
+                    left = left->prev;
+                    pl_node__unmap( cur );
+                }
+                break;
             /* GCOV_EXCL_START */
             default:
                 node = NULL;
@@ -146,6 +261,171 @@ static pl_node_t pl_node__del( pl_node_t node, pl_size_t size, pl_aa_t type, pl_
     return NULL;
 }
 
+/*
+ * Return true, if node is the last allocation of plam host.
+ */
+static pl_bool_t pl_node__at_tip( pl_node_t node, plam_t host )
+{
+    pl_node_t top;
+
+    top = host->node;
+    if ( top && ( (uint8_t*)node + node->size ) == ( top->data + top->used ) ) {
+        return pl_true;
+    } else {
+        return pl_false;
+    }
+}
+
+/*
+ * Delete Nodes after node, except the reserve of count Nodes or size
+ * bytes (whichever keeps more).
+ */
+static pl_none pl_node__trim(
+    pl_node_t node, pl_size_t count, pl_size_t size, pl_aa_t type, pl_t host )
+{
+    pl_node_t last;
+    pl_node_t tail;
+    pl_node_t cur;
+    pl_size_t kept_count;
+    pl_size_t kept_size;
+
+    if ( node == NULL ) {
+        return;
+    }
+
+    kept_count = 0;
+    kept_size = 0;
+    last = node;
+    while ( last->next && ( kept_count < count || kept_size + last->next->size <= size ) ) {
+        last = last->next;
+        kept_count++;
+        kept_size += last->size;
+    }
+
+    if ( type == PL_AA_PLAM ) {
+        /* Host releases only its last allocation, hence release from
+           the end while at host tip, and keep the rest in the chain. */
+        tail = last;
+        while ( tail->next ) {
+            tail = tail->next;
+        }
+        while ( tail != last && pl_node__at_tip( tail, (plam_t)host ) ) {
+            cur = tail;
+            tail = tail->prev;
+            tail->next = NULL;
+            plam_put( (plam_t)host, cur->size );
+        }
+        return;
+    }
+
+    tail = last->next;
+    if ( tail ) {
+        last->next = NULL;
+        tail->prev = NULL;
+        if ( type == PL_AA_SELF ) {
+            /* Only the first Node is user memory. */
+            type = PL_AA_HEAP;
+        }
+        pl_node__del( tail, type, host );
+    }
+}
+
+
+static pl_size_t plam__max_capacity( plam_t plam )
+{
+    if ( plam->limit > plam->size ) {
+        return plam->limit - sizeof( pl_node_s );
+    } else {
+        return plam->size - sizeof( pl_node_s );
+    }
+}
+
+static pl_none plam__double( plam_t plam )
+{
+    if ( plam->size * 2 < plam->limit ) {
+        plam->size = plam->size * 2;
+    } else if ( plam->size < plam->limit ) {
+        plam->size = plam->limit;
+    }
+}
+
+/*
+ * Grow Node size (for the next Node) until allocation fits. Oversize
+ * allocations are handled by caller.
+ */
+static pl_none plam__fit( plam_t plam, pl_size_t size )
+{
+    while ( plam_node_capacity( plam ) < size ) {
+        plam__double( plam );
+    }
+}
+
+static pl_t plam__get_large( plam_t plam, pl_size_t size )
+{
+    pl_node_t node;
+    pl_size_t nsize;
+
+    if ( plam->type == PL_AA_PLBM || plam->type == PL_AA_PLND ) {
+        /* Host has fixed Node size. */
+        return NULL;
+    }
+
+    nsize = sizeof( pl_node_s ) + size;
+    if ( plam->align ) {
+        nsize = PLINTH_ALIGN_TO( nsize, plam->align );
+    }
+
+    if ( plam->type == PL_AA_PLAM ) {
+        /* Host can only release its last allocation, hence heap. */
+        node = pl_node__allocate( nsize, PL_AA_HEAP, NULL, plam->align, plam->flags );
+    } else {
+        node = pl_node__allocate( nsize, plam->type, plam->host, plam->align, plam->flags );
+    }
+    if ( node == NULL ) {
+        /* GCOV_EXCL_START */
+        return NULL;
+        /* GCOV_EXCL_STOP */
+    }
+
+    node->used = size;
+    node->next = plam->large;
+    plam->large = node;
+
+    return node->data;
+}
+
+static pl_none plam__put_large( plam_t plam )
+{
+    pl_node_t node;
+
+    node = plam->large;
+    plam->large = node->next;
+
+    if ( plam->type == PL_AA_MMAP ) {
+        pl_node__unmap( node );
+    } else {
+        pl_free_memory( node );
+    }
+}
+
+static pl_none plnd__put_chain( plnd_t plnd, pl_node_t first, pl_node_t last )
+{
+    pl_size_t count;
+    pl_node_t cur;
+
+    count = 1;
+    for ( cur = first; cur != last; cur = cur->next ) {
+        count++;
+    }
+
+    first->prev = NULL;
+    pthread_mutex_lock( &plnd->lock );
+    last->next = plnd->head;
+    plnd->head = first;
+    plnd->count += count;
+    pthread_mutex_unlock( &plnd->lock );
+}
+
 
 static pl_bool_t plbm__is_valid( pl_size_t nsize, pl_size_t bsize )
 {
@@ -156,17 +436,52 @@ static pl_bool_t plbm__is_valid( pl_size_t nsize, pl_size_t bsize )
     }
 }
 
+/*
+ * Padding before the first Block of Node. Heap and mapped Nodes are
+ * allocated with alignment, and with others the worst case is used.
+ */
+static pl_size_t plbm__pad( plbm_t plbm )
+{
+    if ( plbm->type == PL_AA_HEAP || plbm->type == PL_AA_MMAP ) {
+        return PLINTH_ALIGN_TO( sizeof( pl_node_s ), plbm->amask + 1 ) - sizeof( pl_node_s );
+    } else {
+        return plbm->amask;
+    }
+}
+
 static pl_size_t plbm__itail( plbm_t plbm )
 {
     pl_size_t ret;
-    ret = PLINTH_ALIGN_TO( plbm->nsize - sizeof( pl_node_s ), plbm->bsize ) / plbm->bsize;
-    if ( ( ( plbm->nsize - sizeof( pl_node_s ) ) % plbm->bsize ) == 0 ) {
+    pl_size_t capacity;
+    capacity = plbm->nsize - sizeof( pl_node_s ) - plbm__pad( plbm );
+    ret = PLINTH_ALIGN_TO( capacity, plbm->bsize ) / plbm->bsize;
+    if ( ( capacity % plbm->bsize ) == 0 ) {
         return ret;
     } else {
         return ret - 1;
     }
 }
 
+/*
+ * Return address of the first Block in Node.
+ */
+static pl_t plbm__base( plbm_t plbm, pl_node_t node )
+{
+    return (pl_t)( ( (pl_size_t)node->data + plbm->amask ) & ~plbm->amask );
+}
+
+/*
+ * Return count of Blocks to carve from init tail of current Node.
+ */
+static pl_size_t plbm__carve_count( plbm_t plbm, pl_size_t count )
+{
+    if ( count < plbm->itail ) {
+        return count;
+    } else {
+        return plbm->itail;
+    }
+}
+
 static pl_none plbm__use_type( plbm_t    plbm,
                                pl_node_t node,
                                pl_size_t nsize,
@@ -180,14 +495,18 @@ static pl_none plbm__use_type( plbm_t    plbm,
     plbm->bsize = bsize;
     plbm->type = type;
     plbm->host = host;
-    pl_node__init( node );
+    plbm->flags = 0;
+    plbm->amask = 0;
+    pl_node__init( node, nsize );
     if ( plbm__is_valid( nsize, bsize ) ) {
-        plbm->itail = plbm__itail( plbm );
+        plbm->imax = plbm__itail( plbm );
+        plbm->itail = plbm->imax;
     } else {
         plbm->node = NULL;
         plbm->nsize = nsize;
         plbm->bsize = bsize;
         plbm->itail = 0;
+        plbm->imax = 0;
     }
 }
 
@@ -196,6 +515,68 @@ static pl_none plbm__invalid( plbm_t plbm )
     plbm__use_type( plbm, NULL, 0, 0, PL_AA_SELF, NULL );
 }
 
+/*
+ * Setup empty plbm with Block alignment, and allocate the first Node.
+ */
+static pl_none plbm__use_aligned(
+    plbm_t plbm, pl_size_t nsize, pl_size_t bsize, pl_size_t align, pl_aa_t type, pl_t host )
+{
+    if ( align > 1 ) {
+        bsize = PLINTH_ALIGN_TO( bsize, align );
+    } else {
+        align = 1;
+    }
+
+    plbm__use_type( plbm, NULL, nsize, bsize, type, host );
+    plbm->amask = align - 1;
+
+    if ( plbm__is_valid( nsize, plbm__pad( plbm ) + bsize ) ) {
+        plbm->imax = plbm__itail( plbm );
+        plbm->itail = plbm->imax;
+        plbm->node = pl_node__allocate( nsize, type, host, align, 0 );
+    } else {
+        plbm__invalid( plbm );
+    }
+}
+
+static int plbm__node_compare( const void* a, const void* b )
+{
+    pl_node_t na = *(pl_node_t*)a;
+    pl_node_t nb = *(pl_node_t*)b;
+
+    if ( na < nb ) {
+        return -1;
+    } else if ( na > nb ) {
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+/*
+ * Find Node of Block from Nodes sorted by address.
+ */
+static pl_node_t plbm__find_node( pl_node_t* nodes, pl_size_t count, pl_t block )
+{
+    pl_size_t lo;
+    pl_size_t hi;
+    pl_size_t mid;
+
+    /* Last Node with address below Block. */
+    lo = 0;
+    hi = count;
+    while ( hi - lo > 1 ) {
+        mid = lo + ( hi - lo ) / 2;
+        if ( (pl_t)nodes[ mid ] < block ) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return nodes[ lo ];
+}
+
 
 static pl_none plcm__init( plcm_t plcm )
 {
@@ -203,74 +584,261 @@ static pl_none plcm__init( plcm_t plcm )
     plcm->used = 0;
     plcm->data = NULL;
     plcm->type = PL_AA_SELF;
+    plcm->reserve = 0;
+    plcm->align = 0;
+    plcm->flags = 0;
+    plcm->growth = PL_GP_DOUBLE;
+    plcm->gcap = 0;
+    plcm->host = NULL;
 }
 
-
-static pl_none plss__terminate( plcm_t plcm )
+/*
+ * Allocate data for plcm (with alignment, if any). Size is updated
+ * to multiple of alignment.
+ */
+static pl_t plcm__alloc( plcm_t plcm, pl_size_t* size )
 {
-    *( (char*)( plcm->data + plcm->used ) ) = 0;
+    if ( plcm->align ) {
+        *size = PLINTH_ALIGN_TO( *size, plcm->align );
+        if ( plcm->flags & PL_MF_NOZERO ) {
+            return pl_alloc_aligned_only( *size, plcm->align );
+        } else {
+            return pl_alloc_aligned( *size, plcm->align );
+        }
+    } else if ( plcm->flags & PL_MF_NOZERO ) {
+        return pl_alloc_only( *size );
+    } else {
+        return pl_alloc_memory( *size );
+    }
 }
 
 
+/*
+ * Return new size for growing plcm (at least) to size, according to
+ * growth policy.
+ */
+static pl_size_t plcm__grow_size( plcm_t plcm, pl_size_t size )
+{
+    pl_size_t new_size;
 
-/* ------------------------------------------------------------
-   -------------------------- PUBLIC --------------------------
-   ------------------------------------------------------------ */
-
+    switch ( plcm->growth ) {
+        case PL_GP_HALF:
+            new_size = plcm->size + plcm->size / 2;
+            break;
+        case PL_GP_PAGE:
+            return PLINTH_ALIGN_TO( size, pl__page_size() );
+        case PL_GP_CAPPED:
+            if ( plcm->gcap > 0 && plcm->size > plcm->gcap ) {
+                new_size = plcm->size + plcm->gcap;
+            } else {
+                new_size = 2 * plcm->size;
+            }
+            break;
+        default:
+            /*
+              By default, we double the allocation, but if that is not
+              enough, we resize to the next sufficient multiple of
+              plcm->size.
+             */
+            if ( size > 2 * plcm->size ) {
+                return PLINTH_ALIGN_TO( size, plcm->size );
+            } else {
+                return 2 * plcm->size;
+            }
+    }
 
-pl_none pl_dummy( pl_none ) {} /* GCOV_EXCL_LINE */
+    if ( new_size < size ) {
+        new_size = size;
+    }
 
+    return PLINTH_ALIGN_TO( new_size, 64 );
+}
 
 
-/* ------------------------------------------------------------
- * Basic (heap) memory allocation:
+/*
+ * Remap pages of mapped plcm to size.
  */
-
-pl_t pl_alloc_memory( pl_size_t size )
+static pl_bool_t plcm__remap( plcm_t plcm, pl_size_t size )
 {
-    return calloc( 1, (size_t)size );
-}
+    pl_t mem;
 
-pl_t pl_alloc_aligned( pl_size_t size, pl_size_t align )
-{
-    pl_t ret;
-    ret = aligned_alloc( align, size );
-    memset( ret, 0, size );
-    return ret;
-}
+    mem = mremap( plcm->data, plcm->size, size, MREMAP_MAYMOVE );
+    if ( mem == MAP_FAILED ) {
+        return pl_false; /* GCOV_EXCL_LINE */
+    }
+    plcm->data = mem;
+    plcm->size = size;
 
-pl_t pl_alloc_only( pl_size_t size )
-{
-    return malloc( (size_t)size );
+    return pl_true;
 }
 
 
-pl_none pl_free_memory( pl_t mem )
+/*
+ * Return true if plam hosted plcm is the last allocation in the
+ * current Node of host.
+ */
+static pl_bool_t plcm__at_tip( plcm_t plcm )
 {
-    free( (void*)mem );
+    pl_node_t node;
+
+    node = ( (plam_t)plcm->host )->node;
+    if ( node && ( plcm->data + plcm->size ) == ( node->data + node->used ) ) {
+        return pl_true;
+    } else {
+        return pl_false;
+    }
 }
 
 
-pl_t pl_realloc_memory( pl_t mem, pl_size_t size )
+/*
+ * Grow plam hosted plcm. Plcm is extended in place at the tip of
+ * host, and otherwise relocated within host.
+ */
+static pl_bool_t plcm__grow_plam( plcm_t plcm, pl_size_t size )
 {
-    return realloc( (void*)mem, (size_t)size );
-}
+    plam_t    host;
+    pl_size_t new_size;
+    pl_t      mem;
 
+    host = plcm->host;
 
-plsr_s pl_alloc_plsr( plsr_s plsr )
-{
-    char* str;
-    str = pl_alloc_only( plsr_length( plsr ) + 1 );
-    if ( str ) {
-        memcpy( str, plsr_string( plsr ), plsr_length( plsr ) + 1 );
-        return plsr_from_string_and_length( str, plsr_length( plsr ) );
+    if ( plcm->size > 0 ) {
+        new_size = plcm__grow_size( plcm, size );
     } else {
-        return plsr_null(); /* GCOV_EXCL_LINE */
+        new_size = PLINTH_ALIGN_TO( size, 64 );
+    }
+
+    mem = NULL;
+    if ( plcm__at_tip( plcm ) ) {
+        if ( plam_free( host ) < new_size - plcm->size ) {
+            /* Take only the required size from the rest of Node. */
+            new_size = size;
+        }
+        if ( plam_free( host ) >= new_size - plcm->size ) {
+            host->node->used += new_size - plcm->size;
+            mem = plcm->data;
+        }
+    }
+
+    if ( mem == NULL ) {
+        mem = plam_get( host, new_size );
+        if ( mem == NULL ) {
+            return pl_false; /* GCOV_EXCL_LINE */
+        }
+        memcpy( mem, plcm->data, plcm->size );
+    }
+
+    if ( !( plcm->flags & PL_MF_NOZERO ) ) {
+        memset( mem + plcm->size, 0, new_size - plcm->size );
     }
+    plcm->data = mem;
+    plcm->size = new_size;
+
+    return pl_true;
 }
 
 
-char* pl_alloc_string( const char* str )
+/*
+ * Commit pages of reserved plcm for size. Committed size is doubled
+ * (at least) to reduce the number of mprotect calls.
+ */
+static pl_bool_t plcm__commit( plcm_t plcm, pl_size_t size )
+{
+    pl_size_t new_size;
+
+    if ( size > plcm->reserve ) {
+        return pl_false;
+    }
+
+    if ( size > 2 * plcm->size ) {
+        new_size = PLINTH_ALIGN_TO( size, pl__page_size() );
+    } else {
+        new_size = PLINTH_ALIGN_TO( 2 * plcm->size, pl__page_size() );
+    }
+    if ( new_size > plcm->reserve ) {
+        new_size = plcm->reserve;
+    }
+
+    if ( mprotect( plcm->data + plcm->size, new_size - plcm->size, PROT_READ | PROT_WRITE )
+         != 0 ) {
+        return pl_false; /* GCOV_EXCL_LINE */
+    }
+    plcm->size = new_size;
+
+    return pl_true;
+}
+
+
+static pl_none plss__terminate( plcm_t plcm )
+{
+    *( (char*)( plcm->data + plcm->used ) ) = 0;
+}
+
+
+
+/* ------------------------------------------------------------
+   -------------------------- PUBLIC --------------------------
+   ------------------------------------------------------------ */
+
+
+pl_none pl_dummy( pl_none ) {} /* GCOV_EXCL_LINE */
+
+
+
+/* ------------------------------------------------------------
+ * Basic (heap) memory allocation:
+ */
+
+pl_t pl_alloc_memory( pl_size_t size )
+{
+    return calloc( 1, (size_t)size );
+}
+
+pl_t pl_alloc_aligned( pl_size_t size, pl_size_t align )
+{
+    pl_t ret;
+    ret = aligned_alloc( align, size );
+    memset( ret, 0, size );
+    return ret;
+}
+
+pl_t pl_alloc_only( pl_size_t size )
+{
+    return malloc( (size_t)size );
+}
+
+pl_t pl_alloc_aligned_only( pl_size_t size, pl_size_t align )
+{
+    return aligned_alloc( align, size );
+}
+
+
+pl_none pl_free_memory( pl_t mem )
+{
+    free( (void*)mem );
+}
+
+
+pl_t pl_realloc_memory( pl_t mem, pl_size_t size )
+{
+    return realloc( (void*)mem, (size_t)size );
+}
+
+
+plsr_s pl_alloc_plsr( plsr_s plsr )
+{
+    char* str;
+    str = pl_alloc_only( plsr_length( plsr ) + 1 );
+    if ( str ) {
+        memcpy( str, plsr_string( plsr ), plsr_length( plsr ) + 1 );
+        return plsr_from_string_and_length( str, plsr_length( plsr ) );
+    } else {
+        return plsr_null(); /* GCOV_EXCL_LINE */
+    }
+}
+
+
+char* pl_alloc_string( const char* str )
 {
     if ( str ) {
         plsr_s plsr;
@@ -342,7 +910,12 @@ pl_none plam_new( plam_t plam, pl_size_t size )
         plam->type = PL_AA_HEAP;
         plam->host = NULL;
         plam->align = 0;
-        plam->node = pl_node__allocate( plam->size, plam->type, plam->host, plam->align );
+        plam->limit = 0;
+        plam->large = NULL;
+        plam->flags = 0;
+        plam->base = PLAM_MARK_NULL;
+        plam->node =
+            pl_node__allocate( plam->size, plam->type, plam->host, plam->align, plam->flags );
 
         if ( plam->node == NULL ) {
             plam->size = 0;          /* GCOV_EXCL_LINE */
@@ -364,7 +937,32 @@ pl_none plam_new_aligned( plam_t plam, pl_size_t size, pl_size_t align )
         plam->type = PL_AA_HEAP;
         plam->host = NULL;
         plam->align = align;
-        plam->node = pl_node__allocate( plam->size, plam->type, plam->host, plam->align );
+        plam->limit = 0;
+        plam->large = NULL;
+        plam->flags = 0;
+        plam->base = PLAM_MARK_NULL;
+        plam->node =
+            pl_node__allocate( plam->size, plam->type, plam->host, plam->align, plam->flags );
+
+        if ( plam->node == NULL ) {
+            plam->size = 0;          /* GCOV_EXCL_LINE */
+            plam->type = PL_AA_NONE; /* GCOV_EXCL_LINE */
+        }
+
+    } else {
+        /* Invalid plam. */
+        plam_empty( plam, 0 );
+    }
+}
+
+
+pl_none plam_new_mmap( plam_t plam, pl_size_t size, pl_size_t flags )
+{
+    if ( size > sizeof( pl_node_s ) ) {
+
+        plam_empty_mmap( plam, size, flags );
+        plam->node =
+            pl_node__allocate( plam->size, plam->type, plam->host, plam->align, plam->flags );
 
         if ( plam->node == NULL ) {
             plam->size = 0;          /* GCOV_EXCL_LINE */
@@ -398,7 +996,10 @@ pl_none plam_use_plbm( plam_t plam, plbm_t host )
 
 pl_none plam_into_plam( plam_t plam, plam_t host, pl_size_t size )
 {
+    plam_mark_s base;
+    base = plam_mark( host );
     plam__use_type( plam, plam_get( host, size ), size, PL_AA_PLAM, host );
+    plam->base = base;
 }
 
 
@@ -408,6 +1009,12 @@ pl_none plam_into_plbm( plam_t plam, plbm_t host )
 }
 
 
+pl_none plam_into_plnd( plam_t plam, plnd_t host )
+{
+    plam__use_type( plam, plnd_get( host ), plnd_node_size( host ), PL_AA_PLND, host );
+}
+
+
 pl_none plam_empty( plam_t plam, pl_size_t size )
 {
     plam->node = NULL;
@@ -416,6 +1023,10 @@ pl_none plam_empty( plam_t plam, pl_size_t size )
     plam->type = PL_AA_HEAP;
     plam->align = 0;
     plam->host = NULL;
+    plam->limit = 0;
+    plam->large = NULL;
+    plam->flags = 0;
+    plam->base = PLAM_MARK_NULL;
 }
 
 
@@ -427,6 +1038,24 @@ pl_none plam_empty_aligned( plam_t plam, pl_size_t size, pl_size_t align )
     plam->type = PL_AA_HEAP;
     plam->align = align;
     plam->host = NULL;
+    plam->limit = 0;
+    plam->large = NULL;
+    plam->flags = 0;
+    plam->base = PLAM_MARK_NULL;
+}
+
+
+pl_none plam_empty_mmap( plam_t plam, pl_size_t size, pl_size_t flags )
+{
+    plam->node = NULL;
+    plam->size = pl_node__map_size( size, flags );
+    plam->type = PL_AA_MMAP;
+    plam->align = 0;
+    plam->host = NULL;
+    plam->limit = 0;
+    plam->large = NULL;
+    plam->flags = flags;
+    plam->base = PLAM_MARK_NULL;
 }
 
 
@@ -437,6 +1066,10 @@ pl_none plam_empty_into_plam( plam_t plam, plam_t host, pl_size_t size )
     plam->type = PL_AA_PLAM;
     plam->align = 0;
     plam->host = host;
+    plam->limit = 0;
+    plam->large = NULL;
+    plam->flags = 0;
+    plam->base = plam_mark( host );
 }
 
 
@@ -447,29 +1080,108 @@ pl_none plam_empty_into_plbm( plam_t plam, plbm_t host )
     plam->type = PL_AA_PLBM;
     plam->align = 0;
     plam->host = host;
+    plam->limit = 0;
+    plam->large = NULL;
+    plam->flags = 0;
+    plam->base = PLAM_MARK_NULL;
+}
+
+
+pl_none plam_empty_into_plnd( plam_t plam, plnd_t host )
+{
+    plam->node = NULL;
+    plam->size = plnd_node_size( host );
+    plam->type = PL_AA_PLND;
+    plam->align = 0;
+    plam->host = host;
+    plam->limit = 0;
+    plam->large = NULL;
+    plam->flags = 0;
+    plam->base = PLAM_MARK_NULL;
+}
+
+
+pl_none plam_grow( plam_t plam, pl_size_t limit )
+{
+    if ( plam->type != PL_AA_PLBM && plam->type != PL_AA_PLND ) {
+        plam->limit = limit;
+    }
+}
+
+
+pl_none plam_set_zeroing( plam_t plam, pl_bool_t zeroing )
+{
+    if ( zeroing ) {
+        plam->flags &= ~PL_MF_NOZERO;
+    } else {
+        plam->flags |= PL_MF_NOZERO;
+    }
+}
+
+
+/* Thread local plam, and key for returning Nodes at thread exit. */
+static _Thread_local plam_s plam__local;
+static pthread_key_t        plam__local_key;
+static pthread_once_t       plam__local_once = PTHREAD_ONCE_INIT;
+
+static pl_none plam__local_exit( pl_t plam )
+{
+    plam_del( (plam_t)plam );
+}
+
+static pl_none plam__local_init( pl_none )
+{
+    pthread_key_create( &plam__local_key, plam__local_exit );
+}
+
+
+plam_t plam_local( plnd_t host )
+{
+    if ( plam__local.host != host ) {
+        if ( plam__local.host ) {
+            plam_del( &plam__local );
+        } else {
+            pthread_once( &plam__local_once, plam__local_init );
+            pthread_setspecific( plam__local_key, &plam__local );
+        }
+        plam_empty_into_plnd( &plam__local, host );
+    }
+    return &plam__local;
+}
+
+
+pl_none plam_local_del( pl_none )
+{
+    plam_del( &plam__local );
 }
 
 
 pl_none plam_del( plam_t plam )
 {
-    plam->node = pl_node__del( plam->node, plam->size, plam->type, plam->host );
+    while ( plam->large ) {
+        plam__put_large( plam );
+    }
+    if ( plam->type == PL_AA_PLAM ) {
+        /* Release all Nodes from host at once. */
+        plam_rewind( (plam_t)plam->host, plam->base );
+    } else {
+        pl_node__del( plam->node, plam->type, plam->host );
+    }
     plam_empty( plam, 0 );
 }
 
 
-pl_t plam_get( plam_t plam, pl_size_t size )
+pl_t plam_get_slow( plam_t plam, pl_size_t size )
 {
-    if ( size > plam_node_capacity( plam ) ) {
-        /* Too large allocation. */
-        return NULL;
+    if ( size > plam__max_capacity( plam ) ) {
+        /* Oversize allocation. */
+        return plam__get_large( plam, size );
     }
 
     if ( plam->node == NULL ) {
-        if ( plam->align == 0 ) {
-            plam->node = pl_node__allocate( plam->size, plam->type, plam->host, 0 );
-        } else {
-            plam->node = pl_node__allocate( plam->size, plam->type, plam->host, plam->align );
-        }
+        plam__fit( plam, size );
+        plam->node =
+            pl_node__allocate( plam->size, plam->type, plam->host, plam->align, plam->flags );
         if ( plam->node == NULL ) {
             /* GCOV_EXCL_START */
             return NULL;
@@ -483,18 +1195,20 @@ pl_t plam_get( plam_t plam, pl_size_t size )
 
             if ( plam->node->next ) {
 
-                /* Advance to next node and retry. */
+                /* Advance to next node and retry. Nodes after the
+                   current node are unused, but after plam_rewind()
+                   their used count is stale. */
                 plam->node = plam->node->next;
+                plam->node->used = 0;
 
             } else {
 
                 /* Allocate new node. */
                 pl_node_t node;
-                if ( plam->align == 0 ) {
-                    node = pl_node__allocate( plam->size, plam->type, plam->host, 0 );
-                } else {
-                    node = pl_node__allocate( plam->size, plam->type, plam->host, plam->align );
-                }
+                plam__double( plam );
+                plam__fit( plam, size );
+                node = pl_node__allocate(
+                    plam->size, plam->type, plam->host, plam->align, plam->flags );
                 if ( node == NULL ) {
                     /* GCOV_EXCL_START */
                     return NULL;
@@ -550,6 +1264,11 @@ pl_t plam_get_aligned( plam_t plam, pl_size_t size, pl_size_t align )
 
 pl_none plam_put( plam_t plam, pl_size_t size )
 {
+    if ( plam->large && size > plam__max_capacity( plam ) ) {
+        plam__put_large( plam );
+        return;
+    }
+
     while ( 1 ) {
         if ( plam->node->used > 0 ) {
             plam->node->used -= size;
@@ -565,6 +1284,14 @@ pl_none plam_put( plam_t plam, pl_size_t size )
 
 pl_none plam_clear( plam_t plam )
 {
+    while ( plam->large ) {
+        plam__put_large( plam );
+    }
+
+    if ( plam->node == NULL ) {
+        return;
+    }
+
     while ( 1 ) {
         if ( plam->node->used > 0 ) {
             plam->node->used = 0;
@@ -577,6 +1304,38 @@ pl_none plam_clear( plam_t plam )
 }
 
 
+pl_none plam_trim( plam_t plam, pl_size_t count, pl_size_t size )
+{
+    pl_node__trim( plam->node, count, size, plam->type, plam->host );
+}
+
+
+plam_mark_s plam_mark( plam_t plam )
+{
+    plam_mark_s mark;
+    mark.node = plam->node;
+    mark.used = plam_used( plam );
+    mark.large = plam->large;
+    return mark;
+}
+
+
+pl_none plam_rewind( plam_t plam, plam_mark_s mark )
+{
+    while ( plam->large != mark.large ) {
+        plam__put_large( plam );
+    }
+
+    if ( mark.node ) {
+        plam->node = mark.node;
+        plam->node->used = mark.used;
+    } else if ( plam->node ) {
+        /* Mark was taken before the first node. */
+        plam_clear( plam );
+    }
+}
+
+
 pl_t plam_store( plam_t plam, const pl_t data, pl_size_t size )
 {
     pl_t mem;
@@ -656,7 +1415,7 @@ pl_size_t plam_used( plam_t plam )
 pl_size_t plam_free( plam_t plam )
 {
     if ( plam->node ) {
-        return plam_node_capacity( plam ) - plam->node->used;
+        return plam->node->size - sizeof( pl_node_s ) - plam->node->used;
     } else {
         return 0;
     }
@@ -677,7 +1436,104 @@ pl_size_t plam_node_capacity( plam_t plam )
 
 pl_bool_t plam_is_empty( plam_t plam )
 {
-    return ( plam->node == NULL );
+    return ( plam->node == NULL && plam->large == NULL );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Arena Shared Memory Allocator:
+ */
+
+/*
+ * Chain new node after the full node. Another thread might have
+ * chained already, and then the new node is not needed.
+ */
+static pl_bool_t plas__chain( plas_t plas, pl_node_t full )
+{
+    pl_node_t node;
+    pl_bool_t ret;
+
+    ret = pl_true;
+
+    pthread_mutex_lock( &plas->lock );
+    if ( plas->plam.node == full ) {
+        node = pl_node__allocate(
+            plas->plam.size, plas->plam.type, plas->plam.host, 0, plas->plam.flags );
+        if ( node ) {
+            node->prev = full;
+            if ( full ) {
+                full->next = node;
+            }
+            __atomic_store_n( &plas->plam.node, node, __ATOMIC_RELEASE );
+        } else {
+            ret = pl_false; /* GCOV_EXCL_LINE */
+        }
+    }
+    pthread_mutex_unlock( &plas->lock );
+
+    return ret;
+}
+
+
+pl_none plas_new( plas_t plas, pl_size_t size )
+{
+    plam_new( &plas->plam, size );
+    pthread_mutex_init( &plas->lock, NULL );
+}
+
+
+pl_none plas_del( plas_t plas )
+{
+    plam_del( &plas->plam );
+    pthread_mutex_destroy( &plas->lock );
+}
+
+
+pl_t plas_get( plas_t plas, pl_size_t size )
+{
+    pl_node_t node;
+    pl_size_t used;
+
+    if ( plas->plam.size <= sizeof( pl_node_s ) || size > plas_node_capacity( plas ) ) {
+        /* Invalid plas or too large allocation. */
+        return NULL;
+    }
+
+    while ( 1 ) {
+
+        node = __atomic_load_n( &plas->plam.node, __ATOMIC_ACQUIRE );
+
+        if ( node ) {
+            /* Fast path: claim space from current node. The used
+               count may overshoot the capacity, when node is full. */
+            used = __atomic_fetch_add( &node->used, size, __ATOMIC_RELAXED );
+            if ( used + size <= plas_node_capacity( plas ) ) {
+                return node->data + used;
+            }
+        }
+
+        if ( !plas__chain( plas, node ) ) {
+            return NULL; /* GCOV_EXCL_LINE */
+        }
+    }
+}
+
+
+pl_t plas_store( plas_t plas, const pl_t data, pl_size_t size )
+{
+    pl_t mem;
+    mem = plas_get( plas, size );
+    if ( mem ) {
+        memcpy( mem, data, size );
+    }
+    return mem;
+}
+
+
+pl_size_t plas_node_capacity( plas_t plas )
+{
+    return plam_node_capacity( &plas->plam );
 }
 
 
@@ -689,8 +1545,12 @@ pl_bool_t plam_is_empty( plam_t plam )
 pl_none plbm_new( plbm_t plbm, pl_size_t nsize, pl_size_t bsize )
 {
     if ( plbm__is_valid( nsize, bsize ) ) {
-        plbm__use_type(
-            plbm, pl_node__allocate( nsize, PL_AA_HEAP, NULL, 0 ), nsize, bsize, PL_AA_HEAP, NULL );
+        plbm__use_type( plbm,
+                        pl_node__allocate( nsize, PL_AA_HEAP, NULL, 0, 0 ),
+                        nsize,
+                        bsize,
+                        PL_AA_HEAP,
+                        NULL );
     } else {
         plbm__invalid( plbm );
     }
@@ -703,6 +1563,28 @@ pl_none plbm_new_with_count( plbm_t plbm, pl_size_t bcount, pl_size_t bsize )
 }
 
 
+pl_none plbm_new_aligned( plbm_t plbm, pl_size_t nsize, pl_size_t bsize, pl_size_t align )
+{
+    if ( align > 1 ) {
+        nsize = PLINTH_ALIGN_TO( nsize, align );
+    }
+    plbm__use_aligned( plbm, nsize, bsize, align, PL_AA_HEAP, NULL );
+}
+
+
+pl_none plbm_new_mmap( plbm_t plbm, pl_size_t nsize, pl_size_t bsize, pl_size_t flags )
+{
+    nsize = pl_node__map_size( nsize, flags );
+    if ( plbm__is_valid( nsize, bsize ) ) {
+        plbm__use_type( plbm, NULL, nsize, bsize, PL_AA_MMAP, NULL );
+        plbm->flags = flags;
+        plbm->node = pl_node__allocate( nsize, PL_AA_MMAP, NULL, 0, flags );
+    } else {
+        plbm__invalid( plbm );
+    }
+}
+
+
 pl_none plbm_use( plbm_t plbm, pl_t node, pl_size_t nsize, pl_size_t bsize )
 {
     if ( plbm__is_valid( nsize, bsize ) ) {
@@ -737,6 +1619,19 @@ pl_none plbm_into_plbm( plbm_t plbm, plbm_t host, pl_size_t bsize )
 }
 
 
+pl_none plbm_into_plam_aligned(
+    plbm_t plbm, plam_t host, pl_size_t nsize, pl_size_t bsize, pl_size_t align )
+{
+    plbm__use_aligned( plbm, nsize, bsize, align, PL_AA_PLAM, host );
+}
+
+
+pl_none plbm_into_plbm_aligned( plbm_t plbm, plbm_t host, pl_size_t bsize, pl_size_t align )
+{
+    plbm__use_aligned( plbm, plbm_block_size( host ), bsize, align, PL_AA_PLBM, host );
+}
+
+
 pl_none plbm_empty( plbm_t plbm, pl_size_t nsize, pl_size_t bsize )
 {
     /* NOTE: empty must be HEAP, since it will get the allocation. */
@@ -756,17 +1651,28 @@ pl_none plbm_empty_into_plbm( plbm_t plbm, plbm_t host, pl_size_t bsize )
 }
 
 
-pl_none plbm_del( plbm_t plbm )
+pl_none plbm_set_zeroing( plbm_t plbm, pl_bool_t zeroing )
 {
-    pl_node__del( plbm->node, plbm->nsize, plbm->type, plbm->host );
-    plbm__invalid( plbm );
-}
+    if ( zeroing ) {
+        plbm->flags &= ~PL_MF_NOZERO;
+    } else {
+        plbm->flags |= PL_MF_NOZERO;
+    }
+}
+
+
+pl_none plbm_del( plbm_t plbm )
+{
+    pl_node__del( plbm->node, plbm->type, plbm->host );
+    plbm__invalid( plbm );
+}
 
 
-pl_t plbm_get( plbm_t plbm )
+pl_t plbm_get_slow( plbm_t plbm )
 {
     if ( plbm->node == NULL ) {
-        plbm->node = pl_node__allocate( plbm->nsize, plbm->type, plbm->host, 0 );
+        plbm->node = pl_node__allocate(
+            plbm->nsize, plbm->type, plbm->host, plbm->amask + 1, plbm->flags );
         if ( plbm->node == NULL ) {
             /* GCOV_EXCL_START */
             return NULL;
@@ -780,7 +1686,7 @@ pl_t plbm_get( plbm_t plbm )
         ret = plbm->head;
         plbm->head = *( (pl_t*)plbm->head );
     } else if ( plbm->itail > 0 ) {
-        ret = plbm->node->data + ( ( plbm__itail( plbm ) - plbm->itail ) * plbm->bsize );
+        ret = plbm__base( plbm, plbm->node ) + ( ( plbm->imax - plbm->itail ) * plbm->bsize );
         plbm->itail--;
     } else {
         /* Allocate new node (or reuse old). */
@@ -788,7 +1694,8 @@ pl_t plbm_get( plbm_t plbm )
         if ( plbm->node->next ) {
             node = plbm->node->next;
         } else {
-            node = pl_node__allocate( plbm->nsize, plbm->type, plbm->host, 0 );
+            node = pl_node__allocate(
+                plbm->nsize, plbm->type, plbm->host, plbm->amask + 1, plbm->flags );
             if ( node == NULL ) {
                 /* GCOV_EXCL_START */
                 return NULL;
@@ -798,8 +1705,8 @@ pl_t plbm_get( plbm_t plbm )
             node->prev = plbm->node;
         }
         plbm->node = node;
-        ret = node->data;
-        plbm->itail = plbm__itail( plbm );
+        ret = plbm__base( plbm, node );
+        plbm->itail = plbm->imax;
         plbm->itail--;
     }
 
@@ -807,17 +1714,110 @@ pl_t plbm_get( plbm_t plbm )
 }
 
 
-pl_none plbm_put( plbm_t plbm, pl_t block )
+pl_size_t plbm_get_n( plbm_t plbm, pl_t* blocks, pl_size_t count )
 {
-    if ( plbm->head ) {
-        pl_t prev;
-        prev = plbm->head;
-        plbm->head = block;
-        *( (pl_t*)block ) = prev;
-    } else {
+    pl_size_t i;
+    pl_t      block;
+
+    i = 0;
+
+    while ( i < count ) {
+
+        /* Pop free Blocks. */
+        block = plbm->head;
+        while ( i < count && block ) {
+            blocks[ i++ ] = block;
+            block = *( (pl_t*)block );
+        }
         plbm->head = block;
-        *( (pl_t*)block ) = NULL;
+
+        /* Carve the init tail of current Node in one step. */
+        if ( i < count && plbm->node && plbm->itail > 0 ) {
+            pl_size_t n;
+            n = plbm__carve_count( plbm, count - i );
+            block = plbm__base( plbm, plbm->node ) + ( plbm->imax - plbm->itail ) * plbm->bsize;
+            for ( pl_size_t j = 0; j < n; j++ ) {
+                blocks[ i++ ] = block;
+                block += plbm->bsize;
+            }
+            plbm->itail -= n;
+        }
+
+        /* Next Node. */
+        if ( i < count ) {
+            blocks[ i ] = plbm_get_slow( plbm );
+            if ( blocks[ i ] == NULL ) {
+                break; /* GCOV_EXCL_LINE */
+            }
+            i++;
+        }
+    }
+
+    return i;
+}
+
+
+pl_t plbm_get_chain( plbm_t plbm, pl_size_t count )
+{
+    pl_t      first;
+    pl_t*     link;
+    pl_t      block;
+    pl_size_t i;
+
+    first = NULL;
+    link = &first;
+    i = 0;
+
+    while ( i < count ) {
+
+        /* Free Blocks are linked already, cut the chain after count. */
+        if ( plbm->head ) {
+            block = plbm->head;
+            *link = block;
+            i++;
+            while ( i < count && *( (pl_t*)block ) ) {
+                block = *( (pl_t*)block );
+                i++;
+            }
+            plbm->head = *( (pl_t*)block );
+            link = (pl_t*)block;
+        }
+
+        /* Carve the init tail of current Node in one step. */
+        if ( i < count && plbm->node && plbm->itail > 0 ) {
+            pl_size_t n;
+            n = plbm__carve_count( plbm, count - i );
+            block = plbm__base( plbm, plbm->node ) + ( plbm->imax - plbm->itail ) * plbm->bsize;
+            for ( pl_size_t j = 0; j < n; j++ ) {
+                *link = block;
+                link = (pl_t*)block;
+                block += plbm->bsize;
+            }
+            plbm->itail -= n;
+            i += n;
+        }
+
+        /* Next Node. */
+        if ( i < count ) {
+            block = plbm_get_slow( plbm );
+            if ( block == NULL ) {
+                break; /* GCOV_EXCL_LINE */
+            }
+            *link = block;
+            link = (pl_t*)block;
+            i++;
+        }
     }
+    *link = NULL;
+
+    return first;
+}
+
+
+pl_none plbm_put_chain( plbm_t plbm, pl_t first, pl_t last )
+{
+    *( (pl_t*)last ) = plbm->head;
+    plbm->head = first;
 }
 
 
@@ -828,11 +1828,119 @@ pl_none plbm_clear( plbm_t plbm )
         plbm->node = plbm->node->prev;
         plbm->node->used = 0;
     }
-    plbm->itail = plbm__itail( plbm );
+    plbm->itail = plbm->imax;
     plbm->head = NULL;
 }
 
 
+pl_none plbm_trim( plbm_t plbm, pl_size_t count, pl_size_t size )
+{
+    pl_node__trim( plbm->node, count, size, plbm->type, plbm->host );
+}
+
+
+pl_size_t plbm_reclaim( plbm_t plbm )
+{
+    pl_node_t* nodes;
+    pl_node_t  node;
+    pl_node_t  keep;
+    pl_node_t  cur;
+    pl_size_t  count;
+    pl_size_t  ret;
+    pl_t*      link;
+
+    if ( plbm->node == NULL ) {
+        return 0;
+    }
+
+    /* Collect Nodes in use, i.e. current and before, with all Blocks
+       taken from them. */
+    count = 0;
+    for ( node = plbm->node; node; node = node->prev ) {
+        node->used = plbm->imax;
+        keep = node;
+        count++;
+    }
+    plbm->node->used = plbm->imax - plbm->itail;
+
+    if ( plbm->type != PL_AA_SELF ) {
+        keep = NULL;
+    }
+
+    nodes = pl_alloc_only( count * sizeof( pl_node_t ) );
+    if ( nodes == NULL ) {
+        /* GCOV_EXCL_START */
+        return 0;
+        /* GCOV_EXCL_STOP */
+    }
+    node = plbm->node;
+    for ( pl_size_t i = 0; i < count; i++ ) {
+        nodes[ i ] = node;
+        node = node->prev;
+    }
+    qsort( nodes, count, sizeof( pl_node_t ), plbm__node_compare );
+
+    /* Live counts. */
+    for ( pl_t block = plbm->head; block; block = *(pl_t*)block ) {
+        plbm__find_node( nodes, count, block )->used--;
+    }
+
+    /* Drop Blocks of free Nodes from chain. User Node is kept. */
+    link = &plbm->head;
+    while ( *link ) {
+        node = plbm__find_node( nodes, count, *link );
+        if ( node->used == 0 && node != keep ) {
+            *link = *(pl_t*)*link;
+        } else {
+            link = (pl_t*)*link;
+        }
+    }
+
+    pl_free_memory( nodes );
+
+    if ( plbm->node->used == 0 && plbm->node != keep ) {
+        /* Current Node stays, as fresh, and is not counted. */
+        plbm->itail = plbm->imax;
+    }
+
+    ret = 0;
+
+    node = plbm->node->prev;
+    while ( node ) {
+
+        cur = node;
+        node = node->prev;
+
+        if ( cur->used > 0 || cur == keep ) {
+            continue;
+        }
+
+        if ( cur->prev ) {
+            cur->prev->next = cur->next;
+        }
+        cur->next->prev = cur->prev;
+
+        if ( plbm->type == PL_AA_PLAM ) {
+            /* Plam host is released in order, hence reuse. */
+            cur->prev = plbm->node;
+            cur->next = plbm->node->next;
+            if ( cur->next ) {
+                cur->next->prev = cur;
+            }
+            plbm->node->next = cur;
+        } else {
+            cur->prev = NULL;
+            cur->next = NULL;
+            pl_node__del( cur, plbm->type == PL_AA_SELF ? PL_AA_HEAP : plbm->type, plbm->host );
+        }
+
+        ret++;
+    }
+
+    return ret;
+}
+
+
 pl_t plbm_store( plbm_t plbm, const pl_t data )
 {
     return plbm_store_with_size( plbm, data, plbm->bsize );
@@ -892,2027 +2000,4216 @@ pl_bool_t plbm_is_empty( plbm_t plbm )
 
 
 /* ------------------------------------------------------------
- * Continuous Memory Allocator:
+ * Block Bitmap Allocator:
  */
 
-plcm_t plcm_new( plcm_t plcm, pl_size_t size )
+#define PLBB_WORD_BITS 64
+
+static pl_u64_t* plbb__bitmap( pl_node_t node )
 {
-    pl_t mem;
+    return (pl_u64_t*)node->data;
+}
 
-    mem = pl_alloc_memory( size );
-    if ( mem ) {
-        plcm->size = size;
-        plcm->used = 0;
-        plcm->data = mem;
-        plcm->type = PL_AA_HEAP;
-        return plcm;
-    } else {
+static pl_t plbb__block( plbb_t plbb, pl_node_t node, pl_size_t index )
+{
+    return node->data + plbb->wcount * sizeof( pl_u64_t ) + index * plbb->bsize;
+}
+
+/*
+ * Reset bitmap, where bits after the last Block are set (never free).
+ */
+static pl_none plbb__reset( plbb_t plbb, pl_node_t node )
+{
+    pl_u64_t* bitmap;
+    pl_size_t rest;
+
+    bitmap = plbb__bitmap( node );
+    memset( bitmap, 0, plbb->wcount * sizeof( pl_u64_t ) );
+    rest = plbb->bcount % PLBB_WORD_BITS;
+    if ( rest ) {
+        bitmap[ plbb->wcount - 1 ] = ~( ( (pl_u64_t)1 << rest ) - 1 );
+    }
+    node->used = 0;
+}
+
+static pl_node_t plbb__allocate( plbb_t plbb )
+{
+    pl_node_t node;
+
+    node = pl_alloc_aligned( plbb->nsize, plbb->nsize );
+    if ( node == NULL ) {
         /* GCOV_EXCL_START */
-        plcm__init( plcm );
         return NULL;
         /* GCOV_EXCL_STOP */
     }
-}
 
+    pl_node__init( node, plbb->nsize );
+    plbb__reset( plbb, node );
 
-plcm_t plcm_new_ptr( plcm_t plcm, pl_size_t size )
+    return node;
+}
+
+/*
+ * Find Node with free Blocks (first in chain), or allocate new Node.
+ */
+static pl_node_t plbb__find( plbb_t plbb )
 {
-    return plcm_new( plcm, size * sizeof( pl_t ) );
+    pl_node_t node;
+
+    node = plbb->node;
+    if ( node ) {
+        while ( node->prev ) {
+            node = node->prev;
+        }
+        for ( ; node; node = node->next ) {
+            if ( node->used < plbb->bcount ) {
+                return node;
+            }
+        }
+    }
+
+    node = plbb__allocate( plbb );
+    if ( node && plbb->node ) {
+        node->prev = plbb->node;
+        node->next = plbb->node->next;
+        if ( node->next ) {
+            node->next->prev = node;
+        }
+        plbb->node->next = node;
+    }
+
+    return node;
 }
 
 
-plcm_t plcm_use( plcm_t plcm, pl_t mem, pl_size_t size )
+pl_none plbb_new( plbb_t plbb, pl_size_t nsize, pl_size_t bsize )
 {
-    plcm->size = size;
-    plcm->used = 0;
-    plcm->data = mem;
-    plcm->type = PL_AA_SELF;
-    return plcm;
+    pl_size_t capacity;
+    pl_size_t size;
+
+    size = sizeof( pl_node_s );
+    while ( size < nsize ) {
+        size *= 2;
+    }
+
+    plbb->node = NULL;
+    plbb->nsize = size;
+    plbb->bsize = bsize;
+    plbb->hint = 0;
+
+    if ( bsize == 0 ) {
+        plbb->bcount = 0;
+        plbb->wcount = 0;
+        return;
+    }
+
+    /* Bitmap word and its 64 Blocks are taken together, and the rest
+       fill the last word partially. */
+    capacity = size - sizeof( pl_node_s );
+    plbb->bcount = capacity / ( sizeof( pl_u64_t ) + PLBB_WORD_BITS * bsize ) * PLBB_WORD_BITS;
+    capacity -= plbb->bcount / PLBB_WORD_BITS * ( sizeof( pl_u64_t ) + PLBB_WORD_BITS * bsize );
+    if ( capacity > sizeof( pl_u64_t ) ) {
+        plbb->bcount += ( capacity - sizeof( pl_u64_t ) ) / bsize;
+    }
+    plbb->wcount = PLINTH_ALIGN_TO( plbb->bcount, PLBB_WORD_BITS ) / PLBB_WORD_BITS;
 }
 
 
-plcm_t plcm_use_plam( plcm_t plcm, plam_t host, pl_size_t size )
+pl_none plbb_del( plbb_t plbb )
 {
-    return plcm_use( plcm, plam_get( host, size ), size );
+    pl_node__del( plbb->node, PL_AA_HEAP, NULL );
+    plbb->node = NULL;
+    plbb->hint = 0;
 }
 
 
-plcm_t plcm_use_plbm( plcm_t plcm, plbm_t host )
+pl_t plbb_get( plbb_t plbb )
 {
-    plcm_use( plcm, plbm_get( host ), plbm_block_size( host ) );
-    return plcm;
+    pl_node_t node;
+    pl_u64_t* bitmap;
+    pl_size_t bit;
+
+    if ( plbb->bcount == 0 ) {
+        return NULL;
+    }
+
+    node = plbb->node;
+    if ( node == NULL || node->used == plbb->bcount ) {
+        node = plbb__find( plbb );
+        if ( node == NULL ) {
+            /* GCOV_EXCL_START */
+            return NULL;
+            /* GCOV_EXCL_STOP */
+        }
+        plbb->node = node;
+        plbb->hint = 0;
+    }
+
+    bitmap = plbb__bitmap( node );
+    while ( bitmap[ plbb->hint ] == ~(pl_u64_t)0 ) {
+        plbb->hint++;
+    }
+
+    bit = __builtin_ctzll( ~bitmap[ plbb->hint ] );
+    bitmap[ plbb->hint ] |= (pl_u64_t)1 << bit;
+    node->used++;
+
+    return plbb__block( plbb, node, plbb->hint * PLBB_WORD_BITS + bit );
 }
 
 
-plcm_t plcm_empty( plcm_t plcm, pl_size_t size )
+pl_none plbb_put( plbb_t plbb, pl_t block )
 {
-    plcm__init( plcm );
-    plcm->size = size;
-    return plcm;
+    pl_node_t node;
+    pl_size_t index;
+    pl_size_t word;
+
+    node = (pl_node_t)( (pl_size_t)block & ~( plbb->nsize - 1 ) );
+    index = (pl_size_t)( block - plbb__block( plbb, node, 0 ) ) / plbb->bsize;
+    word = index / PLBB_WORD_BITS;
+
+    plbb__bitmap( node )[ word ] &= ~( (pl_u64_t)1 << ( index % PLBB_WORD_BITS ) );
+    node->used--;
+
+    if ( node == plbb->node ) {
+        if ( word < plbb->hint ) {
+            plbb->hint = word;
+        }
+    } else if ( node->used == 0 ) {
+        /* Release free Node. */
+        if ( node->prev ) {
+            node->prev->next = node->next;
+        }
+        if ( node->next ) {
+            node->next->prev = node->prev;
+        }
+        pl_free_memory( node );
+    }
 }
 
 
-plcm_t plcm_empty_ptr( plcm_t plcm, pl_size_t size )
+pl_none plbb_clear( plbb_t plbb )
 {
-    return plcm_empty( plcm, size * sizeof( pl_t ) );
+    pl_node_t node;
+
+    if ( plbb->node == NULL ) {
+        return;
+    }
+
+    node = plbb->node;
+    while ( node->prev ) {
+        node = node->prev;
+    }
+    plbb->node = node;
+    plbb->hint = 0;
+
+    for ( ; node; node = node->next ) {
+        plbb__reset( plbb, node );
+    }
 }
 
 
-plcm_s plcm_shadow( plcm_t plcm )
+pl_size_t plbb_node_capacity( plbb_t plbb )
 {
-    plcm_s shadow;
-    shadow = *plcm;
-    shadow.size = 0;
-    return shadow;
+    return plbb->bcount;
 }
 
 
-pl_none plcm_copy_to( plcm_t plcm, plcm_t target, pl_t mem, pl_size_t size )
+pl_size_t plbb_block_size( plbb_t plbb )
 {
-    plcm_use( target, mem, size );
-    plcm_get_ref( target, plcm_used( plcm ) );
-    memcpy( target->data, plcm->data, plcm_used( plcm ) );
+    return plbb->bsize;
 }
 
 
-plcm_s plcm_copy( plcm_t plcm )
+
+/* ------------------------------------------------------------
+ * Block Handle Allocator:
+ */
+
+/* Maximum handle count, since zero is the null handle. */
+#define PLBH_MAX_COUNT ( (pl_size_t)UINT32_MAX )
+
+
+pl_none plbh_new( plbh_t plbh, pl_size_t bcount, pl_size_t bsize )
 {
-    plcm_s copy;
-    plcm_new( &copy, plcm_size( plcm ) );
-    plcm_copy_to( plcm, &copy, copy.data, plcm_size( &copy ) );
-    /* NOTE: plcm_use (in plcm_copy_to) invalidates the type field. */
-    copy.type = PL_AA_HEAP;
-    return copy;
+    plcm_new( &plbh->table, 16 * sizeof( pl_node_t ) );
+    plbh->head = 0;
+    plbh->count = 0;
+    plbh->bsize = bsize;
+    plbh->shift = 0;
+    while ( ( (pl_size_t)1 << plbh->shift ) < bcount ) {
+        plbh->shift++;
+    }
 }
 
 
-plcm_t plcm_del( plcm_t plcm )
+pl_none plbh_del( plbh_t plbh )
 {
-    if ( ( plcm->type == PL_AA_HEAP ) && !_plcm_is_empty( plcm ) ) {
-        pl_free_memory( plcm->data );
+    pl_node_t* nodes;
+
+    nodes = plcm_data( &plbh->table );
+    for ( pl_size_t i = 0; i < plcm_used_for_type( &plbh->table, pl_node_t ); i++ ) {
+        pl_free_memory( nodes[ i ] );
     }
-    plcm__init( plcm );
-    return NULL;
+    plcm_del( &plbh->table );
+    plbh->head = 0;
+    plbh->count = 0;
 }
 
 
-pl_none plcm_resize( plcm_t plcm, pl_size_t size )
+pl_bh_t plbh_get( plbh_t plbh )
 {
-    if ( _plcm_is_empty( plcm ) || size > plcm->size ) {
-
-        pl_size_t new_size;
+    pl_bh_t   ret;
+    pl_node_t node;
 
-        if ( _plcm_is_empty( plcm ) ) {
+    if ( plbh->head ) {
+        ret = plbh->head;
+        plbh->head = *( (pl_bh_t*)plbh_ref( plbh, ret ) );
+        return ret;
+    }
 
-            /* Empty plcm. */
-            if ( plcm->size == 0 || size > plcm->size ) {
-                new_size = PLINTH_ALIGN_TO( size, 64 );
-            } else {
-                new_size = plcm->size;
-            }
+    if ( plbh->bsize < sizeof( pl_bh_t ) || plbh->count == PLBH_MAX_COUNT ) {
+        return 0;
+    }
 
-            plcm->data = pl_alloc_memory( new_size );
-            if ( plcm->data ) {
-                plcm->size = new_size;
-                plcm->used = 0;
-                plcm->type = PL_AA_HEAP;
-            } else {
-                /* GCOV_EXCL_START */
-                plcm__init( plcm );
-                plcm->type = PL_AA_NONE;
-                /* GCOV_EXCL_STOP */
-            }
+    if ( ( plbh->count >> plbh->shift ) == plcm_used_for_type( &plbh->table, pl_node_t ) ) {
+        /* All Nodes are used. */
+        node = pl_node__allocate( sizeof( pl_node_s ) + ( plbh->bsize << plbh->shift ),
+                                  PL_AA_HEAP,
+                                  NULL,
+                                  0,
+                                  0 );
+        if ( node == NULL ) {
+            /* GCOV_EXCL_START */
+            return 0;
+            /* GCOV_EXCL_STOP */
+        }
+        plcm_store_for_type( &plbh->table, &node, pl_node_t );
+    }
 
-        } else if ( plcm->type == PL_AA_SELF ) {
+    plbh->count++;
 
-            pl_t new_mem;
+    return (pl_bh_t)plbh->count;
+}
 
-            if ( size > 2 * plcm->size ) {
-                new_size = PLINTH_ALIGN_TO( size, plcm->size );
-            } else {
-                new_size = 2 * plcm->size;
-            }
 
-            new_mem = pl_alloc_memory( new_size );
-            if ( new_mem ) {
-                memcpy( new_mem, plcm->data, plcm->size );
-                plcm->data = new_mem;
-                plcm->size = new_size;
-                plcm->type = PL_AA_HEAP;
-            } else {
-                /* GCOV_EXCL_START */
-                plcm__init( plcm );
-                plcm->type = PL_AA_NONE;
-                /* GCOV_EXCL_STOP */
-            }
-
-        } else {
-
-            /*
-              By default, we double the allocation, but if that is not
-              enough, we resize to the next sufficient multiple of
-              plcm->size.
-             */
-            if ( size > 2 * plcm->size ) {
-                new_size = PLINTH_ALIGN_TO( size, plcm->size );
-            } else {
-                new_size = 2 * plcm->size;
-            }
-
-            plcm->data = pl_realloc_memory( plcm->data, new_size );
-            if ( plcm->data ) {
-                memset( plcm->data + plcm->size, 0, ( new_size - plcm->size ) );
-                plcm->size = new_size;
-            } else {
-                /* GCOV_EXCL_START */
-                plcm__init( plcm );
-                plcm->type = PL_AA_NONE;
-                /* GCOV_EXCL_STOP */
-            }
-        }
-    }
+pl_none plbh_put( plbh_t plbh, pl_bh_t handle )
+{
+    *( (pl_bh_t*)plbh_ref( plbh, handle ) ) = plbh->head;
+    plbh->head = handle;
 }
 
 
-pl_none plcm_increase( plcm_t plcm, pl_size_t size )
+pl_none plbh_clear( plbh_t plbh )
 {
-    plcm_resize( plcm, plcm->size + size );
+    plbh->head = 0;
+    plbh->count = 0;
 }
 
 
-pl_t plcm_ensure( plcm_t plcm, pl_size_t size )
+pl_size_t plbh_block_size( plbh_t plbh )
 {
-    plcm_resize( plcm, plcm->used + size );
-    return plcm_end( plcm );
+    return plbh->bsize;
 }
 
 
-pl_none plcm_compact( plcm_t plcm )
-{
-    if ( ( plcm->type == PL_AA_HEAP ) ) {
-        plcm->data = pl_realloc_memory( plcm->data, plcm->used );
-        plcm->size = plcm->used;
-    }
-}
 
+/* ------------------------------------------------------------
+ * Block Shared Memory Allocator:
+ */
 
-pl_pos_t plcm_get_pos( plcm_t plcm, pl_size_t size )
+/*
+ * Tagged head: pointer in lower 48 bits, and ABA tag in upper 16 bits.
+ * Assumes 48-bit user space addresses, i.e. no 5-level paging (LA57)
+ * mappings above 128 TiB, and no pointer tagging.
+ */
+#define PLBS_PTR_MASK ( ( (pl_u64_t)1 << 48 ) - 1 )
+#define PLBS_TAG_UNIT ( (pl_u64_t)1 << 48 )
+
+static pl_t plbs__ptr( pl_u64_t head )
 {
-    pl_pos_t ret;
-    plcm_resize( plcm, plcm->used + size );
-    ret = plcm->used;
-    plcm->used += size;
-    return ret;
+    return (pl_t)( head & PLBS_PTR_MASK );
 }
 
-
-pl_t plcm_get_ref( plcm_t plcm, pl_size_t size )
+static pl_u64_t plbs__tag( pl_t ptr, pl_u64_t head )
 {
-    pl_t ret;
-    plcm_resize( plcm, plcm->used + size );
-    ret = plcm_ref( plcm, plcm->used );
-    plcm->used += size;
-    return ret;
+    return (pl_u64_t)ptr | ( ( head & ~PLBS_PTR_MASK ) + PLBS_TAG_UNIT );
 }
 
+static pl_none plbs__push( plbs_t plbs, pl_t first, pl_t last )
+{
+    pl_u64_t head;
 
-pl_none plcm_put( plcm_t plcm, pl_size_t size )
+    assert( ( (pl_u64_t)first & ~PLBS_PTR_MASK ) == 0 );
+
+    head = __atomic_load_n( &plbs->head, __ATOMIC_RELAXED );
+    do {
+        __atomic_store_n( (pl_t*)last, plbs__ptr( head ), __ATOMIC_RELAXED );
+    } while ( !__atomic_compare_exchange_n( &plbs->head,
+                                            &head,
+                                            plbs__tag( first, head ),
+                                            pl_true,
+                                            __ATOMIC_RELEASE,
+                                            __ATOMIC_RELAXED ) );
+}
+
+/*
+ * Take Blocks from plbm (Node), and push all except the first to the
+ * free stack.
+ */
+static pl_t plbs__refill( plbs_t plbs )
 {
-    if ( size <= plcm->used ) {
-        plcm->used -= size;
+    pl_t      first;
+    pl_t      last;
+    pl_size_t count;
+
+    pthread_mutex_lock( &plbs->lock );
+
+    if ( plbs__ptr( __atomic_load_n( &plbs->head, __ATOMIC_ACQUIRE ) ) ) {
+        /* Another thread refilled already. */
+        pthread_mutex_unlock( &plbs->lock );
+        return plbs_get( plbs );
     }
-}
 
+    if ( plbs->plbm.itail > 0 && plbs->plbm.node ) {
+        count = plbs->plbm.itail;
+    } else {
+        count = plbs->plbm.imax;
+    }
 
-pl_pos_t plcm_store( plcm_t plcm, pl_t data, pl_size_t size )
-{
-    pl_pos_t ret;
-    ret = plcm_get_pos( plcm, size );
-    plcm_set( plcm, ret, data, size );
-    return ret;
-}
+    first = plbm_get_chain( &plbs->plbm, count );
+    if ( first && *(pl_t*)first ) {
+        last = *(pl_t*)first;
+        while ( *(pl_t*)last ) {
+            last = *(pl_t*)last;
+        }
+        plbs__push( plbs, *(pl_t*)first, last );
+    }
 
+    pthread_mutex_unlock( &plbs->lock );
 
-pl_pos_t plcm_store_ptr( plcm_t plcm, pl_t ptr )
-{
-    return plcm_store( plcm, &ptr, sizeof( pl_t ) );
+    return first;
 }
 
 
-pl_none plcm_store_null( plcm_t plcm )
+pl_none plbs_new( plbs_t plbs, pl_size_t nsize, pl_size_t bsize )
 {
-    plcm_resize( plcm, plcm->used + sizeof( pl_t ) );
-    plcm_terminate_ptr( plcm );
+    plbm_empty( &plbs->plbm, nsize, bsize );
+    plbs->head = 0;
+    pthread_mutex_init( &plbs->lock, NULL );
 }
 
 
-pl_t plcm_ref( plcm_t plcm, pl_pos_t pos )
+pl_none plbs_del( plbs_t plbs )
 {
-    return plcm->data + pos;
+    plbm_del( &plbs->plbm );
+    plbs->head = 0;
+    pthread_mutex_destroy( &plbs->lock );
 }
 
 
-pl_t plcm_ref_ptr( plcm_t plcm, pl_pos_t pos )
+pl_t plbs_get( plbs_t plbs )
 {
-    return *(pl_p)( plcm->data + pos * sizeof( pl_t ) );
-}
+    pl_u64_t head;
+    pl_t     block;
+    pl_t     next;
 
+    head = __atomic_load_n( &plbs->head, __ATOMIC_ACQUIRE );
+    while ( 1 ) {
 
-pl_none plcm_set( plcm_t plcm, pl_pos_t pos, const pl_t data, pl_size_t size )
-{
-    memcpy( plcm_ref( plcm, pos ), data, size );
+        block = plbs__ptr( head );
+        if ( block == NULL ) {
+            if ( plbs->plbm.imax == 0 ) {
+                /* Invalid plbs. */
+                return NULL;
+            }
+            return plbs__refill( plbs );
+        }
+
+        /* Block might be taken by another thread, but memory is valid
+           and CAS fails with the tag. */
+        next = __atomic_load_n( (pl_t*)block, __ATOMIC_RELAXED );
+        if ( __atomic_compare_exchange_n( &plbs->head,
+                                          &head,
+                                          plbs__tag( next, head ),
+                                          pl_true,
+                                          __ATOMIC_ACQUIRE,
+                                          __ATOMIC_ACQUIRE ) ) {
+            return block;
+        }
+    }
 }
 
 
-pl_none plcm_set_ptr( plcm_t plcm, pl_pos_t pos, const pl_t ptr )
+pl_none plbs_put( plbs_t plbs, pl_t block )
 {
-    memcpy( plcm_ref( plcm, pos * sizeof( pl_t ) ), &ptr, sizeof( pl_t ) );
+    plbs__push( plbs, block, block );
 }
 
 
-pl_t plcm_consume( plcm_t plcm, pl_size_t size )
+pl_size_t plbs_block_size( plbs_t plbs )
 {
-    pl_t ret;
-    ret = plcm_end( plcm );
-    plcm->used += size;
-    return ret;
+    return plbm_block_size( &plbs->plbm );
 }
 
 
-pl_t plcm_pop( plcm_t plcm, pl_size_t size )
-{
-    plcm->used -= size;
-    return plcm_end( plcm );
-}
 
+/* ------------------------------------------------------------
+ * Block Magazine Allocator:
+ */
 
-pl_t plcm_pop_ptr( plcm_t plcm )
+/*
+ * Return count Blocks to depot as one chain.
+ */
+static pl_none plmg__flush( plmg_t plmg, pl_t* blocks, pl_size_t count )
 {
-    pl_p pop;
-    pop = plcm_pop( plcm, sizeof( pl_t ) );
-    return *pop;
-}
+    if ( count == 0 ) {
+        return;
+    }
 
+    for ( pl_size_t i = 0; i < count - 1; i++ ) {
+        *(pl_t*)blocks[ i ] = blocks[ i + 1 ];
+    }
 
-pl_none plcm_remove( plcm_t plcm, pl_pos_t pos, pl_size_t size )
+    pthread_mutex_lock( &plmg->depot->lock );
+    plbm_put_chain( &plmg->depot->plbm, blocks[ 0 ], blocks[ count - 1 ] );
+    pthread_mutex_unlock( &plmg->depot->lock );
+}
+
+static pl_none plmg__swap( plmg_t plmg )
 {
-    memmove( plcm->data + pos, plcm->data + pos + size, plcm->used - pos - size );
-    plcm->used -= size;
+    pl_t*     blocks;
+    pl_size_t count;
+
+    blocks = plmg->load;
+    count = plmg->lcnt;
+    plmg->load = plmg->prev;
+    plmg->lcnt = plmg->pcnt;
+    plmg->prev = blocks;
+    plmg->pcnt = count;
 }
 
 
-pl_none plcm_remove_ptr( plcm_t plcm, pl_pos_t pos )
+pl_none plmd_new( plmd_t plmd, pl_size_t nsize, pl_size_t bsize, pl_size_t msize )
 {
-    plcm_remove( plcm, pos * sizeof( pl_t ), sizeof( pl_t ) );
+    plbm_empty( &plmd->plbm, nsize, bsize );
+    plmd->msize = msize;
+    pthread_mutex_init( &plmd->lock, NULL );
 }
 
 
-pl_none plcm_insert( plcm_t plcm, pl_pos_t pos, pl_t data, pl_size_t size )
+pl_none plmd_del( plmd_t plmd )
 {
-    memmove( plcm->data + pos + size, plcm->data + pos, plcm->used - pos );
-    plcm->used += size;
-    plcm_set( plcm, pos, data, size );
+    plbm_del( &plmd->plbm );
+    pthread_mutex_destroy( &plmd->lock );
 }
 
 
-pl_none plcm_insert_ptr( plcm_t plcm, pl_pos_t pos, pl_t ptr )
+pl_size_t plmd_block_size( plmd_t plmd )
 {
-    plcm_insert( plcm, pos * sizeof( pl_t ), &ptr, sizeof( pl_t ) );
+    return plbm_block_size( &plmd->plbm );
 }
 
 
-pl_bool_t plcm_terminate( plcm_t plcm, pl_size_t size )
+pl_bool_t plmg_new( plmg_t plmg, plmd_t plmd )
 {
-    if ( plcm->used + size <= plcm->size ) {
-        memset( plcm->data + plcm->used, 0, size );
-        return pl_true;
-    } else {
+    plmg->depot = plmd;
+    plmg->lcnt = 0;
+    plmg->pcnt = 0;
+    plmg->size = plmd->msize;
+
+    if ( plmg->size == 0 ) {
+        plmg->load = NULL;
+        plmg->prev = NULL;
         return pl_false;
     }
-}
 
+    plmg->load = pl_alloc_memory_for_type_n( pl_t, 2 * plmg->size );
+    if ( plmg->load == NULL ) {
+        /* GCOV_EXCL_START */
+        plmg->prev = NULL;
+        plmg->size = 0;
+        return pl_false;
+        /* GCOV_EXCL_STOP */
+    }
+    plmg->prev = plmg->load + plmg->size;
 
-pl_bool_t plcm_terminate_ptr( plcm_t plcm )
-{
-    return plcm_terminate( plcm, sizeof( pl_t ) );
+    return pl_true;
 }
 
 
-pl_none plcm_reset( plcm_t plcm )
+pl_none plmg_del( plmg_t plmg )
 {
-    plcm->used = 0;
-}
+    plmg_flush( plmg );
 
+    /* Either of the arrays is at the start of the allocation. */
+    if ( plmg->load < plmg->prev ) {
+        pl_free_memory( plmg->load );
+    } else {
+        pl_free_memory( plmg->prev );
+    }
 
-pl_none plcm_clear( plcm_t plcm )
-{
-    plcm->used = 0;
-    pl_clear_memory( plcm->data, plcm->size );
+    plmg->load = NULL;
+    plmg->prev = NULL;
+    plmg->size = 0;
 }
 
 
-pl_size_t plcm_used( plcm_t plcm )
+pl_none plmg_flush( plmg_t plmg )
 {
-    return plcm->used;
+    plmg__flush( plmg, plmg->load, plmg->lcnt );
+    plmg__flush( plmg, plmg->prev, plmg->pcnt );
+    plmg->lcnt = 0;
+    plmg->pcnt = 0;
 }
 
 
-pl_size_t plcm_used_ptr( plcm_t plcm )
+pl_t plmg_get_slow( plmg_t plmg )
 {
-    return ( plcm->used / sizeof( pl_t ) );
-}
+    if ( plmg->pcnt == 0 ) {
+        /* Both empty, refill from depot. */
+        pthread_mutex_lock( &plmg->depot->lock );
+        plmg->pcnt = plbm_get_n( &plmg->depot->plbm, plmg->prev, plmg->size );
+        pthread_mutex_unlock( &plmg->depot->lock );
+        if ( plmg->pcnt == 0 ) {
+            return NULL;
+        }
+    }
 
+    plmg__swap( plmg );
 
-pl_size_t plcm_size( plcm_t plcm )
-{
-    return plcm->size;
+    return plmg->load[ --plmg->lcnt ];
 }
 
 
-pl_size_t plcm_size_ptr( plcm_t plcm )
+pl_none plmg_put_slow( plmg_t plmg, pl_t block )
 {
-    return ( plcm->size / sizeof( pl_t ) );
+    if ( plmg->size == 0 ) {
+        /* Invalid plmg, return directly to depot. */
+        plmg__flush( plmg, &block, 1 );
+        return;
+    }
+
+    if ( plmg->pcnt == plmg->size ) {
+        /* Both full, flush to depot. */
+        plmg__flush( plmg, plmg->prev, plmg->pcnt );
+        plmg->pcnt = 0;
+    }
+
+    plmg__swap( plmg );
+
+    plmg->load[ plmg->lcnt++ ] = block;
 }
 
 
-pl_t plcm_data( plcm_t plcm )
+
+/* ------------------------------------------------------------
+ * Slab Memory Allocator:
+ */
+
+static pl_size_t plsl__class( pl_size_t size )
 {
-    return plcm->data;
+    if ( size <= PLSL_CLASS_MIN ) {
+        return 0;
+    } else {
+        /* Log2 of size rounded up to power of two, relative to minimum. */
+        return 64 - __builtin_clzll( size - 1 ) - __builtin_ctzll( PLSL_CLASS_MIN );
+    }
 }
 
-
-pl_bool_t plcm_debt( plcm_t plcm )
+/*
+ * Return pool of allocation, or NULL if allocation is large.
+ */
+static plbm_t plsl__pool( plsl_t plsl, pl_t mem )
 {
-    return ( plcm->type == PL_AA_HEAP );
+    pl_size_t offset;
+
+    offset = (pl_size_t)( mem - plsl->base );
+    if ( plsl->base && offset < ( (pl_size_t)PLSL_CLASS_COUNT << plsl->shift ) ) {
+        return &plsl->pool[ offset >> plsl->shift ];
+    } else {
+        return NULL;
+    }
 }
 
+static pl_t plsl__get_large( plsl_t plsl, pl_size_t size )
+{
+    pl_node_t node;
 
-pl_t plcm_end( plcm_t plcm )
+    node = pl_alloc_only( sizeof( pl_node_s ) + size );
+    if ( node == NULL ) {
+        /* GCOV_EXCL_START */
+        return NULL;
+        /* GCOV_EXCL_STOP */
+    }
+
+    pl_node__init( node, sizeof( pl_node_s ) + size );
+    node->used = size;
+    node->next = plsl->large;
+    if ( plsl->large ) {
+        plsl->large->prev = node;
+    }
+    plsl->large = node;
+
+    return node->data;
+}
+
+static pl_none plsl__put_large( plsl_t plsl, pl_node_t node )
 {
-    return plcm->data + plcm->used;
+    if ( node->prev ) {
+        node->prev->next = node->next;
+    } else {
+        plsl->large = node->next;
+    }
+    if ( node->next ) {
+        node->next->prev = node->prev;
+    }
+    pl_free_memory( node );
 }
 
 
-pl_t plcm_tail( plcm_t plcm, pl_size_t size )
+pl_bool_t plsl_new( plsl_t plsl, pl_size_t reserve )
 {
-    return plcm->data + plcm->used - size;
+    pl_t mem;
+
+    plsl->large = NULL;
+    plsl->base = NULL;
+
+    plsl->shift = __builtin_ctzll( pl__page_size() );
+    while ( ( (pl_size_t)1 << plsl->shift ) < reserve ) {
+        plsl->shift++;
+    }
+
+    mem = mmap( NULL,
+                (pl_size_t)PLSL_CLASS_COUNT << plsl->shift,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                -1,
+                0 );
+    if ( mem == MAP_FAILED ) {
+        for ( pl_size_t i = 0; i < PLSL_CLASS_COUNT; i++ ) {
+            plbm__invalid( &plsl->pool[ i ] );
+        }
+        return pl_false;
+    }
+
+    /* Each pool has one Node, which is the whole slot. */
+    plsl->base = mem;
+    for ( pl_size_t i = 0; i < PLSL_CLASS_COUNT; i++ ) {
+        plbm_use( &plsl->pool[ i ],
+                  mem + ( i << plsl->shift ),
+                  (pl_size_t)1 << plsl->shift,
+                  PLSL_CLASS_MIN << i );
+    }
+
+    return pl_true;
 }
 
 
-pl_bool_t plcm_is_empty( plcm_t plcm )
+pl_none plsl_del( plsl_t plsl )
 {
-    return _plcm_is_empty( plcm );
+    while ( plsl->large ) {
+        plsl__put_large( plsl, plsl->large );
+    }
+
+    if ( plsl->base ) {
+        munmap( plsl->base, (pl_size_t)PLSL_CLASS_COUNT << plsl->shift );
+        plsl->base = NULL;
+    }
+
+    for ( pl_size_t i = 0; i < PLSL_CLASS_COUNT; i++ ) {
+        plbm__invalid( &plsl->pool[ i ] );
+    }
 }
 
 
-pl_pos_t plcm_find_ptr( plcm_t plcm, pl_t ref )
+pl_t plsl_get( plsl_t plsl, pl_size_t size )
 {
-    for ( pl_size_t i = 0; i < plcm_used_ptr( plcm ); i++ ) {
-        if ( plcm_ref_ptr( plcm, i ) == ref ) {
-            return i;
+    plbm_t pool;
+
+    if ( size <= PLSL_CLASS_MAX ) {
+        pool = &plsl->pool[ plsl__class( size ) ];
+        /* Pool can't have more Nodes, hence large allocation when full. */
+        if ( pool->head || pool->itail > 0 ) {
+            return plbm_get( pool );
         }
     }
 
-    return -1;
+    return plsl__get_large( plsl, size );
 }
 
 
-pl_pos_t plcm_find_with( plcm_t plcm, plcm_compare_fn_t compare, pl_size_t size, pl_t ref )
+pl_none plsl_put( plsl_t plsl, pl_t mem )
 {
-    for ( pl_size_t i = 0; i < plcm_used( plcm ); i += size ) {
-        if ( compare( size, plcm_ref( plcm, i ), ref ) ) {
-            return ( i / size );
-        }
+    plbm_t pool;
+
+    if ( mem == NULL ) {
+        return;
     }
 
-    return -1;
+    pool = plsl__pool( plsl, mem );
+    if ( pool ) {
+        plbm_put( pool, mem );
+    } else {
+        plsl__put_large( plsl, mem - sizeof( pl_node_s ) );
+    }
+}
+
+
+pl_size_t plsl_size( plsl_t plsl, pl_t mem )
+{
+    plbm_t pool;
+
+    pool = plsl__pool( plsl, mem );
+    if ( pool ) {
+        return plbm_block_size( pool );
+    } else {
+        return ( (pl_node_t)( mem - sizeof( pl_node_s ) ) )->used;
+    }
 }
 
 
 
 /* ------------------------------------------------------------
- * Unified Memory Allocator:
+ * Node Depot:
  */
 
-pl_none plum_use( plum_t plum, pl_aa_t type, pl_t host )
+pl_none plnd_new( plnd_t plnd, pl_size_t size )
 {
-    plum->type = type;
-    plum->host = host;
+    plnd->head = NULL;
+    plnd->size = size;
+    plnd->count = 0;
+    pthread_mutex_init( &plnd->lock, NULL );
 }
 
 
-pl_t plum_get( plum_t plum, pl_size_t size )
+pl_none plnd_del( plnd_t plnd )
 {
-    switch ( plum->type ) {
-        case PL_AA_HEAP: {
-            return pl_alloc_memory( size );
-        }
-        case PL_AA_PLAM: {
-            return plam_get( (plam_t)plum->host, size );
-        }
-        case PL_AA_PLBM: {
-            plbm_t plbm;
-            plbm = (plbm_t)plum->host;
-            if ( size <= plbm_block_size( plbm ) ) {
-                return plbm_get( plbm );
-            } else {
-                return NULL;
-            }
-        }
-        case PL_AA_PLCM: {
-            return plcm_get_ref( (plcm_t)plum->host, size );
-        }
-        /* GCOV_EXCL_START */
-        default:
-            return NULL;
-            /* GCOV_EXCL_STOP */
+    pl_node_t cur;
+
+    pthread_mutex_lock( &plnd->lock );
+    while ( plnd->head ) {
+        cur = plnd->head;
+        plnd->head = cur->next;
+        pl_free_memory( cur );
     }
+    plnd->count = 0;
+    pthread_mutex_unlock( &plnd->lock );
+    pthread_mutex_destroy( &plnd->lock );
 }
 
 
-pl_t plum_put( plum_t plum, pl_t mem, pl_size_t size )
+pl_size_t plnd_reserve( plnd_t plnd, pl_size_t count )
 {
-    switch ( plum->type ) {
+    pl_node_t node;
 
-        case PL_AA_HEAP: {
-            pl_free_memory( mem );
-            return NULL;
+    while ( plnd_count( plnd ) < count ) {
+        node = pl_alloc_memory( plnd->size );
+        if ( node == NULL ) {
+            break; /* GCOV_EXCL_LINE */
         }
+        plnd_put( plnd, node );
+    }
 
-        case PL_AA_PLAM: {
+    return plnd_count( plnd );
+}
 
-            plam_t    plam;
-            pl_size_t used_ref;
-            pl_t      mem_ref;
 
-            plam = (plam_t)plum->host;
+pl_t plnd_get( plnd_t plnd )
+{
+    pl_node_t node;
 
-            while ( 1 ) {
-                if ( plam->node->used > 0 ) {
-                    used_ref = plam->node->used - size;
-                    mem_ref = plam->node->data + used_ref;
-                    if ( mem == mem_ref ) {
-                        plam->node->used -= size;
-                        return mem;
-                    } else {
-                        return NULL;
-                    }
-                } else if ( plam->node->prev ) {
-                    plam->node = plam->node->prev;
-                } else {
-                    return NULL;
-                }
-            }
-        }
+    pthread_mutex_lock( &plnd->lock );
+    node = plnd->head;
+    if ( node ) {
+        plnd->head = node->next;
+        plnd->count--;
+    }
+    pthread_mutex_unlock( &plnd->lock );
 
-        case PL_AA_PLBM: {
-            plbm_put( (plbm_t)plum->host, mem );
-            return mem;
-        }
+    if ( node == NULL ) {
+        node = pl_alloc_memory( plnd->size );
+    }
 
-        case PL_AA_PLCM: {
+    return node;
+}
 
-            plcm_t    plcm;
-            pl_size_t used_ref;
-            pl_t      mem_ref;
 
-            plcm = (plcm_t)plum->host;
+pl_none plnd_put( plnd_t plnd, pl_t node )
+{
+    plnd__put_chain( plnd, node, node );
+}
 
-            used_ref = plcm->used - size;
-            mem_ref = plcm->data + used_ref;
 
-            if ( mem == mem_ref ) {
-                plcm_put( plcm, size );
-                return mem;
-            } else {
-                return NULL;
-            }
-        }
-        /* GCOV_EXCL_START */
-        default:
-            return NULL;
-            /* GCOV_EXCL_STOP */
-    }
+pl_size_t plnd_count( plnd_t plnd )
+{
+    pl_size_t count;
+    pthread_mutex_lock( &plnd->lock );
+    count = plnd->count;
+    pthread_mutex_unlock( &plnd->lock );
+    return count;
 }
 
 
-pl_t plum_store( plum_t plum, const pl_t data, pl_size_t size )
+pl_size_t plnd_node_size( plnd_t plnd )
+{
+    return plnd->size;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Continuous Memory Allocator:
+ */
+
+plcm_t plcm_new( plcm_t plcm, pl_size_t size )
 {
     pl_t mem;
-    mem = plum_get( plum, size );
+
+    mem = pl_alloc_memory( size );
     if ( mem ) {
-        memcpy( mem, data, size );
+        plcm->size = size;
+        plcm->used = 0;
+        plcm->data = mem;
+        plcm->type = PL_AA_HEAP;
+        plcm->align = 0;
+        plcm->flags = 0;
+        plcm->growth = PL_GP_DOUBLE;
+        plcm->gcap = 0;
+        plcm->host = NULL;
+        return plcm;
+    } else {
+        /* GCOV_EXCL_START */
+        plcm__init( plcm );
+        return NULL;
+        /* GCOV_EXCL_STOP */
     }
-    return mem;
 }
 
 
-pl_t plum_store_ptr( plum_t plum, pl_t ptr )
+plcm_t plcm_new_ptr( plcm_t plcm, pl_size_t size )
 {
-    return plum_store( plum, &ptr, sizeof( pl_t ) );
+    return plcm_new( plcm, size * sizeof( pl_t ) );
 }
 
 
-pl_t plum_update( plum_t plum, pl_t mem, pl_size_t osize, pl_size_t nsize )
+plcm_t plcm_new_aligned( plcm_t plcm, pl_size_t size, pl_size_t align )
 {
-    switch ( plum->type ) {
+    plcm__init( plcm );
+    if ( align > 1 ) {
+        plcm->align = align;
+    }
 
-        case PL_AA_HEAP: {
-            pl_t new_mem;
-            new_mem = pl_realloc_memory( mem, nsize );
-            if ( nsize > osize ) {
-                memset( new_mem + osize, 0, ( nsize - osize ) );
-            }
-            return new_mem;
-        }
+    plcm->data = plcm__alloc( plcm, &size );
+    if ( plcm->data ) {
+        plcm->size = size;
+        plcm->type = PL_AA_HEAP;
+        return plcm;
+    } else {
+        /* GCOV_EXCL_START */
+        plcm__init( plcm );
+        return NULL;
+        /* GCOV_EXCL_STOP */
+    }
+}
 
-        case PL_AA_PLAM:
-        case PL_AA_PLBM:
-        case PL_AA_PLCM: {
 
-            pl_t      omem;
-            pl_t      nmem;
-            pl_size_t size;
+plcm_t plcm_new_reserve( plcm_t plcm, pl_size_t size, pl_size_t reserve )
+{
+    pl_t mem;
 
-            omem = plum_put( plum, mem, osize );
-            nmem = plum_get( plum, nsize );
+    plcm__init( plcm );
 
-            if ( omem != nmem ) {
-                if ( nsize > osize ) {
-                    size = osize;
-                } else {
-                    size = nsize;
-                }
-                memcpy( nmem, mem, size );
-            }
+    reserve = PLINTH_ALIGN_TO( reserve, pl__page_size() );
+    if ( size > reserve ) {
+        return NULL;
+    }
 
-            return nmem;
-        }
+    mem = mmap( NULL, reserve, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+    if ( mem == MAP_FAILED ) {
+        return NULL;
+    }
 
+    plcm->data = mem;
+    plcm->type = PL_AA_MMAP;
+    plcm->reserve = reserve;
+    if ( size > 0 && !plcm__commit( plcm, size ) ) {
         /* GCOV_EXCL_START */
-        default:
-            return NULL;
-            /* GCOV_EXCL_STOP */
+        plcm_del( plcm );
+        return NULL;
+        /* GCOV_EXCL_STOP */
     }
-}
 
-
-pl_aa_t plum_type( plum_t plum )
-{
-    return plum->type;
+    return plcm;
 }
 
 
-pl_t plum_host( plum_t plum )
+plcm_t plcm_new_mmap( plcm_t plcm, pl_size_t size )
 {
-    return plum->host;
-}
+    pl_t mem;
 
+    plcm__init( plcm );
 
+    size = PLINTH_ALIGN_TO( size, pl__page_size() );
+    if ( size == 0 ) {
+        size = pl__page_size();
+    }
 
-/* ------------------------------------------------------------
- * String Storage:
- */
+    mem = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if ( mem == MAP_FAILED ) {
+        return NULL; /* GCOV_EXCL_LINE */
+    }
+
+    plcm->data = mem;
+    plcm->size = size;
+    plcm->type = PL_AA_MMAP;
 
-plcm_t plss_from_plsr( plcm_t plcm, plsr_s plsr )
-{
-    plcm__init( plcm );
-    plcm->data = (pl_t)plsr_string( plsr );
-    plcm->used = plsr_length( plsr );
     return plcm;
 }
 
 
-plcm_t plss_append( plcm_t plcm, plsr_s str )
+plcm_t plcm_use( plcm_t plcm, pl_t mem, pl_size_t size )
 {
-    plcm_resize( plcm, plcm->used + str.length + 1 );
-    memcpy( plcm->data + plcm->used, str.string, str.length );
-    plcm->used += str.length;
-    plss__terminate( plcm );
+    plcm->size = size;
+    plcm->used = 0;
+    plcm->data = mem;
+    plcm->type = PL_AA_SELF;
+    plcm->align = 0;
+    plcm->flags = 0;
+    plcm->growth = PL_GP_DOUBLE;
+    plcm->gcap = 0;
+    plcm->host = NULL;
     return plcm;
 }
 
 
-plcm_t plss_append_string( plcm_t plcm, const char* str )
+plcm_t plcm_use_plam( plcm_t plcm, plam_t host, pl_size_t size )
 {
-    return plss_append( plcm, plsr_from_string( str ) );
+    return plcm_use( plcm, plam_get( host, size ), size );
 }
 
 
-plcm_t plss_append_char( plcm_t plcm, char ch )
+plcm_t plcm_use_plbm( plcm_t plcm, plbm_t host )
 {
-    char ch_null[ 2 ];
-    ch_null[ 0 ] = ch;
-    ch_null[ 1 ] = 0;
-    return plss_append( plcm, plsr_from_string_and_length( ch_null, 1 ) );
+    plcm_use( plcm, plbm_get( host ), plbm_block_size( host ) );
+    return plcm;
 }
 
 
-pl_none plss_remove( plcm_t plcm, pl_pos_t pos, pl_size_t size )
+plcm_t plcm_into_plam( plcm_t plcm, plam_t host, pl_size_t size )
 {
-    memmove( plcm->data + pos, plcm->data + pos + size, plcm->used - pos - size + 1 );
-    plcm->used -= size;
+    plcm__init( plcm );
+    plcm->data = plam_get( host, size );
+    if ( plcm->data == NULL ) {
+        return NULL; /* GCOV_EXCL_LINE */
+    }
+    plcm->size = size;
+    plcm->type = PL_AA_PLAM;
+    plcm->host = host;
+    return plcm;
 }
 
 
-pl_none plss_insert( plcm_t plcm, pl_pos_t pos, pl_t data, pl_size_t size )
+plcm_t plcm_empty( plcm_t plcm, pl_size_t size )
 {
-    if ( pos >= plcm->used ) {
-        plss_append( plcm, plsr_from_string_and_length( data, size ) );
-    } else {
-        memmove( plcm->data + pos + size, plcm->data + pos, plcm->used - pos + 1 );
-        plcm->used += size;
-        plcm_set( plcm, pos, data, size );
-    }
+    plcm__init( plcm );
+    plcm->size = size;
+    return plcm;
 }
 
 
-plcm_t plss_set( plcm_t plcm, plsr_s str )
+plcm_t plcm_empty_ptr( plcm_t plcm, pl_size_t size )
 {
-    plcm_resize( plcm, str.length + 1 );
-    memcpy( plcm->data, str.string, str.length );
-    plcm->used = str.length;
-    plss__terminate( plcm );
-    return plcm;
+    return plcm_empty( plcm, size * sizeof( pl_t ) );
 }
 
 
-plcm_t plss_refresh( plcm_t plcm )
+pl_none plcm_set_zeroing( plcm_t plcm, pl_bool_t zeroing )
 {
-    pl_size_t length;
+    if ( zeroing ) {
+        plcm->flags &= ~PL_MF_NOZERO;
+    } else {
+        plcm->flags |= PL_MF_NOZERO;
+    }
+}
 
-    length = strlen( plcm->data );
-    plcm->used = length;
-    return plcm;
+
+pl_none plcm_set_growth( plcm_t plcm, pl_gp_t growth, pl_size_t cap )
+{
+    plcm->growth = growth;
+    plcm->gcap = cap;
 }
 
 
-plcm_t plss_compact( plcm_t plcm )
+plcm_s plcm_shadow( plcm_t plcm )
 {
-    plcm->used++;
-    plcm_compact( plcm );
-    plcm->used--;
-    return plcm;
+    plcm_s shadow;
+    shadow = *plcm;
+    shadow.size = 0;
+    return shadow;
 }
 
 
-plcm_t plss_format_string( plcm_t plcm, const char* fmt, ... )
+pl_none plcm_copy_to( plcm_t plcm, plcm_t target, pl_t mem, pl_size_t size )
 {
-    va_list ap;
-
-    va_start( ap, fmt );
-    plss_va_format_string( plcm, fmt, ap );
-    va_end( ap );
-
-    return plcm;
+    plcm_use( target, mem, size );
+    if ( plcm_get_ref( target, plcm_used( plcm ) ) == NULL ) {
+        return; /* GCOV_EXCL_LINE */
+    }
+    memcpy( target->data, plcm->data, plcm_used( plcm ) );
 }
 
 
-plcm_t plss_reformat_string( plcm_t plcm, const char* fmt, ... )
+plcm_s plcm_copy( plcm_t plcm )
 {
-    va_list ap;
-
-    plcm_reset( plcm );
-    va_start( ap, fmt );
-    plss_va_format_string( plcm, fmt, ap );
-    va_end( ap );
-
-    return plcm;
+    plcm_s copy;
+    plcm_new( &copy, plcm_size( plcm ) );
+    plcm_copy_to( plcm, &copy, copy.data, plcm_size( &copy ) );
+    /* NOTE: plcm_use (in plcm_copy_to) invalidates the type field. */
+    copy.type = PL_AA_HEAP;
+    return copy;
 }
 
 
-pl_none plss_va_format_string( plcm_t plcm, const char* fmt, va_list ap )
+plcm_t plcm_del( plcm_t plcm )
 {
-    va_list coap;
-
-    /* Copy ap to coap for second va-call. */
-    va_copy( coap, ap );
-
-    pl_pos_t size;
-    size = vsnprintf( NULL, 0, fmt, ap );
-
-    if ( size < 0 ) {
-        return; /* GCOV_EXCL_LINE */
+    if ( ( plcm->type == PL_AA_HEAP ) && !_plcm_is_empty( plcm ) ) {
+        pl_free_memory( plcm->data );
+    } else if ( plcm->type == PL_AA_MMAP && plcm->reserve ) {
+        munmap( plcm->data, plcm->reserve );
+    } else if ( plcm->type == PL_AA_MMAP ) {
+        munmap( plcm->data, plcm->size );
+    } else if ( plcm->type == PL_AA_PLAM && plcm__at_tip( plcm ) ) {
+        ( (plam_t)plcm->host )->node->used -= plcm->size;
     }
-
-    plcm_resize( plcm, plcm->used + size + 1 );
-    size = vsnprintf( plcm->data + plcm->used, size + 1, fmt, coap );
-    va_end( coap );
-
-    plcm->used += size;
+    plcm__init( plcm );
+    return NULL;
 }
 
 
-plcm_t plss_read_file( plcm_t plcm, const char* filename )
+pl_bool_t plcm_resize( plcm_t plcm, pl_size_t size )
 {
-    return plss_read_file_with_pad( plcm, filename, 0, 0 );
-}
+    if ( _plcm_is_empty( plcm ) || size > plcm->size ) {
 
+        pl_size_t new_size;
 
-plcm_t plss_read_file_with_pad( plcm_t plcm, const char* filename, pl_size_t left, pl_size_t right )
-{
-    off_t       size;
-    struct stat st;
-    int         fd;
-    char*       str;
+        if ( _plcm_is_empty( plcm ) ) {
 
-    if ( filename ) {
+            /* Empty plcm. */
+            if ( plcm->size == 0 || size > plcm->size ) {
+                new_size = PLINTH_ALIGN_TO( size, 64 );
+            } else {
+                new_size = plcm->size;
+            }
 
-        if ( stat( filename, &st ) == 0 ) {
-            size = st.st_size;
-        } else {
-            size = -1; /* GCOV_EXCL_LINE */
-        }
+            plcm->data = plcm__alloc( plcm, &new_size );
+            if ( plcm->data ) {
+                plcm->size = new_size;
+                plcm->used = 0;
+                plcm->type = PL_AA_HEAP;
+            } else {
+                /* GCOV_EXCL_START */
+                plcm__init( plcm );
+                plcm->type = PL_AA_NONE;
+                /* GCOV_EXCL_STOP */
+            }
 
-        if ( size < 0 ) {
-            return NULL; /* GCOV_EXCL_LINE */
-        }
+        } else if ( plcm->type == PL_AA_MMAP && plcm->reserve ) {
 
-        plcm_resize( plcm, plcm_used( plcm ) + size + left + right + 1 );
+            if ( !plcm__commit( plcm, size ) ) {
+                /* Reservation exhausted, but data remains valid. */
+                return pl_false;
+            }
 
-        if ( _plcm_is_empty( plcm ) ) {
-            return NULL; /* GCOV_EXCL_LINE */
-        }
+        } else if ( plcm->type == PL_AA_PLAM ) {
 
-        fd = open( filename, O_RDONLY );
-        if ( fd == -1 ) {
-            return NULL; /* GCOV_EXCL_LINE */
-        }
+            if ( !plcm__grow_plam( plcm, size ) ) {
+                /* GCOV_EXCL_START */
+                plcm__init( plcm );
+                plcm->type = PL_AA_NONE;
+                /* GCOV_EXCL_STOP */
+            }
 
-        str = (char*)plss_string( plcm );
-        read( fd, &str[ left ], size );
-        /* Zero the head. */
-        if ( left > 0 ) {
-            memset( &str[ plcm_used( plcm ) ], 0, left );
-        }
-        /* Zero the tail. */
-        memset( &str[ plcm_used( plcm ) + size + left ], 0, right + 1 );
-        plcm->used += size + left;
-        close( fd );
+        } else if ( plcm->type == PL_AA_MMAP ) {
 
-    } else {
+            new_size = PLINTH_ALIGN_TO( plcm__grow_size( plcm, size ), pl__page_size() );
+            if ( !plcm__remap( plcm, new_size ) ) {
+                /* GCOV_EXCL_START */
+                plcm_del( plcm );
+                plcm->type = PL_AA_NONE;
+                /* GCOV_EXCL_STOP */
+            }
 
-        pl_size_t pagesize;
-        pl_size_t pos;
-        ssize_t   cnt;
+        } else if ( plcm->type == PL_AA_SELF ) {
 
-        /* GCOV_EXCL_START */
-        fd = STDIN_FILENO;
-        pos = plcm_used( plcm ) + left;
-        pagesize = sysconf( _SC_PAGESIZE );
+            pl_t new_mem;
 
-        while ( 1 ) {
-            if ( ( pos + pagesize ) > plcm_size( plcm ) ) {
-                plcm_resize( plcm, plcm_size( plcm ) + pagesize );
+            new_size = plcm__grow_size( plcm, size );
+            new_mem = plcm__alloc( plcm, &new_size );
+            if ( new_mem ) {
+                memcpy( new_mem, plcm->data, plcm->size );
+                plcm->data = new_mem;
+                plcm->size = new_size;
+                plcm->type = PL_AA_HEAP;
+            } else {
+                /* GCOV_EXCL_START */
+                plcm__init( plcm );
+                plcm->type = PL_AA_NONE;
+                /* GCOV_EXCL_STOP */
             }
-            str = plcm->data;
-            cnt = read( fd, &str[ pos ], pagesize );
-            if ( cnt == 0 ) {
-                /* Stop reading with EOF. */
-                if ( left > 0 ) {
-                    memset( &str[ plcm_used( plcm ) ], 0, left );
+
+        } else {
+
+            new_size = plcm__grow_size( plcm, size );
+
+            if ( plcm->align ) {
+                /* Realloc does not keep alignment. */
+                pl_t new_mem;
+                new_mem = plcm__alloc( plcm, &new_size );
+                if ( new_mem ) {
+                    memcpy( new_mem, plcm->data, plcm->size );
                 }
-                if ( ( pos + right + 1 ) > plcm_size( plcm ) ) {
-                    plcm_resize( plcm, plcm_size( plcm ) + pos + right + 1 );
+                pl_free_memory( plcm->data );
+                plcm->data = new_mem;
+            } else {
+                plcm->data = pl_realloc_memory( plcm->data, new_size );
+            }
+
+            if ( plcm->data ) {
+                if ( !( plcm->flags & PL_MF_NOZERO ) ) {
+                    memset( plcm->data + plcm->size, 0, ( new_size - plcm->size ) );
                 }
-                /* Zero the tail. */
-                memset( &str[ plcm_used( plcm ) + pos ], 0, right + 1 );
-                plcm->used += pos;
-                break;
-            } else if ( cnt < 0 ) {
-                /* Stop reading with error and exit with NULL. */
-                return NULL;
+                plcm->size = new_size;
+            } else {
+                /* GCOV_EXCL_START */
+                plcm__init( plcm );
+                plcm->type = PL_AA_NONE;
+                /* GCOV_EXCL_STOP */
             }
-            pos += cnt;
         }
-        /* GCOV_EXCL_STOP */
     }
 
-    return plcm;
+    return ( plcm->type != PL_AA_NONE );
 }
 
 
-plcm_t plss_read_line_with_newline( plcm_t plcm, FILE* fh )
+pl_none plcm_increase( plcm_t plcm, pl_size_t size )
 {
-    pl_size_t count;
-    pl_size_t size;
-    char*     str;
-    int       ch;
+    plcm_resize( plcm, plcm->size + size );
+}
 
-    count = 0;
-    size = plcm_size( plcm );
-    str = (char*)plcm_data( plcm );
-    plcm_reset( plcm );
 
-    while ( 1 ) {
-        ch = fgetc( fh );
-        if ( ch == EOF ) {
-            if ( count == 0 ) {
-                return NULL;
-            } else {
-                break;
-            }
-        } else {
-            if ( ( count + 1 ) >= size ) {
-                size *= 2;
-                plcm_resize( plcm, size );
-            }
-            str[ count++ ] = (char)ch;
-            if ( ch == '\n' ) {
-                break;
+pl_t plcm_ensure( plcm_t plcm, pl_size_t size )
+{
+    if ( !plcm_resize( plcm, plcm->used + size ) ) {
+        return NULL;
+    }
+    return plcm_end( plcm );
+}
+
+
+pl_none plcm_compact( plcm_t plcm )
+{
+    if ( ( plcm->type == PL_AA_HEAP ) && plcm->align ) {
+        pl_t      new_mem;
+        pl_size_t new_size;
+        new_size = plcm->used;
+        if ( new_size > 0 && PLINTH_ALIGN_TO( new_size, plcm->align ) < plcm->size ) {
+            new_mem = plcm__alloc( plcm, &new_size );
+            if ( new_mem ) {
+                memcpy( new_mem, plcm->data, plcm->used );
+                pl_free_memory( plcm->data );
+                plcm->data = new_mem;
+                plcm->size = new_size;
             }
         }
+    } else if ( ( plcm->type == PL_AA_HEAP ) ) {
+        plcm->data = pl_realloc_memory( plcm->data, plcm->used );
+        plcm->size = plcm->used;
+    } else if ( plcm->type == PL_AA_MMAP && plcm->reserve ) {
+        /* Decommit pages after used, but keep the reservation. */
+        pl_size_t size;
+        size = PLINTH_ALIGN_TO( plcm->used, pl__page_size() );
+        if ( size < plcm->size ) {
+            madvise( plcm->data + size, plcm->size - size, MADV_DONTNEED );
+            mprotect( plcm->data + size, plcm->size - size, PROT_NONE );
+            plcm->size = size;
+        }
+    } else if ( plcm->type == PL_AA_MMAP ) {
+        /* Unmap pages after used, but keep at least one page. */
+        pl_size_t size;
+        size = PLINTH_ALIGN_TO( plcm->used, pl__page_size() );
+        if ( size == 0 ) {
+            size = pl__page_size();
+        }
+        if ( size < plcm->size ) {
+            plcm__remap( plcm, size );
+        }
+    } else if ( plcm->type == PL_AA_PLAM && plcm__at_tip( plcm ) ) {
+        /* Return unused tail to host. */
+        ( (plam_t)plcm->host )->node->used -= plcm->size - plcm->used;
+        plcm->size = plcm->used;
     }
+}
 
-    if ( ( count + 1 ) >= size ) {
-        plcm_resize( plcm, size + 1 );
+
+pl_pos_t plcm_get_pos( plcm_t plcm, pl_size_t size )
+{
+    pl_pos_t ret;
+    if ( !plcm_resize( plcm, plcm->used + size ) ) {
+        return -1;
     }
+    ret = plcm->used;
+    plcm->used += size;
+    return ret;
+}
 
-    str[ count ] = 0;
-    plcm_consume( plcm, count );
 
-    return plcm;
+pl_none plcm_put( plcm_t plcm, pl_size_t size )
+{
+    if ( size <= plcm->used ) {
+        plcm->used -= size;
+    }
 }
 
 
-plcm_t plss_read_line( plcm_t plcm, FILE* fh )
+pl_pos_t plcm_store( plcm_t plcm, pl_t data, pl_size_t size )
 {
-    pl_size_t len;
-    char*     str;
-
-    if ( plss_read_line_with_newline( plcm, fh ) == NULL ) {
-        return NULL;
-    }
-    len = plcm_used( plcm );
-    str = plcm_data( plcm );
-    if ( str[ len - 1 ] == '\n' ) {
-        str[ len - 1 ] = 0;
-        plcm_pop( plcm, 1 );
+    pl_pos_t ret;
+    ret = plcm_get_pos( plcm, size );
+    if ( ret >= 0 ) {
+        plcm_set( plcm, ret, data, size );
+    }
+    return ret;
+}
+
+
+pl_pos_t plcm_store_ptr( plcm_t plcm, pl_t ptr )
+{
+    return plcm_store( plcm, &ptr, sizeof( pl_t ) );
+}
+
+
+pl_none plcm_store_null( plcm_t plcm )
+{
+    if ( !plcm_resize( plcm, plcm->used + sizeof( pl_t ) ) ) {
+        return;
+    }
+    plcm_terminate_ptr( plcm );
+}
+
+
+pl_t plcm_ref( plcm_t plcm, pl_pos_t pos )
+{
+    return plcm->data + pos;
+}
+
+
+pl_t plcm_ref_ptr( plcm_t plcm, pl_pos_t pos )
+{
+    return *(pl_p)( plcm->data + pos * sizeof( pl_t ) );
+}
+
+
+pl_none plcm_set( plcm_t plcm, pl_pos_t pos, const pl_t data, pl_size_t size )
+{
+    memcpy( plcm_ref( plcm, pos ), data, size );
+}
+
+
+pl_none plcm_set_ptr( plcm_t plcm, pl_pos_t pos, const pl_t ptr )
+{
+    memcpy( plcm_ref( plcm, pos * sizeof( pl_t ) ), &ptr, sizeof( pl_t ) );
+}
+
+
+pl_t plcm_consume( plcm_t plcm, pl_size_t size )
+{
+    pl_t ret;
+    ret = plcm_end( plcm );
+    plcm->used += size;
+    return ret;
+}
+
+
+pl_t plcm_pop( plcm_t plcm, pl_size_t size )
+{
+    plcm->used -= size;
+    return plcm_end( plcm );
+}
+
+
+pl_t plcm_pop_ptr( plcm_t plcm )
+{
+    pl_p pop;
+    pop = plcm_pop( plcm, sizeof( pl_t ) );
+    return *pop;
+}
+
+
+pl_none plcm_remove( plcm_t plcm, pl_pos_t pos, pl_size_t size )
+{
+    memmove( plcm->data + pos, plcm->data + pos + size, plcm->used - pos - size );
+    plcm->used -= size;
+}
+
+
+pl_none plcm_remove_ptr( plcm_t plcm, pl_pos_t pos )
+{
+    plcm_remove( plcm, pos * sizeof( pl_t ), sizeof( pl_t ) );
+}
+
+
+pl_none plcm_insert( plcm_t plcm, pl_pos_t pos, pl_t data, pl_size_t size )
+{
+    memmove( plcm->data + pos + size, plcm->data + pos, plcm->used - pos );
+    plcm->used += size;
+    plcm_set( plcm, pos, data, size );
+}
+
+
+pl_none plcm_insert_ptr( plcm_t plcm, pl_pos_t pos, pl_t ptr )
+{
+    plcm_insert( plcm, pos * sizeof( pl_t ), &ptr, sizeof( pl_t ) );
+}
+
+
+pl_bool_t plcm_terminate( plcm_t plcm, pl_size_t size )
+{
+    if ( plcm->used + size <= plcm->size ) {
+        memset( plcm->data + plcm->used, 0, size );
+        return pl_true;
+    } else {
+        return pl_false;
+    }
+}
+
+
+pl_bool_t plcm_terminate_ptr( plcm_t plcm )
+{
+    return plcm_terminate( plcm, sizeof( pl_t ) );
+}
+
+
+pl_none plcm_reset( plcm_t plcm )
+{
+    plcm->used = 0;
+}
+
+
+pl_none plcm_clear( plcm_t plcm )
+{
+    plcm->used = 0;
+    pl_clear_memory( plcm->data, plcm->size );
+}
+
+
+pl_size_t plcm_used( plcm_t plcm )
+{
+    return plcm->used;
+}
+
+
+pl_size_t plcm_used_ptr( plcm_t plcm )
+{
+    return ( plcm->used / sizeof( pl_t ) );
+}
+
+
+pl_size_t plcm_size( plcm_t plcm )
+{
+    return plcm->size;
+}
+
+
+pl_size_t plcm_size_ptr( plcm_t plcm )
+{
+    return ( plcm->size / sizeof( pl_t ) );
+}
+
+
+pl_t plcm_data( plcm_t plcm )
+{
+    return plcm->data;
+}
+
+
+pl_bool_t plcm_debt( plcm_t plcm )
+{
+    return ( plcm->type == PL_AA_HEAP || plcm->type == PL_AA_MMAP );
+}
+
+
+pl_t plcm_end( plcm_t plcm )
+{
+    return plcm->data + plcm->used;
+}
+
+
+pl_t plcm_tail( plcm_t plcm, pl_size_t size )
+{
+    return plcm->data + plcm->used - size;
+}
+
+
+pl_bool_t plcm_is_empty( plcm_t plcm )
+{
+    return _plcm_is_empty( plcm );
+}
+
+
+pl_pos_t plcm_find_ptr( plcm_t plcm, pl_t ref )
+{
+    for ( pl_size_t i = 0; i < plcm_used_ptr( plcm ); i++ ) {
+        if ( plcm_ref_ptr( plcm, i ) == ref ) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+
+pl_pos_t plcm_find_with( plcm_t plcm, plcm_compare_fn_t compare, pl_size_t size, pl_t ref )
+{
+    for ( pl_size_t i = 0; i < plcm_used( plcm ); i += size ) {
+        if ( compare( size, plcm_ref( plcm, i ), ref ) ) {
+            return ( i / size );
+        }
+    }
+
+    return -1;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Inline Continuous Memory Allocator:
+ */
+
+plcm_t plci_new( plci_t plci )
+{
+    return plcm_use( &plci->plcm, plci->local, PLCI_SIZE );
+}
+
+
+pl_none plci_del( plci_t plci )
+{
+    plcm_del( &plci->plcm );
+    plci_new( plci );
+}
+
+
+pl_bool_t plci_is_inline( plci_t plci )
+{
+    return ( plci->plcm.type == PL_AA_SELF );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Unified Memory Allocator:
+ */
+
+pl_none plum_use( plum_t plum, pl_aa_t type, pl_t host )
+{
+    plum->type = type;
+    plum->host = host;
+}
+
+
+pl_t plum_get( plum_t plum, pl_size_t size )
+{
+    switch ( plum->type ) {
+        case PL_AA_HEAP: {
+            return pl_alloc_memory( size );
+        }
+        case PL_AA_PLAM: {
+            return plam_get( (plam_t)plum->host, size );
+        }
+        case PL_AA_PLBM: {
+            plbm_t plbm;
+            plbm = (plbm_t)plum->host;
+            if ( size <= plbm_block_size( plbm ) ) {
+                return plbm_get( plbm );
+            } else {
+                return NULL;
+            }
+        }
+        case PL_AA_PLCM: {
+            return plcm_get_ref( (plcm_t)plum->host, size );
+        }
+        /* GCOV_EXCL_START */
+        default:
+            return NULL;
+            /* GCOV_EXCL_STOP */
+    }
+}
+
+
+pl_t plum_put( plum_t plum, pl_t mem, pl_size_t size )
+{
+    switch ( plum->type ) {
+
+        case PL_AA_HEAP: {
+            pl_free_memory( mem );
+            return NULL;
+        }
+
+        case PL_AA_PLAM: {
+
+            plam_t    plam;
+            pl_size_t used_ref;
+            pl_t      mem_ref;
+
+            plam = (plam_t)plum->host;
+
+            while ( 1 ) {
+                if ( plam->node->used > 0 ) {
+                    used_ref = plam->node->used - size;
+                    mem_ref = plam->node->data + used_ref;
+                    if ( mem == mem_ref ) {
+                        plam->node->used -= size;
+                        return mem;
+                    } else {
+                        return NULL;
+                    }
+                } else if ( plam->node->prev ) {
+                    plam->node = plam->node->prev;
+                } else {
+                    return NULL;
+                }
+            }
+        }
+
+        case PL_AA_PLBM: {
+            plbm_put( (plbm_t)plum->host, mem );
+            return mem;
+        }
+
+        case PL_AA_PLCM: {
+
+            plcm_t    plcm;
+            pl_size_t used_ref;
+            pl_t      mem_ref;
+
+            plcm = (plcm_t)plum->host;
+
+            used_ref = plcm->used - size;
+            mem_ref = plcm->data + used_ref;
+
+            if ( mem == mem_ref ) {
+                plcm_put( plcm, size );
+                return mem;
+            } else {
+                return NULL;
+            }
+        }
+        /* GCOV_EXCL_START */
+        default:
+            return NULL;
+            /* GCOV_EXCL_STOP */
+    }
+}
+
+
+pl_t plum_store( plum_t plum, const pl_t data, pl_size_t size )
+{
+    pl_t mem;
+    mem = plum_get( plum, size );
+    if ( mem ) {
+        memcpy( mem, data, size );
+    }
+    return mem;
+}
+
+
+pl_t plum_store_ptr( plum_t plum, pl_t ptr )
+{
+    return plum_store( plum, &ptr, sizeof( pl_t ) );
+}
+
+
+pl_t plum_update( plum_t plum, pl_t mem, pl_size_t osize, pl_size_t nsize )
+{
+    switch ( plum->type ) {
+
+        case PL_AA_HEAP: {
+            pl_t new_mem;
+            new_mem = pl_realloc_memory( mem, nsize );
+            if ( nsize > osize ) {
+                memset( new_mem + osize, 0, ( nsize - osize ) );
+            }
+            return new_mem;
+        }
+
+        case PL_AA_PLAM:
+        case PL_AA_PLBM:
+        case PL_AA_PLCM: {
+
+            pl_t      omem;
+            pl_t      nmem;
+            pl_size_t size;
+
+            omem = plum_put( plum, mem, osize );
+            nmem = plum_get( plum, nsize );
+
+            if ( omem != nmem ) {
+                if ( nsize > osize ) {
+                    size = osize;
+                } else {
+                    size = nsize;
+                }
+                memcpy( nmem, mem, size );
+            }
+
+            return nmem;
+        }
+
+        /* GCOV_EXCL_START */
+        default:
+            return NULL;
+            /* GCOV_EXCL_STOP */
+    }
+}
+
+
+pl_aa_t plum_type( plum_t plum )
+{
+    return plum->type;
+}
+
+
+pl_t plum_host( plum_t plum )
+{
+    return plum->host;
+}
+
+
+
+/* ------------------------------------------------------------
+ * String Storage:
+ */
+
+plcm_t plss_from_plsr( plcm_t plcm, plsr_s plsr )
+{
+    plcm__init( plcm );
+    plcm->data = (pl_t)plsr_string( plsr );
+    plcm->used = plsr_length( plsr );
+    return plcm;
+}
+
+
+plcm_t plss_append( plcm_t plcm, plsr_s str )
+{
+    if ( !plcm_resize( plcm, plcm->used + str.length + 1 ) ) {
+        return NULL;
+    }
+    memcpy( plcm->data + plcm->used, str.string, str.length );
+    plcm->used += str.length;
+    plss__terminate( plcm );
+    return plcm;
+}
+
+
+plcm_t plss_append_string( plcm_t plcm, const char* str )
+{
+    return plss_append( plcm, plsr_from_string( str ) );
+}
+
+
+plcm_t plss_append_char( plcm_t plcm, char ch )
+{
+    char ch_null[ 2 ];
+    ch_null[ 0 ] = ch;
+    ch_null[ 1 ] = 0;
+    return plss_append( plcm, plsr_from_string_and_length( ch_null, 1 ) );
+}
+
+
+pl_none plss_remove( plcm_t plcm, pl_pos_t pos, pl_size_t size )
+{
+    memmove( plcm->data + pos, plcm->data + pos + size, plcm->used - pos - size + 1 );
+    plcm->used -= size;
+}
+
+
+pl_none plss_insert( plcm_t plcm, pl_pos_t pos, pl_t data, pl_size_t size )
+{
+    if ( pos >= plcm->used ) {
+        plss_append( plcm, plsr_from_string_and_length( data, size ) );
+    } else {
+        if ( !plcm_resize( plcm, plcm->used + size + 1 ) ) {
+            return;
+        }
+        memmove( plcm->data + pos + size, plcm->data + pos, plcm->used - pos + 1 );
+        plcm->used += size;
+        plcm_set( plcm, pos, data, size );
+    }
+}
+
+
+plcm_t plss_set( plcm_t plcm, plsr_s str )
+{
+    if ( !plcm_resize( plcm, str.length + 1 ) ) {
+        return NULL;
+    }
+    memcpy( plcm->data, str.string, str.length );
+    plcm->used = str.length;
+    plss__terminate( plcm );
+    return plcm;
+}
+
+
+plcm_t plss_refresh( plcm_t plcm )
+{
+    pl_size_t length;
+
+    length = strlen( plcm->data );
+    plcm->used = length;
+    return plcm;
+}
+
+
+plcm_t plss_compact( plcm_t plcm )
+{
+    plcm->used++;
+    plcm_compact( plcm );
+    plcm->used--;
+    return plcm;
+}
+
+
+plcm_t plss_format_string( plcm_t plcm, const char* fmt, ... )
+{
+    va_list ap;
+
+    va_start( ap, fmt );
+    plss_va_format_string( plcm, fmt, ap );
+    va_end( ap );
+
+    return plcm;
+}
+
+
+plcm_t plss_reformat_string( plcm_t plcm, const char* fmt, ... )
+{
+    va_list ap;
+
+    plcm_reset( plcm );
+    va_start( ap, fmt );
+    plss_va_format_string( plcm, fmt, ap );
+    va_end( ap );
+
+    return plcm;
+}
+
+
+pl_none plss_va_format_string( plcm_t plcm, const char* fmt, va_list ap )
+{
+    va_list coap;
+
+    /* Copy ap to coap for second va-call. */
+    va_copy( coap, ap );
+
+    pl_pos_t size;
+    size = vsnprintf( NULL, 0, fmt, ap );
+
+    if ( size < 0 ) {
+        return; /* GCOV_EXCL_LINE */
+    }
+
+    if ( !plcm_resize( plcm, plcm->used + size + 1 ) ) {
+        va_end( coap );
+        return;
+    }
+    size = vsnprintf( plcm->data + plcm->used, size + 1, fmt, coap );
+    va_end( coap );
+
+    plcm->used += size;
+}
+
+
+plcm_t plss_read_file( plcm_t plcm, const char* filename )
+{
+    return plss_read_file_with_pad( plcm, filename, 0, 0 );
+}
+
+
+plcm_t plss_read_file_with_pad( plcm_t plcm, const char* filename, pl_size_t left, pl_size_t right )
+{
+    off_t       size;
+    struct stat st;
+    int         fd;
+    char*       str;
+
+    if ( filename ) {
+
+        if ( stat( filename, &st ) == 0 ) {
+            size = st.st_size;
+        } else {
+            size = -1; /* GCOV_EXCL_LINE */
+        }
+
+        if ( size < 0 ) {
+            return NULL; /* GCOV_EXCL_LINE */
+        }
+
+        if ( !plcm_resize( plcm, plcm_used( plcm ) + size + left + right + 1 ) ) {
+            return NULL;
+        }
+
+        fd = open( filename, O_RDONLY );
+        if ( fd == -1 ) {
+            return NULL; /* GCOV_EXCL_LINE */
+        }
+
+        str = (char*)plss_string( plcm );
+        read( fd, &str[ left ], size );
+        /* Zero the head. */
+        if ( left > 0 ) {
+            memset( &str[ plcm_used( plcm ) ], 0, left );
+        }
+        /* Zero the tail. */
+        memset( &str[ plcm_used( plcm ) + size + left ], 0, right + 1 );
+        plcm->used += size + left;
+        close( fd );
+
+    } else {
+
+        pl_size_t pagesize;
+        pl_size_t pos;
+        ssize_t   cnt;
+
+        /* GCOV_EXCL_START */
+        fd = STDIN_FILENO;
+        pos = plcm_used( plcm ) + left;
+        pagesize = sysconf( _SC_PAGESIZE );
+
+        while ( 1 ) {
+            if ( ( pos + pagesize ) > plcm_size( plcm ) ) {
+                if ( !plcm_resize( plcm, plcm_size( plcm ) + pagesize ) ) {
+                    return NULL;
+                }
+            }
+            str = plcm->data;
+            cnt = read( fd, &str[ pos ], pagesize );
+            if ( cnt == 0 ) {
+                /* Stop reading with EOF. */
+                if ( left > 0 ) {
+                    memset( &str[ plcm_used( plcm ) ], 0, left );
+                }
+                if ( ( pos + right + 1 ) > plcm_size( plcm ) ) {
+                    if ( !plcm_resize( plcm, plcm_size( plcm ) + pos + right + 1 ) ) {
+                        return NULL;
+                    }
+                    str = plcm->data;
+                }
+                /* Zero the tail. */
+                memset( &str[ plcm_used( plcm ) + pos ], 0, right + 1 );
+                plcm->used += pos;
+                break;
+            } else if ( cnt < 0 ) {
+                /* Stop reading with error and exit with NULL. */
+                return NULL;
+            }
+            pos += cnt;
+        }
+        /* GCOV_EXCL_STOP */
+    }
+
+    return plcm;
+}
+
+
+plcm_t plss_read_line_with_newline( plcm_t plcm, FILE* fh )
+{
+    pl_size_t count;
+    pl_size_t size;
+    char*     str;
+    int       ch;
+
+    count = 0;
+    size = plcm_size( plcm );
+    str = (char*)plcm_data( plcm );
+    plcm_reset( plcm );
+
+    while ( 1 ) {
+        ch = fgetc( fh );
+        if ( ch == EOF ) {
+            if ( count == 0 ) {
+                return NULL;
+            } else {
+                break;
+            }
+        } else {
+            if ( ( count + 1 ) >= size ) {
+                size *= 2;
+                if ( !plcm_resize( plcm, size ) ) {
+                    return NULL;
+                }
+                str = (char*)plcm_data( plcm );
+            }
+            str[ count++ ] = (char)ch;
+            if ( ch == '\n' ) {
+                break;
+            }
+        }
+    }
+
+    if ( ( count + 1 ) >= size ) {
+        if ( !plcm_resize( plcm, size + 1 ) ) {
+            return NULL;
+        }
+        str = (char*)plcm_data( plcm );
+    }
+
+    str[ count ] = 0;
+    plcm_consume( plcm, count );
+
+    return plcm;
+}
+
+
+plcm_t plss_read_line( plcm_t plcm, FILE* fh )
+{
+    pl_size_t len;
+    char*     str;
+
+    if ( plss_read_line_with_newline( plcm, fh ) == NULL ) {
+        return NULL;
+    }
+    len = plcm_used( plcm );
+    str = plcm_data( plcm );
+    if ( str[ len - 1 ] == '\n' ) {
+        str[ len - 1 ] = 0;
+        plcm_pop( plcm, 1 );
+    }
+
+    return plcm;
+}
+
+
+plcm_t plss_write_file( plcm_t plcm, const char* filename )
+{
+    int fd;
+
+    if ( filename ) {
+        fd = creat( filename, 0666 );
+        if ( fd == -1 ) {
+            return NULL; /* GCOV_EXCL_LINE */
+        }
+        write( fd, plss_string( plcm ), plss_length( plcm ) );
+        close( fd );
+    } else {
+        /* GCOV_EXCL_START */
+        fd = STDOUT_FILENO;
+        write( fd, plss_string( plcm ), plss_length( plcm ) );
+        /* GCOV_EXCL_STOP */
+    }
+
+    return plcm;
+}
+
+
+pl_size_t plss_write_to( plsr_s plsr, FILE* fh )
+{
+    return (pl_size_t)fwrite( plsr_string( plsr ), 1, plsr_length( plsr ), fh );
+}
+
+
+const char* plss_string( plcm_t plcm )
+{
+    return (const char*)plcm_ref( plcm, 0 );
+}
+
+
+pl_size_t plss_length( plcm_t plcm )
+{
+    return plcm_used( plcm );
+}
+
+
+plsr_s plss_ref( plcm_t plcm )
+{
+    plsr_s ret;
+    ret.string = (char*)plss_string( plcm );
+    ret.length = plss_length( plcm );
+    return ret;
+}
+
+
+pl_bool_t plss_is_empty( plcm_t plcm )
+{
+    return ( plcm_used( plcm ) == 0 );
+}
+
+
+
+/* ------------------------------------------------------------
+ * String Referencing:
+ */
+
+plsr_s plsr_from_plcm( plcm_t plcm )
+{
+    plsr_s ret;
+    ret.string = plcm_data( plcm );
+    ret.length = plcm_used( plcm );
+    return ret;
+}
+
+
+plsr_s plsr_from_string( const char* str )
+{
+    plsr_s ret;
+    ret.string = str;
+    if ( str ) {
+        ret.length = strlen( str );
+    } else {
+        ret.length = 0;
+    }
+    return ret;
+}
+
+
+plsr_s plsr_from_string_and_length( const char* str, pl_size_t length )
+{
+    plsr_s ret;
+    ret.string = str;
+    ret.length = length;
+    return ret;
+}
+
+
+const char* plsr_string( plsr_s plsr )
+{
+    return plsr.string;
+}
+
+
+pl_size_t plsr_length( plsr_s plsr )
+{
+    return plsr.length;
+}
+
+
+pl_bool_t plsr_compare( plsr_s p1, plsr_s p2 )
+{
+    if ( p1.length != p2.length ) {
+        return pl_false;
+    } else {
+        if ( !memcmp( p1.string, p2.string, p1.length ) ) {
+            return pl_true;
+        } else {
+            return pl_false;
+        }
+    }
+}
+
+
+pl_bool_t plsr_compare_n( plsr_s p1, plsr_s p2, pl_size_t n )
+{
+    if ( ( p1.length < n ) || ( p2.length < n ) ) {
+        return pl_false;
+    } else {
+        if ( !memcmp( p1.string, p2.string, n ) ) {
+            return pl_true;
+        } else {
+            return pl_false;
+        }
+    }
+}
+
+
+plsr_s plsr_null( pl_none )
+{
+    plsr_s ret;
+    ret.string = NULL;
+    ret.length = 0;
+    return ret;
+}
+
+
+pl_bool_t plsr_is_null( plsr_s plsr )
+{
+    return ( plsr.string == NULL );
+}
+
+
+pl_bool_t plsr_is_empty( plsr_s plsr )
+{
+    if ( ( plsr.string != NULL ) && plsr.length == 0 ) {
+        return pl_true;
+    } else {
+        return pl_false;
+    }
+}
+
+
+plsr_s plsr_next_line( plsr_s plsr, pl_size_p offset )
+{
+    pl_size_t   index;
+    pl_size_t   length;
+    const char* string;
+
+    /* Find next newline or eof. */
+    string = plsr_string( plsr );
+    length = plsr_length( plsr );
+    index = *offset;
+
+    if ( index >= length ) {
+        return plsr_null();
+    }
+
+    while ( ( index < length ) && ( string[ index ] != '\n' ) ) {
+        index++;
+    }
+
+    plsr_s ret;
+
+    ret.length = index - *offset;
+    ret.string = &string[ *offset ];
+
+    if ( index < length ) {
+        index++;
+    }
+
+    *offset = index;
+
+    return ret;
+}
+
+
+char plsr_index( plsr_s plsr, pl_pos_t index )
+{
+    if ( index <= plsr.length ) {
+        return plsr.string[ index ];
+    } else {
+        return 0;
+    }
+}
+
+
+plsr_s plsr_range( plsr_s plsr, pl_size_t start, pl_size_t end )
+{
+    plsr_s ret;
+    ret.length = end - start;
+    ret.string = &plsr.string[ start ];
+    return ret;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Universal Interface:
+ */
+
+pl_none plui_init( plui_t ui, pl_t env, plui_fn_t fun )
+{
+    ui->env = env;
+    ui->fun = fun;
+}
+
+
+pl_none plui_do( plui_t ui, pl_t argi, pl_t argo )
+{
+    ui->fun( ui->env, argi, argo );
+}
+
+
+
+/* ------------------------------------------------------------
+ * Array:
+ */
+
+plar_s plar_init( pl_t data, pl_size_t step, pl_size_t size )
+{
+    return (plar_s){ data, step, size };
+}
+
+
+pl_t plar_get( plar_s plar, pl_size_t index )
+{
+    return ( plar.data + ( index * plar.step ) );
+}
+
+
+pl_none plar_set( plar_s plar, pl_size_t index, pl_size_t count, pl_t data )
+{
+    memcpy( plar.data + ( index * plar.step ), data, count * plar.step );
+}
+
+
+plar_s plar_insert( plar_s plar, pl_size_t index, pl_size_t count, pl_t data )
+{
+    /*
+     *        === c
+     *     ++++++++   ->   +++===+++++
+     *        i               i
+     */
+    memmove( plar.data + ( ( index + count ) * plar.step ),
+             plar.data + ( index * plar.step ),
+             ( plar.size - index ) * plar.step );
+
+    plar_set( plar, index, count, data );
+
+    plar.size += count;
+
+    return plar;
+}
+
+
+plar_s plar_remove( plar_s plar, pl_size_t index, pl_size_t count )
+{
+    /*
+     *        .-. c
+     *     +++---+++++   ->   ++++++++
+     *        i                  i
+     */
+    memmove( plar.data + ( index * plar.step ),
+             plar.data + ( ( index + count ) * plar.step ),
+             ( plar.size - index - count ) * plar.step );
+
+    plar.size -= count;
+
+    return plar;
+}
+
+
+pl_size_t plar_size_of_slice( plar_s plar, pl_size_t count )
+{
+    return ( count * plar.step );
+}
+
+
+pl_size_t plar_size_in_bytes( plar_s plar )
+{
+    return ( plar.size * plar.step );
+}
+
+
+pl_t plar_data( plar_s plar )
+{
+    return plar.data;
+}
+
+
+pl_size_t plar_step( plar_s plar )
+{
+    return plar.step;
+}
+
+
+pl_size_t plar_size( plar_s plar )
+{
+    return plar.size;
+}
+
+
+
+/* ------------------------------------------------------------
+ * List (singly-linked):
+ */
+
+plls_s plls_init( plbm_t plbm )
+{
+    return (plls_s){ plbm, NULL, NULL, 0 };
+}
+
+
+pl_none plls_append( plls_t plls, plls_node_p place, const pl_t data )
+{
+    plls_append_with_size(
+        plls, place, data, plbm_block_size( plls->host ) - plls_node_overhead() );
+}
+
+
+pl_none plls_append_with_size( plls_t plls, plls_node_p place, const pl_t data, pl_size_t size )
+{
+    plls_node_t node;
+
+    node = plbm_get( plls->host );
+    plls->size++;
+
+    if ( plls->head ) {
+
+        if ( *place == plls->tail ) {
+
+            /*
+              Append to list end.
+                                      ,place
+                  +---+    +---+    +---+
+                  |   |--->|   |--->|   |--->
+                  +---+    +---+    +---+    |
+                                            ---
+             */
+            node->next = NULL;
+            plls->tail->next = node;
+            plls->tail = node;
+
+        } else {
+
+            /*
+
+              Append after place.
+                             ,place
+                  +---+    +---+    +---+
+                  |   |--->|   |--->|   |--->
+                  +---+    +---+    +---+    |
+                                            ---
+             */
+            node->next = ( *place )->next;
+            ( *place )->next = node;
+        }
+
+    } else {
+        node->next = NULL;
+        plls->head = node;
+        plls->tail = node;
+    }
+
+    memcpy( node->data, data, size );
+}
+
+
+pl_none plls_insert( plls_t plls, plls_node_p place, const pl_t data )
+{
+    plls_insert_with_size(
+        plls, place, data, plbm_block_size( plls->host ) - plls_node_overhead() );
+}
+
+
+pl_none plls_insert_with_size( plls_t plls, plls_node_p place, const pl_t data, pl_size_t size )
+{
+    plls_node_t node;
+
+    node = plbm_get( plls->host );
+    plls->size++;
+
+    if ( plls->head ) {
+
+        if ( *place == plls->head ) {
+
+            /*
+              Insert to list head.
+                    ,place
+                  +---+    +---+    +---+
+                  |   |--->|   |--->|   |--->
+                  +---+    +---+    +---+    |
+                                            ---
+             */
+            node->next = plls->head;
+            plls->head = node;
+
+        } else {
+
+            /*
+
+              Insert in place.
+                             ,place
+                  +---+    +---+    +---+
+                  |   |--->|   |--->|   |--->
+                  +---+    +---+    +---+    |
+                                            ---
+             */
+            node->next = *place;
+            *place = node;
+        }
+
+    } else {
+        node->next = NULL;
+        plls->head = node;
+        plls->tail = node;
+    }
+
+    memcpy( node->data, data, size );
+}
+
+
+plls_node_p plls_remove( plls_t plls, plls_node_p place )
+{
+    if ( plls->head && place ) {
+
+        plls_node_t node;
+
+        /* NOTE: plbm_put overwrites the node content. Therefore we
+           must first re-arrange plls_node next and prev pointers, and
+           only after this, we put back the block to plbm. */
+
+        plls->size--;
+
+        if ( *place == plls->head ) {
+
+            if ( ( *place )->next == NULL ) {
+
+                /* Remove the only node. */
+                node = *place;
+                plls->head = NULL;
+                plls->tail = NULL;
+                plbm_put( plls->host, node );
+                return NULL;
+
+            } else {
+
+                /* Remove the head node. */
+                node = plls->head;
+                plls->head = plls->head->next;
+                plbm_put( plls->host, node );
+                return &plls->head;
+            }
+
+        } else if ( *place == plls->tail ) {
+
+            /* Remove tail node. */
+            plls_node_p ret;
+
+            node = plls->head;
+            while ( node->next->next ) {
+                node = node->next;
+            }
+
+            /* NOTE: This assignment requires that "next" is the first
+               element in the plls_node struct. */
+            plls->tail = node;
+            ret = &node;
+            node = node->next;
+            plls->tail->next = NULL;
+            plbm_put( plls->host, node );
+            return ret;
+
+        } else {
+
+            /*
+              Remove node in the middle (or head).
+                             ,place
+                  +---+    +---+    +---+
+                  |   |--->|   |--->|   |--->
+                  +---+    +---+    +---+    |
+                                            ---
+             */
+            node = *place;
+            *place = node->next;
+            plbm_put( plls->host, node );
+            return place;
+        }
+
+    } else {
+
+        return NULL;
+    }
+}
+
+
+pl_none plls_store( plls_t plls, const pl_t data )
+{
+
+    plls_store_with_size( plls, data, plbm_block_size( plls->host ) - plls_node_overhead() );
+}
+
+
+pl_none plls_store_with_size( plls_t plls, const pl_t data, pl_size_t size )
+{
+    plls_append_with_size( plls, &plls->tail, data, size );
+}
+
+
+pl_none plls_push( plls_t plls, const pl_t data )
+{
+    plls_insert_with_size(
+        plls, plls_head( plls ), data, plbm_block_size( plls->host ) - plls_node_overhead() );
+}
+
+
+plls_node_t plls_pop( plls_t plls )
+{
+    plls_node_t ret;
+    ret = plls->head;
+    plls_remove( plls, plls_head( plls ) );
+    return ret;
+}
+
+
+pl_size_t plls_node_overhead( void )
+{
+    return sizeof( plls_node_s );
+}
+
+
+pl_t plls_node_data( plls_node_t node )
+{
+    if ( node ) {
+        return node->data;
+    } else {
+        return NULL;
+    }
+}
+
+
+plls_node_p plls_node_next( plls_node_p node )
+{
+    if ( *node ) {
+        return &( ( *node )->next );
+    } else {
+        return NULL;
+    }
+}
+
+
+pl_bool_t plls_node_at_start( plls_node_t node, plls_t plls )
+{
+    if ( node && node == plls->head ) {
+        return pl_true;
+    } else {
+        return pl_false;
+    }
+}
+
+
+pl_bool_t plls_node_at_end( plls_node_t node, plls_t plls )
+{
+    if ( node && node == plls->tail ) {
+        return pl_true;
+    } else {
+        return pl_false;
+    }
+}
+
+
+plbm_t plls_host( plls_t plls )
+{
+    return plls->host;
+}
+
+
+plls_node_p plls_head( plls_t plls )
+{
+    return &plls->head;
+}
+
+
+plls_node_p plls_tail( plls_t plls )
+{
+    return &plls->tail;
+}
+
+
+plls_node_p plls_index( plls_t plls, pl_size_t index )
+{
+    plls_node_p node;
+    pl_size_t   i;
+
+    if ( index == 0 || !plls->head ) {
+        return &plls->head;
+    }
+
+    node = &plls->head;
+    i = 0;
+    while ( i < index && ( *node )->next ) {
+        node = &( ( *node )->next );
+        i++;
     }
 
-    return plcm;
+    return node;
+}
+
+
+pl_size_t plls_size( plls_t plls )
+{
+    return plls->size;
+}
+
+
+pl_none plls_clear( plls_t plls )
+{
+    if ( plls->head ) {
+        /* NOTE: Node chain is a Block chain, since "next" is the
+           first element in the plls_node struct. */
+        plbm_put_chain( plls->host, plls->head, plls->tail );
+    }
+    plls->head = NULL;
+    plls->tail = NULL;
+    plls->size = 0;
+}
+
+
+
+/* ------------------------------------------------------------
+ * List (doubly-linked):
+ */
+
+plld_s plld_init( plbm_t plbm )
+{
+    return (plld_s){ plbm, NULL, NULL, 0 };
+}
+
+
+pl_none plld_append( plld_t plld, plld_node_t place, const pl_t data )
+{
+    plld_append_with_size(
+        plld, place, data, plbm_block_size( plld->host ) - plld_node_overhead() );
+}
+
+
+pl_none plld_append_with_size( plld_t plld, plld_node_t place, const pl_t data, pl_size_t size )
+{
+    plld_node_t node;
+
+    node = plbm_get( plld->host );
+    plld->size++;
+
+    if ( plld->head ) {
+
+        if ( place == plld->tail ) {
+
+            /*
+              Append to list end.
+                                      ,place
+                  +---+    +---+    +---+
+                  |   |--->|   |--->|   |--->
+                  +---+    +---+    +---+    |
+                                            ---
+             */
+            node->prev = plld->tail;
+            node->next = NULL;
+            plld->tail->next = node;
+            plld->tail = node;
+
+        } else {
+
+            /*
+
+              Append after place.
+                             ,place
+                  +---+    +---+    +---+
+                  |   |--->|   |--->|   |--->
+                  +---+    +---+    +---+    |
+                                            ---
+             */
+            node->prev = place;
+            node->next = place->next;
+            place->next = node;
+            node->next->prev = node;
+        }
+    } else {
+        node->prev = NULL;
+        node->next = NULL;
+        plld->head = node;
+        plld->tail = node;
+    }
+
+    memcpy( node->data, data, size );
+}
+
+
+pl_none plld_insert( plld_t plld, plld_node_t place, const pl_t data )
+{
+    plld_insert_with_size(
+        plld, place, data, plbm_block_size( plld->host ) - plld_node_overhead() );
+}
+
+
+pl_none plld_insert_with_size( plld_t plld, plld_node_t place, const pl_t data, pl_size_t size )
+{
+    plld_node_t node;
+
+    node = plbm_get( plld->host );
+    plld->size++;
+
+    if ( plld->head ) {
+
+        if ( place == plld->head ) {
+
+            /*
+              Insert to list start.
+                    ,place
+                  +---+    +---+    +---+
+                  |   |--->|   |--->|   |--->
+                  +---+    +---+    +---+    |
+                                            ---
+             */
+            node->prev = NULL;
+            node->next = place;
+            place->prev = node;
+            plld->head = node;
+
+        } else {
+
+            /*
+              Insert before place.
+                             ,place
+                  +---+    +---+    +---+
+                  |   |--->|   |--->|   |--->
+                  +---+    +---+    +---+    |
+                                            ---
+             */
+            node->prev = place->prev;
+            node->next = place;
+            place->prev->next = node;
+            place->prev = node;
+        }
+    } else {
+        node->prev = NULL;
+        node->next = NULL;
+        plld->head = node;
+        plld->tail = node;
+    }
+
+    memcpy( node->data, data, size );
+}
+
+
+plld_node_t plld_remove( plld_t plld, plld_node_t place )
+{
+    if ( plld->head && place ) {
+
+        /* NOTE: plbm_put overwrites the node content. Therefore we
+           must first re-arrange plld_node next and prev pointers, and
+           only after this, we put back the block to plbm. */
+
+        plld->size--;
+
+        if ( place->prev == NULL && place->next == NULL ) {
+
+            /* Remove the only node. */
+            plld->head = NULL;
+            plld->tail = NULL;
+            plbm_put( plld->host, place );
+            return NULL;
+
+        } else if ( place == plld->head ) {
+
+            /* Remove head node. */
+            place->next->prev = NULL;
+            plld->head = place->next;
+            plbm_put( plld->host, place );
+            return plld->head;
+
+        } else if ( place == plld->tail ) {
+
+            /* Remove tail node. */
+            plld->tail = place->prev;
+            plld->tail->next = NULL;
+            plbm_put( plld->host, place );
+            return plld->tail;
+
+        } else {
+
+            /*
+              Remove node in the middle.
+                             ,place
+                  +---+    +---+    +---+
+                  |   |--->|   |--->|   |--->
+                  +---+    +---+    +---+    |
+                                            ---
+             */
+            place->next->prev = place->prev;
+            place->prev->next = place->next;
+            plbm_put( plld->host, place );
+            return place->next;
+        }
+
+    } else {
+
+        return NULL;
+    }
+}
+
+
+pl_none plld_store( plld_t plld, const pl_t data )
+{
+    plld_store_with_size( plld, data, plbm_block_size( plld->host ) - plld_node_overhead() );
+}
+
+
+pl_none plld_store_with_size( plld_t plld, const pl_t data, pl_size_t size )
+{
+    plld_append_with_size( plld, plld->tail, data, size );
+}
+
+
+pl_size_t plld_node_overhead( void )
+{
+    return sizeof( plld_node_s );
+}
+
+
+pl_t plld_node_data( plld_node_t node )
+{
+    if ( node ) {
+        return node->data;
+    } else {
+        return NULL;
+    }
+}
+
+
+plld_node_t plld_node_next( plld_node_t node )
+{
+    if ( node ) {
+        return node->next;
+    } else {
+        return NULL;
+    }
+}
+
+
+plld_node_t plld_node_prev( plld_node_t node )
+{
+    if ( node ) {
+        return node->prev;
+    } else {
+        return NULL;
+    }
+}
+
+
+pl_bool_t plld_node_at_start( plld_node_t node )
+{
+    if ( node && node->prev == NULL ) {
+        return pl_true;
+    } else {
+        return pl_false;
+    }
 }
 
 
-plcm_t plss_write_file( plcm_t plcm, const char* filename )
+pl_bool_t plld_node_at_end( plld_node_t node )
 {
-    int fd;
-
-    if ( filename ) {
-        fd = creat( filename, 0666 );
-        if ( fd == -1 ) {
-            return NULL; /* GCOV_EXCL_LINE */
-        }
-        write( fd, plss_string( plcm ), plss_length( plcm ) );
-        close( fd );
+    if ( node && node->next == NULL ) {
+        return pl_true;
     } else {
-        /* GCOV_EXCL_START */
-        fd = STDOUT_FILENO;
-        write( fd, plss_string( plcm ), plss_length( plcm ) );
-        /* GCOV_EXCL_STOP */
+        return pl_false;
     }
+}
 
-    return plcm;
+
+plbm_t plld_host( plld_t plld )
+{
+    return plld->host;
 }
 
 
-pl_size_t plss_write_to( plsr_s plsr, FILE* fh )
+plld_node_t plld_head( plld_t plld )
 {
-    return (pl_size_t)fwrite( plsr_string( plsr ), 1, plsr_length( plsr ), fh );
+    return plld->head;
 }
 
 
-const char* plss_string( plcm_t plcm )
+plld_node_t plld_tail( plld_t plld )
 {
-    return (const char*)plcm_ref( plcm, 0 );
+    return plld->tail;
 }
 
 
-pl_size_t plss_length( plcm_t plcm )
+plld_node_t plld_index( plld_t plld, pl_size_t index )
 {
-    return plcm_used( plcm );
+    plld_node_t node;
+    pl_size_t   i;
+
+    if ( index == 0 || !plld->head ) {
+        return plld->head;
+    }
+
+    node = plld->head;
+    i = 1;
+    while ( i < index && node->next ) {
+        node = node->next;
+        i++;
+    }
+
+    return node->next;
 }
 
 
-plsr_s plss_ref( plcm_t plcm )
+pl_size_t plld_size( plld_t plld )
 {
-    plsr_s ret;
-    ret.string = (char*)plss_string( plcm );
-    ret.length = plss_length( plcm );
-    return ret;
+    return plld->size;
 }
 
 
-pl_bool_t plss_is_empty( plcm_t plcm )
+pl_none plld_clear( plld_t plld )
 {
-    return ( plcm_used( plcm ) == 0 );
+    if ( plld->head ) {
+        /* Link nodes through the first element for plbm. */
+        for ( plld_node_t node = plld->head; node; node = node->next ) {
+            *( (pl_t*)node ) = node->next;
+        }
+        plbm_put_chain( plld->host, plld->head, plld->tail );
+    }
+    plld->head = NULL;
+    plld->tail = NULL;
+    plld->size = 0;
 }
 
 
 
 /* ------------------------------------------------------------
- * String Referencing:
+ * List (doubly-linked with handles):
  */
 
-plsr_s plsr_from_plcm( plcm_t plcm )
+static pllh_node_t pllh__node( pllh_t pllh, pl_bh_t node )
 {
-    plsr_s ret;
-    ret.string = plcm_data( plcm );
-    ret.length = plcm_used( plcm );
-    return ret;
+    return plbh_ref( pllh->host, node );
 }
 
 
-plsr_s plsr_from_string( const char* str )
+pllh_s pllh_init( plbh_t plbh )
 {
-    plsr_s ret;
-    ret.string = str;
-    if ( str ) {
-        ret.length = strlen( str );
-    } else {
-        ret.length = 0;
-    }
-    return ret;
+    return (pllh_s){ plbh, 0, 0, 0 };
 }
 
 
-plsr_s plsr_from_string_and_length( const char* str, pl_size_t length )
+pl_none pllh_append( pllh_t pllh, pl_bh_t place, const pl_t data )
 {
-    plsr_s ret;
-    ret.string = str;
-    ret.length = length;
-    return ret;
+    pllh_append_with_size(
+        pllh, place, data, plbh_block_size( pllh->host ) - pllh_node_overhead() );
 }
 
 
-const char* plsr_string( plsr_s plsr )
+pl_none pllh_append_with_size( pllh_t pllh, pl_bh_t place, const pl_t data, pl_size_t size )
 {
-    return plsr.string;
+    pl_bh_t     handle;
+    pllh_node_t node;
+
+    handle = plbh_get( pllh->host );
+    node = pllh__node( pllh, handle );
+    pllh->size++;
+
+    if ( pllh->head ) {
+        node->prev = place;
+        node->next = pllh__node( pllh, place )->next;
+        pllh__node( pllh, place )->next = handle;
+        if ( place == pllh->tail ) {
+            pllh->tail = handle;
+        } else {
+            pllh__node( pllh, node->next )->prev = handle;
+        }
+    } else {
+        node->prev = 0;
+        node->next = 0;
+        pllh->head = handle;
+        pllh->tail = handle;
+    }
+
+    memcpy( node->data, data, size );
 }
 
 
-pl_size_t plsr_length( plsr_s plsr )
+pl_none pllh_insert( pllh_t pllh, pl_bh_t place, const pl_t data )
 {
-    return plsr.length;
+    pllh_insert_with_size(
+        pllh, place, data, plbh_block_size( pllh->host ) - pllh_node_overhead() );
 }
 
 
-pl_bool_t plsr_compare( plsr_s p1, plsr_s p2 )
+pl_none pllh_insert_with_size( pllh_t pllh, pl_bh_t place, const pl_t data, pl_size_t size )
 {
-    if ( p1.length != p2.length ) {
-        return pl_false;
-    } else {
-        if ( !memcmp( p1.string, p2.string, p1.length ) ) {
-            return pl_true;
+    pl_bh_t     handle;
+    pllh_node_t node;
+
+    handle = plbh_get( pllh->host );
+    node = pllh__node( pllh, handle );
+    pllh->size++;
+
+    if ( pllh->head ) {
+        node->prev = pllh__node( pllh, place )->prev;
+        node->next = place;
+        pllh__node( pllh, place )->prev = handle;
+        if ( place == pllh->head ) {
+            pllh->head = handle;
         } else {
-            return pl_false;
+            pllh__node( pllh, node->prev )->next = handle;
         }
+    } else {
+        node->prev = 0;
+        node->next = 0;
+        pllh->head = handle;
+        pllh->tail = handle;
     }
+
+    memcpy( node->data, data, size );
 }
 
 
-pl_bool_t plsr_compare_n( plsr_s p1, plsr_s p2, pl_size_t n )
+pl_bh_t pllh_remove( pllh_t pllh, pl_bh_t place )
 {
-    if ( ( p1.length < n ) || ( p2.length < n ) ) {
-        return pl_false;
+    pllh_node_t node;
+    pl_bh_t     next;
+
+    if ( pllh->head == 0 || place == 0 ) {
+        return 0;
+    }
+
+    /* NOTE: plbh_put overwrites the node content, hence links are
+       taken first. */
+
+    pllh->size--;
+    node = pllh__node( pllh, place );
+    next = node->next;
+
+    if ( node->prev ) {
+        pllh__node( pllh, node->prev )->next = node->next;
     } else {
-        if ( !memcmp( p1.string, p2.string, n ) ) {
-            return pl_true;
-        } else {
-            return pl_false;
-        }
+        pllh->head = node->next;
     }
-}
 
+    if ( node->next ) {
+        pllh__node( pllh, node->next )->prev = node->prev;
+    } else {
+        pllh->tail = node->prev;
+        next = node->prev;
+    }
 
-plsr_s plsr_null( pl_none )
-{
-    plsr_s ret;
-    ret.string = NULL;
-    ret.length = 0;
-    return ret;
+    plbh_put( pllh->host, place );
+
+    return next;
 }
 
 
-pl_bool_t plsr_is_null( plsr_s plsr )
+pl_none pllh_store( pllh_t pllh, const pl_t data )
 {
-    return ( plsr.string == NULL );
+    pllh_store_with_size( pllh, data, plbh_block_size( pllh->host ) - pllh_node_overhead() );
 }
 
 
-pl_bool_t plsr_is_empty( plsr_s plsr )
+pl_none pllh_store_with_size( pllh_t pllh, const pl_t data, pl_size_t size )
 {
-    if ( ( plsr.string != NULL ) && plsr.length == 0 ) {
-        return pl_true;
-    } else {
-        return pl_false;
-    }
+    pllh_append_with_size( pllh, pllh->tail, data, size );
 }
 
 
-plsr_s plsr_next_line( plsr_s plsr, pl_size_p offset )
+pl_size_t pllh_node_overhead( void )
 {
-    pl_size_t   index;
-    pl_size_t   length;
-    const char* string;
-
-    /* Find next newline or eof. */
-    string = plsr_string( plsr );
-    length = plsr_length( plsr );
-    index = *offset;
+    return sizeof( pllh_node_s );
+}
 
-    if ( index >= length ) {
-        return plsr_null();
-    }
 
-    while ( ( index < length ) && ( string[ index ] != '\n' ) ) {
-        index++;
+pl_t pllh_node_data( pllh_t pllh, pl_bh_t node )
+{
+    if ( node ) {
+        return pllh__node( pllh, node )->data;
+    } else {
+        return NULL;
     }
+}
 
-    plsr_s ret;
-
-    ret.length = index - *offset;
-    ret.string = &string[ *offset ];
 
-    if ( index < length ) {
-        index++;
+pl_bh_t pllh_node_next( pllh_t pllh, pl_bh_t node )
+{
+    if ( node ) {
+        return pllh__node( pllh, node )->next;
+    } else {
+        return 0;
     }
-
-    *offset = index;
-
-    return ret;
 }
 
 
-char plsr_index( plsr_s plsr, pl_pos_t index )
+pl_bh_t pllh_node_prev( pllh_t pllh, pl_bh_t node )
 {
-    if ( index <= plsr.length ) {
-        return plsr.string[ index ];
+    if ( node ) {
+        return pllh__node( pllh, node )->prev;
     } else {
         return 0;
     }
 }
 
 
-plsr_s plsr_range( plsr_s plsr, pl_size_t start, pl_size_t end )
+pl_bh_t pllh_head( pllh_t pllh )
 {
-    plsr_s ret;
-    ret.length = end - start;
-    ret.string = &plsr.string[ start ];
-    return ret;
+    return pllh->head;
 }
 
 
+pl_bh_t pllh_tail( pllh_t pllh )
+{
+    return pllh->tail;
+}
 
-/* ------------------------------------------------------------
- * Universal Interface:
- */
 
-pl_none plui_init( plui_t ui, pl_t env, plui_fn_t fun )
+pl_size_t pllh_size( pllh_t pllh )
 {
-    ui->env = env;
-    ui->fun = fun;
+    return pllh->size;
 }
 
 
-pl_none plui_do( plui_t ui, pl_t argi, pl_t argo )
+pl_none pllh_clear( pllh_t pllh )
 {
-    ui->fun( ui->env, argi, argo );
+    pl_bh_t node;
+    pl_bh_t next;
+
+    for ( node = pllh->head; node; node = next ) {
+        next = pllh__node( pllh, node )->next;
+        plbh_put( pllh->host, node );
+    }
+    pllh->head = 0;
+    pllh->tail = 0;
+    pllh->size = 0;
 }
 
 
 
 /* ------------------------------------------------------------
- * Array:
+ * List (unrolled):
  */
 
-plar_s plar_init( pl_t data, pl_size_t step, pl_size_t size )
+pllu_s pllu_init( plbm_t plbm, pl_size_t capa )
 {
-    return (plar_s){ data, step, size };
+    return (pllu_s){ plbm, NULL, NULL, 0, capa };
 }
 
 
-pl_t plar_get( plar_s plar, pl_size_t index )
+pl_none pllu_store( pllu_t pllu, const pl_t data, pl_size_t size )
 {
-    return ( plar.data + ( index * plar.step ) );
-}
+    pllu_node_t node;
+    pl_size_t   done;
+    pl_size_t   left;
+    pl_size_t   blop;
+    pl_size_t   tail;
 
+    done = 0;
+    left = size;
 
-pl_none plar_set( plar_s plar, pl_size_t index, pl_size_t count, pl_t data )
-{
-    memcpy( plar.data + ( index * plar.step ), data, count * plar.step );
-}
+    while ( done < size ) {
 
+        /* Allocate a node if no nodes, or if the current is full. */
 
-plar_s plar_insert( plar_s plar, pl_size_t index, pl_size_t count, pl_t data )
-{
-    /*
-     *        === c
-     *     ++++++++   ->   +++===+++++
-     *        i               i
-     */
-    memmove( plar.data + ( ( index + count ) * plar.step ),
-             plar.data + ( index * plar.step ),
-             ( plar.size - index ) * plar.step );
+        if ( !pllu->head ) {
 
-    plar_set( plar, index, count, data );
+            node = plbm_get( pllu->host );
+            node->prev = NULL;
+            node->next = NULL;
+            node->used = 0;
+            pllu->head = node;
+            pllu->tail = node;
 
-    plar.size += count;
+        } else if ( pllu->tail->used >= pllu->capa ) {
 
-    return plar;
-}
+            node = plbm_get( pllu->host );
+            node->prev = pllu->tail;
+            node->next = NULL;
+            node->used = 0;
+            pllu->tail->next = node;
+            pllu->tail = node;
 
+        } else {
 
-plar_s plar_remove( plar_s plar, pl_size_t index, pl_size_t count )
-{
-    /*
-     *        .-. c
-     *     +++---+++++   ->   ++++++++
-     *        i                  i
-     */
-    memmove( plar.data + ( index * plar.step ),
-             plar.data + ( ( index + count ) * plar.step ),
-             ( plar.size - index - count ) * plar.step );
+            node = pllu->tail;
+        }
 
-    plar.size -= count;
+        tail = pllu->capa - node->used;
+        if ( left > tail ) {
+            blop = tail;
+        } else {
+            blop = left;
+        }
 
-    return plar;
+        memcpy( node->data + node->used, data + done, blop );
+        node->used += blop;
+        pllu->size += blop;
+        done += blop;
+        left -= blop;
+    }
 }
 
 
-pl_size_t plar_size_of_slice( plar_s plar, pl_size_t count )
+pl_size_t pllu_node_overhead( void )
 {
-    return ( count * plar.step );
+    return sizeof( pllu_node_s );
 }
 
 
-pl_size_t plar_size_in_bytes( plar_s plar )
+pllu_cursor_s pllu_cursor_init( pllu_t pllu )
 {
-    return ( plar.size * plar.step );
+    return (pllu_cursor_s){ pllu, pllu->head, 0 };
 }
 
 
-pl_t plar_data( plar_s plar )
+pllu_cursor_s pllu_cursor_init_to_end( pllu_t pllu )
 {
-    return plar.data;
+    return (pllu_cursor_s){ pllu, pllu->tail, pllu->tail->used };
 }
 
 
-pl_size_t plar_step( plar_s plar )
+pllu_node_t pllu_cursor_node( pllu_cursor_t cursor )
 {
-    return plar.step;
+    return cursor->node;
 }
 
 
-pl_size_t plar_size( plar_s plar )
+pl_t pllu_cursor_data( pllu_cursor_t cursor, pl_size_p size )
 {
-    return plar.size;
+    *size = cursor->node->used;
+    return cursor->node->data;
 }
 
 
-
-/* ------------------------------------------------------------
- * List (singly-linked):
- */
-
-plls_s plls_init( plbm_t plbm )
+pl_size_t pllu_cursor_used( pllu_cursor_t cursor )
 {
-    return (plls_s){ plbm, NULL, NULL, 0 };
+    return cursor->node->used;
 }
 
 
-pl_none plls_append( plls_t plls, plls_node_p place, const pl_t data )
+pl_none pllu_cursor_next( pllu_cursor_t cursor )
 {
-    plls_append_with_size(
-        plls, place, data, plbm_block_size( plls->host ) - plls_node_overhead() );
+    cursor->node = cursor->node->next;
 }
 
 
-pl_none plls_append_with_size( plls_t plls, plls_node_p place, const pl_t data, pl_size_t size )
+pl_none pllu_cursor_prev( pllu_cursor_t cursor )
 {
-    plls_node_t node;
-
-    node = plbm_get( plls->host );
-    plls->size++;
+    cursor->node = cursor->node->prev;
+}
 
-    if ( plls->head ) {
 
-        if ( *place == plls->tail ) {
+pl_t pllu_cursor_data_step( pllu_cursor_t cursor, pl_size_p size )
+{
+    pl_t ret;
+    ret = pllu_cursor_data( cursor, size );
+    pllu_cursor_next( cursor );
+    return ret;
+}
 
-            /*
-              Append to list end.
-                                      ,place
-                  +---+    +---+    +---+
-                  |   |--->|   |--->|   |--->
-                  +---+    +---+    +---+    |
-                                            ---
-             */
-            node->next = NULL;
-            plls->tail->next = node;
-            plls->tail = node;
 
-        } else {
+pl_t pllu_cursor_item( pllu_cursor_t cursor )
+{
+    return cursor->node->data + cursor->spot;
+}
 
-            /*
 
-              Append after place.
-                             ,place
-                  +---+    +---+    +---+
-                  |   |--->|   |--->|   |--->
-                  +---+    +---+    +---+    |
-                                            ---
-             */
-            node->next = ( *place )->next;
-            ( *place )->next = node;
-        }
+pl_none pllu_cursor_next_item( pllu_cursor_t cursor, pl_size_t step )
+{
+    pl_size_t tail;
 
+    tail = cursor->node->used - cursor->spot;
+    if ( step < tail ) {
+        cursor->spot += step;
+    } else if ( cursor->node->next ) {
+        tail = step - tail;
+        cursor->node = cursor->node->next;
+        cursor->spot = tail;
     } else {
-        node->next = NULL;
-        plls->head = node;
-        plls->tail = node;
+        cursor->node = NULL;
     }
-
-    memcpy( node->data, data, size );
 }
 
 
-pl_none plls_insert( plls_t plls, plls_node_p place, const pl_t data )
+pl_none pllu_cursor_prev_item( pllu_cursor_t cursor, pl_size_t step )
 {
-    plls_insert_with_size(
-        plls, place, data, plbm_block_size( plls->host ) - plls_node_overhead() );
+    if ( cursor->spot >= step ) {
+        cursor->spot -= step;
+    } else if ( cursor->node->prev ) {
+        pl_size_t tail;
+        tail = step - cursor->spot;
+        cursor->node = cursor->node->prev;
+        cursor->spot = cursor->node->used - tail;
+    } else {
+        cursor->node = NULL;
+    }
 }
 
 
-pl_none plls_insert_with_size( plls_t plls, plls_node_p place, const pl_t data, pl_size_t size )
+pl_t pllu_cursor_item_step( pllu_cursor_t cursor, pl_size_t step )
 {
-    plls_node_t node;
-
-    node = plbm_get( plls->host );
-    plls->size++;
-
-    if ( plls->head ) {
-
-        if ( *place == plls->head ) {
-
-            /*
-              Insert to list head.
-                    ,place
-                  +---+    +---+    +---+
-                  |   |--->|   |--->|   |--->
-                  +---+    +---+    +---+    |
-                                            ---
-             */
-            node->next = plls->head;
-            plls->head = node;
-
-        } else {
-
-            /*
-
-              Insert in place.
-                             ,place
-                  +---+    +---+    +---+
-                  |   |--->|   |--->|   |--->
-                  +---+    +---+    +---+    |
-                                            ---
-             */
-            node->next = *place;
-            *place = node;
-        }
+    pl_t ret;
+    ret = pllu_cursor_item( cursor );
+    pllu_cursor_next_item( cursor, step );
+    return ret;
+}
 
-    } else {
-        node->next = NULL;
-        plls->head = node;
-        plls->tail = node;
-    }
 
-    memcpy( node->data, data, size );
+plbm_t pllu_host( pllu_t pllu )
+{
+    return pllu->host;
 }
 
 
-plls_node_p plls_remove( plls_t plls, plls_node_p place )
+pllu_node_t pllu_head( pllu_t pllu )
 {
-    if ( plls->head && place ) {
+    return pllu->head;
+}
 
-        plls_node_t node;
 
-        /* NOTE: plbm_put overwrites the node content. Therefore we
-           must first re-arrange plls_node next and prev pointers, and
-           only after this, we put back the block to plbm. */
+pllu_node_t pllu_tail( pllu_t pllu )
+{
+    return pllu->tail;
+}
 
-        plls->size--;
 
-        if ( *place == plls->head ) {
+pl_size_t pllu_size( pllu_t pllu )
+{
+    return pllu->size;
+}
 
-            if ( ( *place )->next == NULL ) {
 
-                /* Remove the only node. */
-                node = *place;
-                plls->head = NULL;
-                plls->tail = NULL;
-                plbm_put( plls->host, node );
-                return NULL;
+pl_size_t pllu_capa( pllu_t pllu )
+{
+    return pllu->capa;
+}
 
-            } else {
 
-                /* Remove the head node. */
-                node = plls->head;
-                plls->head = plls->head->next;
-                plbm_put( plls->host, node );
-                return &plls->head;
-            }
+pl_none pllu_clear( pllu_t pllu )
+{
+    if ( pllu->head ) {
+        /* Link nodes through the first element for plbm. */
+        for ( pllu_node_t node = pllu->head; node; node = node->next ) {
+            *( (pl_t*)node ) = node->next;
+        }
+        plbm_put_chain( pllu->host, pllu->head, pllu->tail );
+    }
+    pllu->head = NULL;
+    pllu->tail = NULL;
+    pllu->size = 0;
+}
 
-        } else if ( *place == plls->tail ) {
 
-            /* Remove tail node. */
-            plls_node_p ret;
 
-            node = plls->head;
-            while ( node->next->next ) {
-                node = node->next;
-            }
+/* ------------------------------------------------------------
+ * Slot Map:
+ */
 
-            /* NOTE: This assignment requires that "next" is the first
-               element in the plls_node struct. */
-            plls->tail = node;
-            ret = &node;
-            node = node->next;
-            plls->tail->next = NULL;
-            plbm_put( plls->host, node );
-            return ret;
+static plsm_slot_t plsm__slot( plsm_t plsm, pl_size_t index )
+{
+    return (plsm_slot_t)plcm_data( &plsm->slot ) + index;
+}
 
-        } else {
+static pl_u32_t* plsm__back( plsm_t plsm, pl_size_t index )
+{
+    return (pl_u32_t*)plcm_data( &plsm->back ) + index;
+}
 
-            /*
-              Remove node in the middle (or head).
-                             ,place
-                  +---+    +---+    +---+
-                  |   |--->|   |--->|   |--->
-                  +---+    +---+    +---+    |
-                                            ---
-             */
-            node = *place;
-            *place = node->next;
-            plbm_put( plls->host, node );
-            return place;
-        }
+/*
+ * Return slot of id, or NULL if id is stale.
+ */
+static plsm_slot_t plsm__find( plsm_t plsm, pl_id_t id )
+{
+    pl_size_t   index;
+    plsm_slot_t slot;
 
-    } else {
+    index = id & UINT32_MAX;
+    if ( index >= plcm_used_for_type( &plsm->slot, plsm_slot_s ) ) {
+        return NULL;
+    }
 
+    slot = plsm__slot( plsm, index );
+    if ( slot->gen != ( id >> 32 ) ) {
         return NULL;
     }
-}
 
+    return slot;
+}
 
-pl_none plls_store( plls_t plls, const pl_t data )
+static pl_none plsm__release( plsm_t plsm, pl_size_t index )
 {
+    plsm_slot_t slot;
 
-    plls_store_with_size( plls, data, plbm_block_size( plls->host ) - plls_node_overhead() );
+    slot = plsm__slot( plsm, index );
+    slot->gen++;
+    if ( slot->gen == 0 ) {
+        /* Zero generation is not used, hence zero id is invalid. */
+        slot->gen = 1;
+    }
+    slot->index = plsm->free;
+    plsm->free = index + 1;
 }
 
 
-pl_none plls_store_with_size( plls_t plls, const pl_t data, pl_size_t size )
+pl_none plsm_new( plsm_t plsm, pl_size_t isize )
 {
-    plls_append_with_size( plls, &plls->tail, data, size );
+    plcm_new( &plsm->data, 16 * isize );
+    plcm_new( &plsm->slot, 16 * sizeof( plsm_slot_s ) );
+    plcm_new( &plsm->back, 16 * sizeof( pl_u32_t ) );
+    plsm->free = 0;
+    plsm->isize = isize;
 }
 
 
-pl_none plls_push( plls_t plls, const pl_t data )
+pl_none plsm_del( plsm_t plsm )
 {
-    plls_insert_with_size(
-        plls, plls_head( plls ), data, plbm_block_size( plls->host ) - plls_node_overhead() );
+    plcm_del( &plsm->data );
+    plcm_del( &plsm->slot );
+    plcm_del( &plsm->back );
+    plsm->free = 0;
 }
 
 
-plls_node_t plls_pop( plls_t plls )
+pl_id_t plsm_insert( plsm_t plsm, const pl_t data )
 {
-    plls_node_t ret;
-    ret = plls->head;
-    plls_remove( plls, plls_head( plls ) );
-    return ret;
-}
+    pl_u32_t    index;
+    plsm_slot_t slot;
 
+    if ( plsm->free ) {
+        index = plsm->free - 1;
+        plsm->free = plsm__slot( plsm, index )->index;
+    } else {
+        plsm_slot_s init = { 0, 1 };
+        index = plcm_used_for_type( &plsm->slot, plsm_slot_s );
+        plcm_store_for_type( &plsm->slot, &init, plsm_slot_s );
+    }
 
-pl_size_t plls_node_overhead( void )
-{
-    return sizeof( plls_node_s );
+    slot = plsm__slot( plsm, index );
+    slot->index = plsm_size( plsm );
+    plcm_store( &plsm->data, data, plsm->isize );
+    plcm_store_for_type( &plsm->back, &index, pl_u32_t );
+
+    return ( (pl_id_t)slot->gen << 32 ) | index;
 }
 
 
-pl_t plls_node_data( plls_node_t node )
+pl_bool_t plsm_remove( plsm_t plsm, pl_id_t id )
 {
-    if ( node ) {
-        return node->data;
-    } else {
-        return NULL;
+    plsm_slot_t slot;
+    pl_size_t   last;
+
+    slot = plsm__find( plsm, id );
+    if ( slot == NULL ) {
+        return pl_false;
+    }
+
+    /* Move last item to the place of removed. */
+    last = plsm_size( plsm ) - 1;
+    if ( slot->index != last ) {
+        memcpy( plcm_data( &plsm->data ) + slot->index * plsm->isize,
+                plcm_data( &plsm->data ) + last * plsm->isize,
+                plsm->isize );
+        *plsm__back( plsm, slot->index ) = *plsm__back( plsm, last );
+        plsm__slot( plsm, *plsm__back( plsm, last ) )->index = slot->index;
     }
+    plcm_put( &plsm->data, plsm->isize );
+    plcm_put_for_type( &plsm->back, pl_u32_t );
+
+    plsm__release( plsm, id & UINT32_MAX );
+
+    return pl_true;
 }
 
 
-plls_node_p plls_node_next( plls_node_p node )
+pl_t plsm_ref( plsm_t plsm, pl_id_t id )
 {
-    if ( *node ) {
-        return &( ( *node )->next );
-    } else {
+    plsm_slot_t slot;
+
+    slot = plsm__find( plsm, id );
+    if ( slot == NULL ) {
         return NULL;
     }
+
+    return plcm_data( &plsm->data ) + slot->index * plsm->isize;
 }
 
 
-pl_bool_t plls_node_at_start( plls_node_t node, plls_t plls )
+pl_id_t plsm_id( plsm_t plsm, pl_size_t index )
 {
-    if ( node && node == plls->head ) {
-        return pl_true;
-    } else {
-        return pl_false;
-    }
+    pl_u32_t slot;
+
+    slot = *plsm__back( plsm, index );
+    return ( (pl_id_t)plsm__slot( plsm, slot )->gen << 32 ) | slot;
 }
 
 
-pl_bool_t plls_node_at_end( plls_node_t node, plls_t plls )
+pl_t plsm_data( plsm_t plsm )
 {
-    if ( node && node == plls->tail ) {
-        return pl_true;
-    } else {
-        return pl_false;
-    }
+    return plcm_data( &plsm->data );
 }
 
 
-plbm_t plls_host( plls_t plls )
+pl_size_t plsm_size( plsm_t plsm )
 {
-    return plls->host;
+    return plcm_used_for_type( &plsm->back, pl_u32_t );
 }
 
 
-plls_node_p plls_head( plls_t plls )
+pl_none plsm_clear( plsm_t plsm )
 {
-    return &plls->head;
+    for ( pl_size_t i = 0; i < plsm_size( plsm ); i++ ) {
+        plsm__release( plsm, *plsm__back( plsm, i ) );
+    }
+    plcm_reset( &plsm->data );
+    plcm_reset( &plsm->back );
 }
 
 
-plls_node_p plls_tail( plls_t plls )
-{
-    return &plls->tail;
-}
 
+/* ------------------------------------------------------------
+ * Gap Buffer:
+ */
 
-plls_node_p plls_index( plls_t plls, pl_size_t index )
+/*
+ * Ensure that gap has at least size bytes. Content after gap is moved
+ * to the end of the grown storage. Return false, if storage can't
+ * grow.
+ */
+static pl_bool_t plgb__reserve( plgb_t plgb, pl_size_t size )
 {
-    plls_node_p node;
-    pl_size_t   i;
+    pl_size_t tail;
+    pl_size_t new_size;
 
-    if ( index == 0 || !plls->head ) {
-        return &plls->head;
+    if ( plgb->gend - plgb->gpos >= size ) {
+        return pl_true;
     }
 
-    node = &plls->head;
-    i = 0;
-    while ( i < index && ( *node )->next ) {
-        node = &( ( *node )->next );
-        i++;
+    tail = plcm_size( &plgb->plcm ) - plgb->gend;
+    new_size = plcm_size( &plgb->plcm ) + size - ( plgb->gend - plgb->gpos );
+    if ( !plcm_resize( &plgb->plcm, new_size ) ) {
+        return pl_false;
     }
+    new_size = plcm_size( &plgb->plcm );
+    memmove( plcm_data( &plgb->plcm ) + new_size - tail,
+             plcm_data( &plgb->plcm ) + plgb->gend,
+             tail );
+    plgb->gend = new_size - tail;
 
-    return node;
+    return pl_true;
 }
 
 
-pl_size_t plls_size( plls_t plls )
+pl_none plgb_new( plgb_t plgb, pl_size_t size )
 {
-    return plls->size;
+    if ( size == 0 ) {
+        size = 64;
+    }
+    plcm_new( &plgb->plcm, size );
+    plgb->gpos = 0;
+    plgb->gend = size;
 }
 
 
-
-/* ------------------------------------------------------------
- * List (doubly-linked):
- */
-
-plld_s plld_init( plbm_t plbm )
+pl_none plgb_del( plgb_t plgb )
 {
-    return (plld_s){ plbm, NULL, NULL, 0 };
+    plcm_del( &plgb->plcm );
+    plgb->gpos = 0;
+    plgb->gend = 0;
 }
 
 
-pl_none plld_append( plld_t plld, plld_node_t place, const pl_t data )
+pl_size_t plgb_length( plgb_t plgb )
 {
-    plld_append_with_size(
-        plld, place, data, plbm_block_size( plld->host ) - plld_node_overhead() );
+    return plcm_size( &plgb->plcm ) - ( plgb->gend - plgb->gpos );
 }
 
 
-pl_none plld_append_with_size( plld_t plld, plld_node_t place, const pl_t data, pl_size_t size )
+pl_none plgb_move( plgb_t plgb, pl_pos_t pos )
 {
-    plld_node_t node;
+    pl_t      data;
+    pl_size_t size;
 
-    node = plbm_get( plld->host );
-    plld->size++;
+    data = plcm_data( &plgb->plcm );
+
+    if ( pos < plgb->gpos ) {
+        size = plgb->gpos - pos;
+        memmove( data + plgb->gend - size, data + pos, size );
+        plgb->gpos -= size;
+        plgb->gend -= size;
+    } else if ( pos > plgb->gpos ) {
+        size = pos - plgb->gpos;
+        memmove( data + plgb->gpos, data + plgb->gend, size );
+        plgb->gpos += size;
+        plgb->gend += size;
+    }
+}
 
-    if ( plld->head ) {
 
-        if ( place == plld->tail ) {
+pl_none plgb_insert( plgb_t plgb, pl_pos_t pos, const pl_t data, pl_size_t size )
+{
+    plgb_move( plgb, pos );
+    if ( !plgb__reserve( plgb, size ) ) {
+        return;
+    }
+    memcpy( plcm_data( &plgb->plcm ) + plgb->gpos, data, size );
+    plgb->gpos += size;
+}
 
-            /*
-              Append to list end.
-                                      ,place
-                  +---+    +---+    +---+
-                  |   |--->|   |--->|   |--->
-                  +---+    +---+    +---+    |
-                                            ---
-             */
-            node->prev = plld->tail;
-            node->next = NULL;
-            plld->tail->next = node;
-            plld->tail = node;
 
-        } else {
+pl_none plgb_remove( plgb_t plgb, pl_pos_t pos, pl_size_t size )
+{
+    if ( pos >= plgb_length( plgb ) ) {
+        return;
+    }
+    if ( pos + size > plgb_length( plgb ) ) {
+        size = plgb_length( plgb ) - pos;
+    }
+    plgb_move( plgb, pos );
+    plgb->gend += size;
+}
 
-            /*
 
-              Append after place.
-                             ,place
-                  +---+    +---+    +---+
-                  |   |--->|   |--->|   |--->
-                  +---+    +---+    +---+    |
-                                            ---
-             */
-            node->prev = place;
-            node->next = place->next;
-            place->next = node;
-            node->next->prev = node;
-        }
+pl_t plgb_ref( plgb_t plgb, pl_pos_t pos )
+{
+    if ( pos < plgb->gpos ) {
+        return plcm_data( &plgb->plcm ) + pos;
     } else {
-        node->prev = NULL;
-        node->next = NULL;
-        plld->head = node;
-        plld->tail = node;
+        return plcm_data( &plgb->plcm ) + plgb->gend + ( pos - plgb->gpos );
     }
-
-    memcpy( node->data, data, size );
 }
 
 
-pl_none plld_insert( plld_t plld, plld_node_t place, const pl_t data )
+plsr_s plgb_plsr( plgb_t plgb )
 {
-    plld_insert_with_size(
-        plld, place, data, plbm_block_size( plld->host ) - plld_node_overhead() );
+    plgb_move( plgb, plgb_length( plgb ) );
+    if ( !plgb__reserve( plgb, 1 ) ) {
+        return plsr_null();
+    }
+    *( (char*)plcm_data( &plgb->plcm ) + plgb->gpos ) = 0;
+    return plsr_from_string_and_length( plcm_data( &plgb->plcm ), plgb->gpos );
 }
 
 
-pl_none plld_insert_with_size( plld_t plld, plld_node_t place, const pl_t data, pl_size_t size )
+pl_none plgb_clear( plgb_t plgb )
 {
-    plld_node_t node;
-
-    node = plbm_get( plld->host );
-    plld->size++;
+    plgb->gpos = 0;
+    plgb->gend = plcm_size( &plgb->plcm );
+}
 
-    if ( plld->head ) {
 
-        if ( place == plld->head ) {
 
-            /*
-              Insert to list start.
-                    ,place
-                  +---+    +---+    +---+
-                  |   |--->|   |--->|   |--->
-                  +---+    +---+    +---+    |
-                                            ---
-             */
-            node->prev = NULL;
-            node->next = place;
-            place->prev = node;
-            plld->head = node;
 
-        } else {
+/* ------------------------------------------------------------
+ * Rope:
+ */
 
-            /*
-              Insert before place.
-                             ,place
-                  +---+    +---+    +---+
-                  |   |--->|   |--->|   |--->
-                  +---+    +---+    +---+    |
-                                            ---
-             */
-            node->prev = place->prev;
-            node->next = place;
-            place->prev->next = node;
-            place->prev = node;
-        }
+static pl_size_t plro__length( plro_node_t node )
+{
+    if ( node ) {
+        return node->length;
     } else {
-        node->prev = NULL;
-        node->next = NULL;
-        plld->head = node;
-        plld->tail = node;
+        return 0;
     }
-
-    memcpy( node->data, data, size );
 }
 
+static pl_none plro__update( plro_node_t node )
+{
+    node->length = plro__length( node->left ) + node->used + plro__length( node->right );
+}
 
-plld_node_t plld_remove( plld_t plld, plld_node_t place )
+/*
+ * Return node priority (xorshift).
+ */
+static pl_u32_t plro__prio( plro_t plro )
 {
-    if ( plld->head && place ) {
+    plro->seed ^= plro->seed << 13;
+    plro->seed ^= plro->seed >> 17;
+    plro->seed ^= plro->seed << 5;
+    return plro->seed;
+}
 
-        /* NOTE: plbm_put overwrites the node content. Therefore we
-           must first re-arrange plld_node next and prev pointers, and
-           only after this, we put back the block to plbm. */
+static plro_node_t plro__node( plro_t plro, const pl_t data, pl_size_t size )
+{
+    plro_node_t node;
 
-        plld->size--;
+    node = plbm_get( plro->host );
+    node->left = NULL;
+    node->right = NULL;
+    node->prio = plro__prio( plro );
+    node->used = size;
+    node->length = size;
+    memcpy( node->data, data, size );
 
-        if ( place->prev == NULL && place->next == NULL ) {
+    return node;
+}
 
-            /* Remove the only node. */
-            plld->head = NULL;
-            plld->tail = NULL;
-            plbm_put( plld->host, place );
-            return NULL;
+static plro_node_t plro__merge( plro_node_t a, plro_node_t b )
+{
+    if ( a == NULL ) {
+        return b;
+    } else if ( b == NULL ) {
+        return a;
+    } else if ( a->prio > b->prio ) {
+        a->right = plro__merge( a->right, b );
+        plro__update( a );
+        return a;
+    } else {
+        b->left = plro__merge( a, b->left );
+        plro__update( b );
+        return b;
+    }
+}
 
-        } else if ( place == plld->head ) {
+/*
+ * Split tree to content before pos (left) and after (right). Node
+ * at pos is split to two nodes.
+ */
+static pl_none plro__split(
+    plro_t plro, plro_node_t node, pl_size_t pos, plro_node_t* left, plro_node_t* right )
+{
+    pl_size_t llen;
 
-            /* Remove head node. */
-            place->next->prev = NULL;
-            plld->head = place->next;
-            plbm_put( plld->host, place );
-            return plld->head;
+    if ( node == NULL ) {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
 
-        } else if ( place == plld->tail ) {
+    llen = plro__length( node->left );
 
-            /* Remove tail node. */
-            plld->tail = place->prev;
-            plld->tail->next = NULL;
-            plbm_put( plld->host, place );
-            return plld->tail;
+    if ( pos <= llen ) {
+        plro__split( plro, node->left, pos, left, &node->left );
+        plro__update( node );
+        *right = node;
+    } else if ( pos >= llen + node->used ) {
+        plro__split( plro, node->right, pos - llen - node->used, &node->right, right );
+        plro__update( node );
+        *left = node;
+    } else {
+        plro_node_t tail;
+        pl_size_t   off;
+        off = pos - llen;
+        tail = plro__node( plro, node->data + off, node->used - off );
+        node->used = off;
+        *right = plro__merge( tail, node->right );
+        node->right = NULL;
+        plro__update( node );
+        *left = node;
+    }
+}
 
-        } else {
+/*
+ * Return first (leftmost) node of tree.
+ */
+static plro_node_t plro__first( plro_node_t node )
+{
+    while ( node->left ) {
+        node = node->left;
+    }
+    return node;
+}
 
-            /*
-              Remove node in the middle.
-                             ,place
-                  +---+    +---+    +---+
-                  |   |--->|   |--->|   |--->
-                  +---+    +---+    +---+    |
-                                            ---
-             */
-            place->next->prev = place->prev;
-            place->prev->next = place->next;
-            plbm_put( plld->host, place );
-            return place->next;
-        }
+/*
+ * Return last (rightmost) node of tree.
+ */
+static plro_node_t plro__last( plro_node_t node )
+{
+    while ( node->right ) {
+        node = node->right;
+    }
+    return node;
+}
 
-    } else {
+/*
+ * Concatenate trees, and combine the boundary nodes while their
+ * content fits into one node. Hence adjacent nodes never fit together
+ * around the boundary, and the node count stays proportional to the
+ * content length.
+ */
+static plro_node_t plro__join( plro_t plro, plro_node_t left, plro_node_t right )
+{
+    plro_node_t cur;
+    plro_node_t other;
 
-        return NULL;
+    if ( left == NULL || right == NULL ) {
+        return plro__merge( left, right );
     }
-}
 
+    /* Splits at node boundaries only detach nodes. */
+    plro__split( plro, left, left->length - plro__last( left )->used, &left, &cur );
 
-pl_none plld_store( plld_t plld, const pl_t data )
-{
-    plld_store_with_size( plld, data, plbm_block_size( plld->host ) - plld_node_overhead() );
-}
+    while ( right ) {
+        other = plro__first( right );
+        if ( cur->used + other->used > plro->capa ) {
+            break;
+        }
+        plro__split( plro, right, other->used, &other, &right );
+        memcpy( cur->data + cur->used, other->data, other->used );
+        cur->used += other->used;
+        plro__update( cur );
+        plbm_put( plro->host, other );
+    }
 
+    while ( left ) {
+        other = plro__last( left );
+        if ( other->used + cur->used > plro->capa ) {
+            break;
+        }
+        plro__split( plro, left, left->length - other->used, &left, &other );
+        memcpy( other->data + other->used, cur->data, cur->used );
+        other->used += cur->used;
+        plro__update( other );
+        plbm_put( plro->host, cur );
+        cur = other;
+    }
 
-pl_none plld_store_with_size( plld_t plld, const pl_t data, pl_size_t size )
-{
-    plld_append_with_size( plld, plld->tail, data, size );
+    return plro__merge( plro__merge( left, cur ), right );
 }
 
-
-pl_size_t plld_node_overhead( void )
+/*
+ * Insert to node at pos, if there is room. Subtree lengths are
+ * updated on the path.
+ */
+static pl_bool_t plro__insert_at(
+    plro_t plro, plro_node_t node, pl_size_t pos, const pl_t data, pl_size_t size )
 {
-    return sizeof( plld_node_s );
-}
+    pl_size_t llen;
+    pl_bool_t ret;
 
+    if ( node == NULL ) {
+        return pl_false;
+    }
 
-pl_t plld_node_data( plld_node_t node )
-{
-    if ( node ) {
-        return node->data;
+    llen = plro__length( node->left );
+
+    if ( pos < llen ) {
+        ret = plro__insert_at( plro, node->left, pos, data, size );
+    } else if ( pos > llen + node->used ) {
+        ret = plro__insert_at( plro, node->right, pos - llen - node->used, data, size );
+    } else if ( node->used + size <= plro->capa ) {
+        pl_size_t off;
+        off = pos - llen;
+        memmove( node->data + off + size, node->data + off, node->used - off );
+        memcpy( node->data + off, data, size );
+        node->used += size;
+        ret = pl_true;
     } else {
-        return NULL;
+        ret = pl_false;
     }
-}
 
-
-plld_node_t plld_node_next( plld_node_t node )
-{
-    if ( node ) {
-        return node->next;
-    } else {
-        return NULL;
+    if ( ret ) {
+        node->length += size;
     }
-}
 
+    return ret;
+}
 
-plld_node_t plld_node_prev( plld_node_t node )
+static pl_none plro__free( plro_t plro, plro_node_t node )
 {
     if ( node ) {
-        return node->prev;
-    } else {
-        return NULL;
+        plro__free( plro, node->left );
+        plro__free( plro, node->right );
+        plbm_put( plro->host, node );
     }
 }
 
-
-pl_bool_t plld_node_at_start( plld_node_t node )
-{
-    if ( node && node->prev == NULL ) {
-        return pl_true;
-    } else {
-        return pl_false;
+/*
+ * Return node containing pos, and set offset of pos in node.
+ */
+static plro_node_t plro__find( plro_t plro, pl_size_t pos, pl_size_t* off )
+{
+    plro_node_t node;
+    pl_size_t   llen;
+
+    node = plro->root;
+    while ( node ) {
+        llen = plro__length( node->left );
+        if ( pos < llen ) {
+            node = node->left;
+        } else if ( pos < llen + node->used ) {
+            *off = pos - llen;
+            return node;
+        } else {
+            pos -= llen + node->used;
+            node = node->right;
+        }
     }
-}
-
 
-pl_bool_t plld_node_at_end( plld_node_t node )
-{
-    if ( node && node->next == NULL ) {
-        return pl_true;
-    } else {
-        return pl_false;
-    }
+    return NULL;
 }
 
 
-plbm_t plld_host( plld_t plld )
+plro_s plro_init( plbm_t plbm, pl_size_t capa )
 {
-    return plld->host;
+    return (plro_s){ plbm, NULL, capa, 2463534242 };
 }
 
 
-plld_node_t plld_head( plld_t plld )
+pl_size_t plro_node_overhead( void )
 {
-    return plld->head;
+    return sizeof( plro_node_s );
 }
 
 
-plld_node_t plld_tail( plld_t plld )
+pl_size_t plro_length( plro_t plro )
 {
-    return plld->tail;
+    return plro__length( plro->root );
 }
 
 
-plld_node_t plld_index( plld_t plld, pl_size_t index )
+pl_none plro_insert( plro_t plro, pl_pos_t pos, const pl_t data, pl_size_t size )
 {
-    plld_node_t node;
-    pl_size_t   i;
+    plro_node_t left;
+    plro_node_t right;
+    plro_node_t mid;
+    pl_size_t   blop;
 
-    if ( index == 0 || !plld->head ) {
-        return plld->head;
+    if ( size == 0 || plro__insert_at( plro, plro->root, pos, data, size ) ) {
+        return;
     }
 
-    node = plld->head;
-    i = 1;
-    while ( i < index && node->next ) {
-        node = node->next;
-        i++;
+    mid = NULL;
+    for ( pl_size_t done = 0; done < size; done += blop ) {
+        blop = size - done;
+        if ( blop > plro->capa ) {
+            blop = plro->capa;
+        }
+        mid = plro__merge( mid, plro__node( plro, data + done, blop ) );
     }
 
-    return node->next;
+    plro__split( plro, plro->root, pos, &left, &right );
+    plro->root = plro__join( plro, plro__join( plro, left, mid ), right );
 }
 
 
-pl_size_t plld_size( plld_t plld )
+pl_none plro_remove( plro_t plro, pl_pos_t pos, pl_size_t size )
 {
-    return plld->size;
-}
+    plro_node_t left;
+    plro_node_t mid;
+    plro_node_t right;
 
-
-
-/* ------------------------------------------------------------
- * List (unrolled):
- */
-
-pllu_s pllu_init( plbm_t plbm, pl_size_t capa )
-{
-    return (pllu_s){ plbm, NULL, NULL, 0, capa };
+    plro__split( plro, plro->root, pos, &left, &right );
+    plro__split( plro, right, size, &mid, &right );
+    plro__free( plro, mid );
+    plro->root = plro__join( plro, left, right );
 }
 
 
-pl_none pllu_store( pllu_t pllu, const pl_t data, pl_size_t size )
+plro_s plro_split( plro_t plro, pl_pos_t pos )
 {
-    pllu_node_t node;
-    pl_size_t   done;
-    pl_size_t   left;
-    pl_size_t   blop;
-    pl_size_t   tail;
-
-    done = 0;
-    left = size;
+    plro_s rest;
 
-    while ( done < size ) {
+    rest = plro_init( plro->host, plro->capa );
+    rest.seed = plro__prio( plro );
+    plro__split( plro, plro->root, pos, &plro->root, &rest.root );
 
-        /* Allocate a node if no nodes, or if the current is full. */
+    return rest;
+}
 
-        if ( !pllu->head ) {
 
-            node = plbm_get( pllu->host );
-            node->prev = NULL;
-            node->next = NULL;
-            node->used = 0;
-            pllu->head = node;
-            pllu->tail = node;
+pl_none plro_concat( plro_t plro, plro_t other )
+{
+    plro->root = plro__join( plro, plro->root, other->root );
+    other->root = NULL;
+}
 
-        } else if ( pllu->tail->used >= pllu->capa ) {
 
-            node = plbm_get( pllu->host );
-            node->prev = pllu->tail;
-            node->next = NULL;
-            node->used = 0;
-            pllu->tail->next = node;
-            pllu->tail = node;
+pl_t plro_ref( plro_t plro, pl_pos_t pos )
+{
+    plro_node_t node;
+    pl_size_t   off;
 
-        } else {
+    node = plro__find( plro, pos, &off );
+    if ( node ) {
+        return node->data + off;
+    } else {
+        return NULL;
+    }
+}
 
-            node = pllu->tail;
-        }
 
-        tail = pllu->capa - node->used;
-        if ( left > tail ) {
-            blop = tail;
-        } else {
-            blop = left;
-        }
+pl_none plro_flatten( plro_t plro, plcm_t plcm )
+{
+    plro_cursor_s cursor;
+    plsr_s        slice;
 
-        memcpy( node->data + node->used, data + done, blop );
-        node->used += blop;
-        pllu->size += blop;
-        done += blop;
-        left -= blop;
+    if ( !plcm_resize( plcm, plcm_used( plcm ) + plro_length( plro ) ) ) {
+        return;
+    }
+    cursor = plro_cursor_init( plro, 0 );
+    while ( !plsr_is_null( slice = plro_cursor_next( &cursor ) ) ) {
+        plcm_store( plcm, (pl_t)plsr_string( slice ), plsr_length( slice ) );
     }
 }
 
 
-pl_size_t pllu_node_overhead( void )
+pl_none plro_clear( plro_t plro )
 {
-    return sizeof( pllu_node_s );
+    plro__free( plro, plro->root );
+    plro->root = NULL;
 }
 
 
-pllu_cursor_s pllu_cursor_init( pllu_t pllu )
+plro_cursor_s plro_cursor_init( plro_t plro, pl_pos_t pos )
 {
-    return (pllu_cursor_s){ pllu, pllu->head, 0 };
+    return (plro_cursor_s){ plro, pos };
 }
 
 
-pllu_cursor_s pllu_cursor_init_to_end( pllu_t pllu )
+plsr_s plro_cursor_next( plro_cursor_t cursor )
 {
-    return (pllu_cursor_s){ pllu, pllu->tail, pllu->tail->used };
+    plro_node_t node;
+    pl_size_t   off;
+
+    node = plro__find( cursor->plro, cursor->pos, &off );
+    if ( node ) {
+        cursor->pos += node->used - off;
+        return plsr_from_string_and_length( (const char*)node->data + off, node->used - off );
+    } else {
+        return plsr_null();
+    }
 }
 
 
-pllu_node_t pllu_cursor_node( pllu_cursor_t cursor )
-{
-    return cursor->node;
-}
 
 
-pl_t pllu_cursor_data( pllu_cursor_t cursor, pl_size_p size )
+/* ------------------------------------------------------------
+ * Ring Buffer:
+ */
+
+static pl_size_t plrb__capa( plrb_t plrb )
 {
-    *size = cursor->node->used;
-    return cursor->node->data;
+    return plcm_size( &plrb->plcm ) / plrb->isize;
 }
 
+/*
+ * Return storage location of item at index.
+ */
+static pl_t plrb__slot( plrb_t plrb, pl_size_t index )
+{
+    index += plrb->head;
+    if ( index >= plrb__capa( plrb ) ) {
+        index -= plrb__capa( plrb );
+    }
+    return plcm_data( &plrb->plcm ) + index * plrb->isize;
+}
 
-pl_size_t pllu_cursor_used( pllu_cursor_t cursor )
+/*
+ * Grow storage, when full. Wrapped items are moved after the old
+ * storage end, hence items are continuous (unwrapped) after growth.
+ * Return false, if plrb is invalid or storage can't grow.
+ */
+static pl_bool_t plrb__ensure( plrb_t plrb )
 {
-    return cursor->node->used;
+    pl_size_t capa;
+
+    if ( plrb->isize == 0 ) {
+        return pl_false;
+    }
+
+    capa = plrb__capa( plrb );
+    if ( plrb->count < capa ) {
+        return pl_true;
+    }
+
+    if ( !plcm_resize( &plrb->plcm, ( capa > 0 ? 2 * capa : 16 ) * plrb->isize ) ) {
+        return pl_false;
+    }
+    if ( plrb->head > 0 ) {
+        memcpy( plcm_data( &plrb->plcm ) + capa * plrb->isize,
+                plcm_data( &plrb->plcm ),
+                plrb->head * plrb->isize );
+    }
+
+    return pl_true;
 }
 
 
-pl_none pllu_cursor_next( pllu_cursor_t cursor )
+pl_none plrb_new( plrb_t plrb, pl_size_t isize, pl_size_t count )
 {
-    cursor->node = cursor->node->next;
+    if ( count == 0 ) {
+        count = 16;
+    }
+    if ( isize > 0 ) {
+        plcm_new( &plrb->plcm, count * isize );
+    } else {
+        /* Invalid plrb, items are not accepted. */
+        plcm__init( &plrb->plcm );
+    }
+    plrb->head = 0;
+    plrb->count = 0;
+    plrb->isize = isize;
 }
 
 
-pl_none pllu_cursor_prev( pllu_cursor_t cursor )
+pl_none plrb_del( plrb_t plrb )
 {
-    cursor->node = cursor->node->prev;
+    plcm_del( &plrb->plcm );
+    plrb->head = 0;
+    plrb->count = 0;
 }
 
 
-pl_t pllu_cursor_data_step( pllu_cursor_t cursor, pl_size_p size )
+pl_none plrb_push_back( plrb_t plrb, const pl_t item )
 {
-    pl_t ret;
-    ret = pllu_cursor_data( cursor, size );
-    pllu_cursor_next( cursor );
-    return ret;
+    if ( !plrb__ensure( plrb ) ) {
+        return;
+    }
+    memcpy( plrb__slot( plrb, plrb->count ), item, plrb->isize );
+    plrb->count++;
 }
 
 
-pl_t pllu_cursor_item( pllu_cursor_t cursor )
+pl_none plrb_push_front( plrb_t plrb, const pl_t item )
 {
-    return cursor->node->data + cursor->spot;
+    if ( !plrb__ensure( plrb ) ) {
+        return;
+    }
+    if ( plrb->head == 0 ) {
+        plrb->head = plrb__capa( plrb );
+    }
+    plrb->head--;
+    plrb->count++;
+    memcpy( plrb__slot( plrb, 0 ), item, plrb->isize );
 }
 
 
-pl_none pllu_cursor_next_item( pllu_cursor_t cursor, pl_size_t step )
+pl_bool_t plrb_pop_back( plrb_t plrb, pl_t item )
 {
-    pl_size_t tail;
+    if ( plrb->count == 0 ) {
+        return pl_false;
+    }
 
-    tail = cursor->node->used - cursor->spot;
-    if ( step < tail ) {
-        cursor->spot += step;
-    } else if ( cursor->node->next ) {
-        tail = step - tail;
-        cursor->node = cursor->node->next;
-        cursor->spot = tail;
-    } else {
-        cursor->node = NULL;
+    plrb->count--;
+    if ( item ) {
+        memcpy( item, plrb__slot( plrb, plrb->count ), plrb->isize );
     }
+
+    return pl_true;
 }
 
 
-pl_none pllu_cursor_prev_item( pllu_cursor_t cursor, pl_size_t step )
+pl_bool_t plrb_pop_front( plrb_t plrb, pl_t item )
 {
-    if ( cursor->spot >= step ) {
-        cursor->spot -= step;
-    } else if ( cursor->node->prev ) {
-        pl_size_t tail;
-        tail = step - cursor->spot;
-        cursor->node = cursor->node->prev;
-        cursor->spot = cursor->node->used - tail;
-    } else {
-        cursor->node = NULL;
+    if ( plrb->count == 0 ) {
+        return pl_false;
     }
-}
 
+    if ( item ) {
+        memcpy( item, plrb__slot( plrb, 0 ), plrb->isize );
+    }
+    plrb->head++;
+    if ( plrb->head >= plrb__capa( plrb ) ) {
+        plrb->head = 0;
+    }
+    plrb->count--;
 
-pl_t pllu_cursor_item_step( pllu_cursor_t cursor, pl_size_t step )
-{
-    pl_t ret;
-    ret = pllu_cursor_item( cursor );
-    pllu_cursor_next_item( cursor, step );
-    return ret;
+    return pl_true;
 }
 
 
-plbm_t pllu_host( pllu_t pllu )
+pl_t plrb_ref( plrb_t plrb, pl_size_t index )
 {
-    return pllu->host;
+    if ( index < plrb->count ) {
+        return plrb__slot( plrb, index );
+    } else {
+        return NULL;
+    }
 }
 
 
-pllu_node_t pllu_head( pllu_t pllu )
+pl_size_t plrb_count( plrb_t plrb )
 {
-    return pllu->head;
+    return plrb->count;
 }
 
 
-pllu_node_t pllu_tail( pllu_t pllu )
+pl_size_t plrb_spans( plrb_t plrb, plsr_s* spans )
 {
-    return pllu->tail;
-}
+    pl_size_t first;
 
+    if ( plrb->count == 0 ) {
+        return 0;
+    }
 
-pl_size_t pllu_size( pllu_t pllu )
-{
-    return pllu->size;
+    first = plrb__capa( plrb ) - plrb->head;
+    if ( first >= plrb->count ) {
+        spans[ 0 ] = plsr_from_string_and_length( plrb__slot( plrb, 0 ),
+                                                  plrb->count * plrb->isize );
+        return 1;
+    } else {
+        spans[ 0 ] = plsr_from_string_and_length( plrb__slot( plrb, 0 ), first * plrb->isize );
+        spans[ 1 ] = plsr_from_string_and_length( plcm_data( &plrb->plcm ),
+                                                  ( plrb->count - first ) * plrb->isize );
+        return 2;
+    }
 }
 
 
-pl_size_t pllu_capa( pllu_t pllu )
+pl_none plrb_clear( plrb_t plrb )
 {
-    return pllu->capa;
+    plrb->head = 0;
+    plrb->count = 0;
 }
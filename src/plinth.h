@@ -16,6 +16,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdarg.h>
+#include <pthread.h>
 
 
 /* ------------------------------------------------------------
@@ -136,6 +137,7 @@ typedef void* restrict* restrict pl_pu;
 
 pl_type( int8_t, pl_i8 );    /**< Character type. */
 pl_type( uint8_t, pl_u8 );   /**< Character type. */
+pl_type( uint32_t, pl_u32 ); /**< Unsigned int type (32-bits). */
 pl_type( int64_t, pl_i64 );  /**< Int type (64-bits). */
 pl_type( uint64_t, pl_u64 ); /**< Unsigned int type (64-bits). */
 pl_type( double, pl_flt );   /**< 64-bit floating point. .*/
@@ -144,6 +146,7 @@ pl_type( uint64_t, pl_size ); /**< Size of allocation type. */
 pl_type( int64_t, pl_ssize ); /**< Signed size of allocation type. */
 pl_type( int64_t, pl_pos );   /**< Position in array. */
 pl_type( uint64_t, pl_id );   /**< Identification number type. */
+pl_type( uint32_t, pl_bh );   /**< Block handle type. */
 pl_type( uint64_t, pl_hash ); /**< Identification number type. */
 
 
@@ -167,9 +170,45 @@ extern pl_none pl_dummy( pl_none );
     ( ( ( ( size ) + ( alignment ) - 1 ) / ( alignment ) ) * ( alignment ) )
 
 
+/** Huge page size for PL_MF_HUGETLB Nodes. */
+#define PLINTH_HUGE_PAGE_SIZE ( 2 * 1024 * 1024 )
+
+
+/** Size class count for plsl (16 to 4096 bytes). */
+#define PLSL_CLASS_COUNT 9
+
+/** Smallest plsl size class. */
+#define PLSL_CLASS_MIN 16
+
+/** Largest plsl size class. */
+#define PLSL_CLASS_MAX ( PLSL_CLASS_MIN << ( PLSL_CLASS_COUNT - 1 ) )
+
+/** Inline storage size of plci. */
+#define PLCI_SIZE 32
+
+
 /** Allocator affinity type. */
-pl_enum( pl_aa ){ PL_AA_NONE = 0, PL_AA_SELF, PL_AA_HEAP, PL_AA_PLAM,
-                  PL_AA_PLBM,     PL_AA_PLCM, PL_AA_DESC };
+pl_enum( pl_aa ){ PL_AA_NONE = 0, PL_AA_SELF, PL_AA_HEAP, PL_AA_PLAM, PL_AA_PLBM,
+                  PL_AA_PLCM,     PL_AA_DESC, PL_AA_PLND, PL_AA_MMAP };
+
+
+/** Mapped (PL_AA_MMAP) Node flags, and allocation flags. */
+pl_enum( pl_mf ){
+    PL_MF_NONE = 0,     /**< Regular pages. */
+    PL_MF_HUGE = 1,     /**< Transparent huge pages (madvise). */
+    PL_MF_HUGETLB = 2,  /**< Reserved huge pages, fallback to PL_MF_HUGE. */
+    PL_MF_POPULATE = 4, /**< Prefault pages at Node creation. */
+    PL_MF_NOZERO = 8,   /**< Skip zeroing of heap allocated memory. */
+};
+
+
+/** Plcm growth policy. */
+pl_enum( pl_gp ){
+    PL_GP_DOUBLE = 0, /**< Double the size (default). */
+    PL_GP_HALF,       /**< Increase the size by half. */
+    PL_GP_PAGE,       /**< Round up the required size to page size. */
+    PL_GP_CAPPED,     /**< Double the size, but increase at most by cap. */
+};
 
 
 /**
@@ -183,6 +222,9 @@ pl_enum( pl_aa ){ PL_AA_NONE = 0, PL_AA_SELF, PL_AA_HEAP, PL_AA_PLAM,
  *        \        \
  *         data     node size
  *
+ * Node size is stored in the header, since plam Node sizes vary with
+ * plam_grow(). The header is 32 bytes on 64-bit targets.
+ *
  */
 pl_struct_type( pl_node );
 pl_struct_body( pl_node )
@@ -190,10 +232,27 @@ pl_struct_body( pl_node )
     pl_node_t prev;      /**< Previous node. */
     pl_node_t next;      /**< Next node. */
     pl_size_t used;      /**< Used count for data. */
+    pl_size_t size;      /**< Node size (incl. header). */
     uint8_t   data[ 0 ]; /**< Data location. */
 };
 
 
+/**
+ * Arena Memory Allocator Mark (position).
+ *
+ *                 node
+ *                /  used
+ *               /  /
+ *     #+++- <-> #++--
+ */
+pl_struct( plam_mark )
+{
+    pl_node_t node;  /**< Node at mark. */
+    pl_size_t used;  /**< Node used count at mark. */
+    pl_node_t large; /**< Oversize allocations at mark. */
+};
+
+
 /**
  * Arena Memory Allocator Descriptor.
  *
@@ -208,11 +267,29 @@ pl_struct_body( pl_node )
  */
 pl_struct( plam )
 {
-    pl_node_t node;  /**< Current node. */
-    pl_size_t size;  /**< Node size. */
-    pl_aa_t   type;  /**< Reservation type. */
-    pl_size_t align; /**< Alignment (0 for none). */
-    pl_t      host;  /**< Allocator host (if any). */
+    pl_node_t   node;  /**< Current node. */
+    pl_size_t   size;  /**< Node size. */
+    pl_aa_t     type;  /**< Reservation type. */
+    pl_size_t   align; /**< Alignment (0 for none). */
+    pl_t        host;  /**< Allocator host (if any). */
+    pl_size_t   limit; /**< Node size growth limit (0 for fixed). */
+    pl_node_t   large; /**< Oversize allocation nodes. */
+    pl_size_t   flags; /**< Node flags (PL_MF_*). */
+    plam_mark_s base;  /**< Host position at creation (nested in plam). */
+};
+
+
+/**
+ * Arena Shared Memory Allocator Descriptor.
+ *
+ * Plam for concurrent allocations from multiple threads. Space is
+ * claimed with atomic increment of Node used count, and lock is used
+ * only when a new Node is chained.
+ */
+pl_struct( plas )
+{
+    plam_s          plam; /**< Arena. */
+    pthread_mutex_t lock; /**< Node chaining lock. */
 };
 
 
@@ -233,8 +310,132 @@ pl_struct( plbm )
     pl_size_t nsize; /**< Node size. */
     pl_size_t bsize; /**< Block size. */
     pl_size_t itail; /**< Init tail count. */
+    pl_size_t imax;  /**< Init tail count for new Node. */
     pl_aa_t   type;  /**< Reservation type. */
     pl_t      host;  /**< Allocator host (if any). */
+    pl_size_t flags; /**< Node flags (PL_MF_*). */
+    pl_size_t amask; /**< Block alignment mask (alignment - 1). */
+};
+
+
+/**
+ * Block Bitmap Allocator Descriptor.
+ *
+ * Block Memory Allocator with occupancy bitmap (bit per Block) in
+ * Node instead of free Block chain. Block size can be as small as one
+ * byte, and Blocks are allocated in address order. Node size is power
+ * of two and Nodes are aligned by it, hence Node is found from Block
+ * address.
+ *
+ *              bitmap       Blocks
+ *             /            /
+ *     #---- [ 1110 0100 ] ###-##--
+ */
+pl_struct( plbb )
+{
+    pl_node_t node;   /**< Current node. */
+    pl_size_t nsize;  /**< Node size. */
+    pl_size_t bsize;  /**< Block size. */
+    pl_size_t bcount; /**< Block count in Node. */
+    pl_size_t wcount; /**< Bitmap word count in Node. */
+    pl_size_t hint;   /**< First bitmap word with free Blocks (current Node). */
+};
+
+
+/**
+ * Block Shared Memory Allocator Descriptor.
+ *
+ * Plbm for concurrent allocations from multiple threads. Free Blocks
+ * are in a lock-free stack, where head includes a tag (in the upper
+ * 16 bits of pointer) against ABA. Lock is used only when a new Node
+ * is allocated.
+ *
+ * Block addresses must fit in 48 bits. This does not hold with 5-level
+ * paging (LA57) mappings above 128 TiB, or with pointer tagging (e.g.
+ * ARM TBI, or LAM). Debug builds assert the address width.
+ */
+pl_struct( plbs )
+{
+    plbm_s          plbm; /**< Block allocator (for Nodes). */
+    pl_u64_t        head; /**< Tagged free Block chain head. */
+    pthread_mutex_t lock; /**< Node allocation lock. */
+};
+
+
+/**
+ * Block Magazine Depot Descriptor.
+ *
+ * Shared plbm, from which per thread Magazines (plmg) are refilled,
+ * and to which they are flushed, in batches of Magazine size.
+ */
+pl_struct( plmd )
+{
+    plbm_s          plbm;  /**< Block allocator. */
+    pl_size_t       msize; /**< Magazine size. */
+    pthread_mutex_t lock;  /**< Depot lock. */
+};
+
+
+/**
+ * Block Magazine Descriptor.
+ *
+ * Per thread cache of Blocks from plmd. Blocks are in two LIFO
+ * arrays: loaded and previous. Allocations and deallocations use the
+ * loaded array, and previous is swapped in when loaded becomes empty
+ * or full. Depot is used only when both are empty (or full).
+ *
+ *     load   [ # # # # - - - - ]
+ *     prev   [ # # # # # # # # ]
+ */
+pl_struct( plmg )
+{
+    plmd_t    depot; /**< Magazine depot. */
+    pl_t*     load;  /**< Loaded Blocks. */
+    pl_t*     prev;  /**< Previous Blocks. */
+    pl_size_t lcnt;  /**< Loaded Block count. */
+    pl_size_t pcnt;  /**< Previous Block count. */
+    pl_size_t size;  /**< Magazine size. */
+};
+
+
+/**
+ * Slab Memory Allocator Descriptor.
+ *
+ * Plbm pool for each (power of two) size class. Pools are in one
+ * reserved address region, each pool in its own slot, hence the pool
+ * is found from the allocation address. Allocations larger than
+ * PLSL_CLASS_MAX (or from full pool) are Nodes in large chain.
+ *
+ *     base
+ *      \
+ *       [ 16 | 32 | 64 | ... | 4096 ]    large
+ *                                          \
+ *                                           #---- <-> #----
+ */
+pl_struct( plsl )
+{
+    plbm_s    pool[ PLSL_CLASS_COUNT ]; /**< Pool for each size class. */
+    pl_t      base;                     /**< Reserved region. */
+    pl_size_t shift;                    /**< Pool slot size (log2). */
+    pl_node_t large;                    /**< Large allocation chain. */
+};
+
+
+/**
+ * Node Depot Descriptor.
+ *
+ * Shared (thread-safe) storage of free Nodes with same size.
+ *
+ *     head
+ *      \
+ *       #---- -> #---- -> #----
+ */
+pl_struct( plnd )
+{
+    pl_node_t       head;  /**< Free node chain. */
+    pl_size_t       size;  /**< Node size. */
+    pl_size_t       count; /**< Free node count. */
+    pthread_mutex_t lock;  /**< Depot lock. */
 };
 
 
@@ -248,10 +449,59 @@ pl_struct( plbm )
  */
 pl_struct( plcm )
 {
-    pl_t      data; /**< Pointer to data. */
-    pl_size_t used; /**< Used count for data. */
-    pl_size_t size; /**< Reservation size for data. */
-    pl_aa_t   type; /**< Reservation type. */
+    pl_t      data;    /**< Pointer to data. */
+    pl_size_t used;    /**< Used count for data. */
+    pl_size_t size;    /**< Reservation size for data. */
+    pl_aa_t   type;    /**< Reservation type. */
+    pl_size_t reserve; /**< Reserved address range (for mmap). */
+    pl_size_t align;   /**< Data alignment (if any). */
+    pl_size_t flags;   /**< Allocation flags (PL_MF_NOZERO). */
+    pl_gp_t   growth;  /**< Growth policy. */
+    pl_size_t gcap;    /**< Growth cap (for PL_GP_CAPPED). */
+    pl_t      host;    /**< Allocator host (for plam). */
+};
+
+
+/**
+ * Inline Continuous Memory Allocator Descriptor.
+ *
+ * Plcm with inline storage for small data. Data is stored within the
+ * descriptor, until it exceeds the inline storage, and then it is
+ * moved to heap.
+ *
+ *         plci_s
+ *        /  plcm_s   inline data
+ *       /  /        /
+ *      [  #    =>  +++-- ]
+ */
+pl_struct( plci )
+{
+    plcm_s  plcm;               /**< Plcm for data. */
+    uint8_t local[ PLCI_SIZE ]; /**< Inline storage. */
+};
+
+
+/**
+ * Block Handle Allocator Descriptor.
+ *
+ * Block Memory Allocator, which hands out 32-bit handles instead of
+ * addresses. Handle is decoded to address through Node table. Handle
+ * zero is the null handle.
+ *
+ *     table
+ *      \
+ *       [ # # # ]
+ *         | | '---> #-------
+ *         | '-----> #++-+---
+ *         '-------> #+++++++
+ */
+pl_struct( plbh )
+{
+    plcm_s    table; /**< Node table. */
+    pl_bh_t   head;  /**< Free Block chain head. */
+    pl_size_t count; /**< Count of handles taken into use. */
+    pl_size_t bsize; /**< Block size. */
+    pl_size_t shift; /**< Block count in Node (log2). */
 };
 
 /**
@@ -368,6 +618,28 @@ pl_struct( plld )
 };
 
 
+/**
+ * List (doubly-linked with handles) of items.
+ *
+ * Nodes are linked with plbh handles, hence the node overhead is half
+ * of plld.
+ */
+pl_struct_type( pllh_node );
+pl_struct_body( pllh_node )
+{
+    pl_bh_t prev;      /**< Previous node. */
+    pl_bh_t next;      /**< Next node. */
+    uint8_t data[ 0 ]; /**< Data location. */
+};
+pl_struct( pllh )
+{
+    plbh_t    host; /**< Host allocator. */
+    pl_bh_t   head; /**< First node of list. */
+    pl_bh_t   tail; /**< Last node of list. */
+    pl_size_t size; /**< List size, i.e. node count. */
+};
+
+
 /**
  * List (unrolled) of items.
  *
@@ -396,6 +668,109 @@ pl_struct( pllu_cursor )
 };
 
 
+/**
+ * Slot Map of items.
+ *
+ * Items are stored densely, and referenced with stable id, which
+ * includes slot index (lower 32 bits) and slot generation (upper 32
+ * bits). Slot generation is incremented when item is removed, hence
+ * stale ids are detected.
+ *
+ *     slot    [ 1:2 0:1 -:3 2:1 ]    (index:generation)
+ *     data    [ A   B   D ]
+ *     back    [ 1   0   3 ]
+ */
+pl_struct( plsm_slot )
+{
+    pl_u32_t index; /**< Item index (or next free slot). */
+    pl_u32_t gen;   /**< Slot generation. */
+};
+pl_struct( plsm )
+{
+    plcm_s    data;  /**< Items. */
+    plcm_s    slot;  /**< Slots (plsm_slot_s). */
+    plcm_s    back;  /**< Slot index for each item. */
+    pl_u32_t  free;  /**< Free slot chain (slot index + 1). */
+    pl_size_t isize; /**< Item size. */
+};
+
+
+/**
+ * Gap Buffer.
+ *
+ * Content is stored to plcm in two parts, with a gap in between. Gap
+ * is moved to the edit position, and edits at the gap don't move the
+ * rest of the content. Hence clustered edits are cheap.
+ *
+ *                  gpos  gend
+ *                 /     /
+ *     data  [ +++++-----+++ ]
+ */
+pl_struct( plgb )
+{
+    plcm_s    plcm; /**< Storage. */
+    pl_size_t gpos; /**< Gap start. */
+    pl_size_t gend; /**< Gap end. */
+};
+
+
+/**
+ * Rope of data.
+ *
+ * Rope is a balanced binary tree (treap) of data chunks. In-order
+ * traversal of the tree gives the content. Each node has a chunk of
+ * data, and is a Block from host plbm (as pllu nodes). Node includes
+ * the content length of its subtree, hence position is found in
+ * logarithmic time. Adjacent chunks are combined at edits when they
+ * fit into one node, hence chunks stay at least half full on average.
+ *
+ *               [de]
+ *              /    \
+ *          [abc]    [fgh]
+ */
+pl_struct_type( plro_node );
+pl_struct_body( plro_node )
+{
+    plro_node_t left;      /**< Left subtree. */
+    plro_node_t right;     /**< Right subtree. */
+    pl_size_t   length;    /**< Subtree content length. */
+    pl_u32_t    prio;      /**< Node priority (heap order). */
+    pl_u32_t    used;      /**< Used byte count. */
+    uint8_t     data[ 0 ]; /**< Data location. */
+};
+pl_struct( plro )
+{
+    plbm_t      host; /**< Host allocator. */
+    plro_node_t root; /**< Root node. */
+    pl_size_t   capa; /**< Node byte capacity. */
+    pl_u32_t    seed; /**< Node priority generator state. */
+};
+pl_struct( plro_cursor )
+{
+    plro_t    plro; /**< Plro. */
+    pl_size_t pos;  /**< Content position. */
+};
+
+
+/**
+ * Ring Buffer of items.
+ *
+ * Items are stored to plcm circularly, hence items are added and
+ * removed at both ends without moving the other items.
+ *
+ *            tail     head
+ *           /        /
+ *     data  [ ++---+++ ]
+ */
+pl_struct( plrb )
+{
+    plcm_s    plcm;  /**< Storage. */
+    pl_size_t head;  /**< Index of first item in storage. */
+    pl_size_t count; /**< Item count. */
+    pl_size_t isize; /**< Item size. */
+};
+
+
 
 /* ------------------------------------------------------------
  * Access macros with type abstraction.
@@ -424,13 +799,16 @@ pl_struct( pllu_cursor )
 
 #define pllu_store_for_type( pllu, type ) pllu_store( ( pllu ), sizeof( type ) )
 
-#define PLAM_NULL_INIT { NULL, 0, PL_AA_SELF, NULL }
+#define PLAM_MARK_NULL_INIT { NULL, 0, NULL }
+#define PLAM_MARK_NULL ( plam_mark_s ) PLAM_MARK_NULL_INIT
+
+#define PLAM_NULL_INIT { NULL, 0, PL_AA_SELF, 0, NULL, 0, NULL, 0, PLAM_MARK_NULL_INIT }
 #define PLAM_NULL ( plam_s ) PLAM_NULL_INIT
 
-#define PLBM_NULL_INIT { NULL, NULL, 0, 0, 0, PL_AA_SELF, NULL }
+#define PLBM_NULL_INIT { NULL, NULL, 0, 0, 0, 0, PL_AA_SELF, NULL, 0, 0 }
 #define PLBM_NULL ( plbm_s ) PLBM_NULL_INIT
 
-#define PLCM_NULL_INIT { NULL, 0, 0, PL_AA_SELF }
+#define PLCM_NULL_INIT { NULL, 0, 0, PL_AA_SELF, 0, 0, 0, PL_GP_DOUBLE, 0, NULL }
 #define PLCM_NULL ( plcm_s ) PLCM_NULL_INIT
 
 #define PLSR_NULL_INIT { NULL, 0 }
@@ -492,6 +870,17 @@ pl_t pl_alloc_aligned( pl_size_t size, pl_size_t align );
 pl_t pl_alloc_only( pl_size_t size );
 
 
+/**
+ * @brief Allocate memory from heap (non-zeroed) and aligned.
+ *
+ * @param size  Allocation size in bytes.
+ * @param align Alignment as byte size.
+ *
+ * @return Pointer to allocation, or NULL.
+ */
+pl_t pl_alloc_aligned_only( pl_size_t size, pl_size_t align );
+
+
 /**
  * @brief Deallocate heap memory.
  *
@@ -584,6 +973,22 @@ pl_none plam_new( plam_t plam, pl_size_t size );
 pl_none plam_new_aligned( plam_t plam, pl_size_t size, pl_size_t align );
 
 
+/**
+ * @brief Create plam with mapped (mmap) Nodes (with debt).
+ *
+ * Node size is rounded up to page size (or huge page size with
+ * PL_MF_HUGETLB). With PL_MF_POPULATE, the pages of each Node are
+ * prefaulted at Node creation.
+ *
+ * @param plam  Plam handle.
+ * @param size  Node size.
+ * @param flags Mapping flags (PL_MF_*).
+ *
+ * @return None.
+ */
+pl_none plam_new_mmap( plam_t plam, pl_size_t size, pl_size_t flags );
+
+
 /**
  * @brief Initiate plam to node (no debt for first node).
  *
@@ -622,6 +1027,10 @@ pl_none plam_use_plbm( plam_t plam, plbm_t host );
 /**
  * @brief Deploy plam inside plam (no debt for nested).
  *
+ * Host position is marked at creation, and plam_del() rewinds the
+ * host back to the mark. Hence all host allocations after creation
+ * are released, as with a stack of arenas.
+ *
  * @param plam Nested plam handle.
  * @param host Plam handle.
  * @param size Node size.
@@ -642,6 +1051,19 @@ pl_none plam_into_plam( plam_t plam, plam_t host, pl_size_t size );
 pl_none plam_into_plbm( plam_t plam, plbm_t host );
 
 
+/**
+ * @brief Deploy plam to plnd (no debt for nested).
+ *
+ * Node size is inherited from plnd.
+ *
+ * @param plam Nested plam handle.
+ * @param host Plnd handle.
+ *
+ * @return None.
+ */
+pl_none plam_into_plnd( plam_t plam, plnd_t host );
+
+
 /**
  * @brief Create empty plam for heap allocations.
  *
@@ -673,12 +1095,29 @@ pl_none plam_empty( plam_t plam, pl_size_t size );
 pl_none plam_empty_aligned( plam_t plam, pl_size_t size, pl_size_t align );
 
 
+/**
+ * @brief Create empty plam for mapped (mmap) Nodes.
+ *
+ * Empty plam is a placeholder with handle setup for allocations.
+ * However, no mappings are made at creation, i.e. this allows lazy
+ * behavior.
+ *
+ * @param plam  Plam handle.
+ * @param size  Node size.
+ * @param flags Mapping flags (PL_MF_*).
+ *
+ * @return None.
+ */
+pl_none plam_empty_mmap( plam_t plam, pl_size_t size, pl_size_t flags );
+
+
 /**
  * @brief Create empty nested plam for plam allocations.
  *
  * Empty plam is a placeholder with handle setup for allocations.
  * However, no host allocations are made at creation, i.e. this allows
- * lazy behavior.
+ * lazy behavior. Host position is marked at creation, as with
+ * plam_into_plam().
  *
  * @param plam Plam handle.
  * @param host Plam handle.
@@ -704,6 +1143,81 @@ pl_none plam_empty_into_plam( plam_t plam, plam_t host, pl_size_t size );
 pl_none plam_empty_into_plbm( plam_t plam, plbm_t host );
 
 
+/**
+ * @brief Create empty nested plam for plnd allocations.
+ *
+ * Empty plam is a placeholder with handle setup for allocations.
+ * However, no host allocations are made at creation, i.e. this allows
+ * lazy behavior.
+ *
+ * @param plam Plam handle.
+ * @param host Plnd handle.
+ *
+ * @return None.
+ */
+pl_none plam_empty_into_plnd( plam_t plam, plnd_t host );
+
+
+/**
+ * @brief Set Node size growth limit for plam.
+ *
+ * Each new Node is double the size of the previous Node, until the
+ * limit is reached. Limit of 0 (default) keeps the Node size fixed.
+ *
+ * Growth is ignored for plbm and plnd hosts, since their Node size is
+ * fixed.
+ *
+ * @param plam  Plam handle.
+ * @param limit Maximum Node size.
+ *
+ * @return None.
+ */
+pl_none plam_grow( plam_t plam, pl_size_t limit );
+
+
+/**
+ * @brief Set zeroing of heap allocated Nodes for plam.
+ *
+ * Nodes are zeroed by default. Zeroing can be skipped, when the
+ * allocations are always overwritten by the user. Setting applies to
+ * Nodes allocated after the call, hence empty plam (e.g. plam_empty())
+ * is used to cover also the first Node.
+ *
+ * @param plam    Plam handle.
+ * @param zeroing Zero Nodes, if true.
+ *
+ * @return None.
+ */
+pl_none plam_set_zeroing( plam_t plam, pl_bool_t zeroing );
+
+
+/**
+ * @brief Return thread local plam for plnd.
+ *
+ * Each thread has its own plam, which is created (empty) at first
+ * call. All Nodes are from the plnd and they are returned to the plnd
+ * when the thread exits, or with plam_local_del().
+ *
+ * If the thread local plam is attached to another plnd, it is
+ * deleted and re-attached to the given plnd.
+ *
+ * @param host Plnd handle.
+ *
+ * @return Thread local plam.
+ */
+plam_t plam_local( plnd_t host );
+
+
+/**
+ * @brief Delete thread local plam.
+ *
+ * Nodes are returned to the plnd.
+ *
+ * @return None.
+ */
+pl_none plam_local_del( pl_none );
+
+
 /**
  * @brief Delete plam.
  *
@@ -717,15 +1231,48 @@ pl_none plam_empty_into_plbm( plam_t plam, plbm_t host );
 pl_none plam_del( plam_t plam );
 
 
+/**
+ * @brief Get allocation from plam (slow path of plam_get()).
+ *
+ * Used when the current Node can't serve the allocation, i.e. new
+ * Node is taken or allocated.
+ *
+ * @param plam Plam handle.
+ * @param size Allocation size.
+ *
+ * @return Allocation.
+ */
+pl_t plam_get_slow( plam_t plam, pl_size_t size );
+
+
 /**
  * @brief Get allocation from plam.
  *
+ * Allocation that does not fit into the largest Node gets a dedicated
+ * (oversize) Node. Oversize Nodes are released with plam_put(),
+ * plam_rewind(), plam_clear(), and plam_del(). Plbm and plnd hosts
+ * can't provide oversize Nodes, and then NULL is returned. Plam host
+ * is bypassed, and oversize Nodes are taken from heap.
+ *
  * @param plam Plam handle.
  * @param size Allocation size.
  *
  * @return Allocation.
  */
-pl_t plam_get( plam_t plam, pl_size_t size );
+static inline pl_t plam_get( plam_t plam, pl_size_t size )
+{
+    pl_node_t node;
+    pl_t      ret;
+
+    node = plam->node;
+    if ( node && ( node->size - sizeof( pl_node_s ) - node->used ) >= size ) {
+        ret = node->data + node->used;
+        node->used += size;
+        return ret;
+    } else {
+        return plam_get_slow( plam, size );
+    }
+}
 
 
 /**
@@ -757,7 +1304,7 @@ pl_none plam_put( plam_t plam, pl_size_t size );
 /**
  * @brief Clear all allocations in plam.
  *
- * NOTE: Memory is not deallocated.
+ * NOTE: Memory is not deallocated, except for oversize Nodes.
  *
  * @param plam Plam handle.
  *
@@ -767,19 +1314,67 @@ pl_none plam_clear( plam_t plam );
 
 
 /**
- * @brief Get allocation from plam and store the data.
+ * @brief Delete unused Nodes after the current Node.
  *
- * @param plam Plam handle.
- * @param data Data to store.
- * @param size Allocation size.
+ * Nodes are kept as warm reserve, if they are within count Nodes or
+ * within size bytes (whichever keeps more). Deleted Nodes are returned
+ * to the host (if any). Plam host releases only its last allocation,
+ * hence Nodes below later host allocations are kept.
  *
- * @return Pointer to stored data.
+ * @param plam  Plam handle.
+ * @param count Number of Nodes to keep.
+ * @param size  Bytes (of Nodes) to keep.
+ *
+ * @return None.
  */
-pl_t plam_store( plam_t plam, const pl_t data, pl_size_t size );
+pl_none plam_trim( plam_t plam, pl_size_t count, pl_size_t size );
 
 
 /**
- * @brief Get allocation from plam and store pointer value to it.
+ * @brief Mark current position of plam.
+ *
+ * Mark can be used to rewind plam back to the position, i.e. all the
+ * allocations after mark are released at once.
+ *
+ * @param plam Plam handle.
+ *
+ * @return Mark.
+ */
+plam_mark_s plam_mark( plam_t plam );
+
+
+/**
+ * @brief Rewind plam to marked position.
+ *
+ * All allocations done after the mark are released. Rewind is
+ * performed in a single step regardless of the number of allocations
+ * or Nodes after the mark. Marks taken after the given mark become
+ * invalid.
+ *
+ * NOTE: Memory is not deallocated, except for oversize Nodes.
+ *
+ * @param plam Plam handle.
+ * @param mark Mark from plam_mark().
+ *
+ * @return None.
+ */
+pl_none plam_rewind( plam_t plam, plam_mark_s mark );
+
+
+/**
+ * @brief Get allocation from plam and store the data.
+ *
+ * @param plam Plam handle.
+ * @param data Data to store.
+ * @param size Allocation size.
+ *
+ * @return Pointer to stored data.
+ */
+pl_t plam_store( plam_t plam, const pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Get allocation from plam and store pointer value to it.
  *
  * @param plam Plam handle.
  * @param ptr  Pointer value.
@@ -835,6 +1430,8 @@ pl_size_t plam_used( plam_t plam );
 /**
  * @brief Free memory in current node.
  *
+ * Nodes of growing plam have different sizes.
+ *
  * @param plam Plam handle.
  *
  * @return Free memory.
@@ -845,6 +1442,8 @@ pl_size_t plam_free( plam_t plam );
 /**
  * @brief Return node size.
  *
+ * For growing plam, this is the size of the latest Node.
+ *
  * @param plam Plam handle.
  *
  * @return Node size.
@@ -873,6 +1472,71 @@ pl_bool_t plam_is_empty( plam_t plam );
 
 
 
+/* ------------------------------------------------------------
+ * Arena Shared Memory Allocator:
+ */
+
+/**
+ * @brief Create plas in heap (with debt).
+ *
+ * NOTE: empty plas is setup if size is too small.
+ *
+ * @param plas Plas handle.
+ * @param size Node size.
+ *
+ * @return None.
+ */
+pl_none plas_new( plas_t plas, pl_size_t size );
+
+
+/**
+ * @brief Delete plas.
+ *
+ * Delete must not be called concurrently with allocations.
+ *
+ * @param plas Plas handle.
+ *
+ * @return None.
+ */
+pl_none plas_del( plas_t plas );
+
+
+/**
+ * @brief Get allocation from plas.
+ *
+ * Allocation can be performed concurrently from multiple threads.
+ *
+ * @param plas Plas handle.
+ * @param size Allocation size.
+ *
+ * @return Allocation, or NULL.
+ */
+pl_t plas_get( plas_t plas, pl_size_t size );
+
+
+/**
+ * @brief Get allocation from plas and store the data.
+ *
+ * @param plas Plas handle.
+ * @param data Data to store.
+ * @param size Allocation size.
+ *
+ * @return Pointer to stored data.
+ */
+pl_t plas_store( plas_t plas, const pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Return node capacity.
+ *
+ * @param plas Plas handle.
+ *
+ * @return Node capacity.
+ */
+pl_size_t plas_node_capacity( plas_t plas );
+
+
+
 /* ------------------------------------------------------------
  * Block Memory Allocator:
  */
@@ -901,6 +1565,37 @@ pl_none plbm_new( plbm_t plbm, pl_size_t nsize, pl_size_t bsize );
 pl_none plbm_new_with_count( plbm_t plbm, pl_size_t bcount, pl_size_t bsize );
 
 
+/**
+ * @brief Create plbm in heap (with debt), with Block alignment.
+ *
+ * Block size is padded to multiple of alignment.
+ *
+ * @param plbm  Plbm handle.
+ * @param nsize Node size.
+ * @param bsize Block size.
+ * @param align Alignment (power of two).
+ *
+ * @return None.
+ */
+pl_none plbm_new_aligned( plbm_t plbm, pl_size_t nsize, pl_size_t bsize, pl_size_t align );
+
+
+/**
+ * @brief Create plbm with mapped (mmap) Nodes (with debt).
+ *
+ * Node size is rounded up to page size (or huge page size with
+ * PL_MF_HUGETLB).
+ *
+ * @param plbm  Plbm handle.
+ * @param nsize Node size.
+ * @param bsize Block size.
+ * @param flags Mapping flags (PL_MF_*).
+ *
+ * @return None.
+ */
+pl_none plbm_new_mmap( plbm_t plbm, pl_size_t nsize, pl_size_t bsize, pl_size_t flags );
+
+
 /**
  * @brief Initiate plbm to node (no debt for first node).
  *
@@ -954,6 +1649,23 @@ pl_none plbm_use_plbm( plbm_t plbm, plbm_t host, pl_size_t bsize );
 pl_none plbm_into_plam( plbm_t plbm, plam_t host, pl_size_t nsize, pl_size_t bsize );
 
 
+/**
+ * @brief Deploy plbm inside plam (no debt for nested), with Block alignment.
+ *
+ * Block size is padded to multiple of alignment.
+ *
+ * @param plbm  Nested plbm handle.
+ * @param host  Plam handle.
+ * @param nsize Node size.
+ * @param bsize Block size.
+ * @param align Alignment (power of two).
+ *
+ * @return None.
+ */
+pl_none plbm_into_plam_aligned(
+    plbm_t plbm, plam_t host, pl_size_t nsize, pl_size_t bsize, pl_size_t align );
+
+
 /**
  * @brief Deploy plbm inside plbm (no debt for nested).
  *
@@ -968,6 +1680,22 @@ pl_none plbm_into_plam( plbm_t plbm, plam_t host, pl_size_t nsize, pl_size_t bsi
 pl_none plbm_into_plbm( plbm_t plbm, plbm_t host, pl_size_t bsize );
 
 
+/**
+ * @brief Deploy plbm inside plbm (no debt for nested), with Block alignment.
+ *
+ * Node size is inherited from host block size. Block size is padded
+ * to multiple of alignment.
+ *
+ * @param plbm  Nested plbm handle.
+ * @param host  Plbm handle.
+ * @param bsize Block size.
+ * @param align Alignment (power of two).
+ *
+ * @return None.
+ */
+pl_none plbm_into_plbm_aligned( plbm_t plbm, plbm_t host, pl_size_t bsize, pl_size_t align );
+
+
 /**
  * @brief Create empty plbm.
  *
@@ -1018,6 +1746,21 @@ pl_none plbm_empty_into_plam( plbm_t plbm, plam_t host, pl_size_t nsize, pl_size
 pl_none plbm_empty_into_plbm( plbm_t plbm, plbm_t host, pl_size_t bsize );
 
 
+/**
+ * @brief Set zeroing of heap allocated Nodes for plbm.
+ *
+ * Nodes are zeroed by default. Setting applies to Nodes allocated
+ * after the call, hence empty plbm (e.g. plbm_empty()) is used to
+ * cover also the first Node.
+ *
+ * @param plbm    Plbm handle.
+ * @param zeroing Zero Nodes, if true.
+ *
+ * @return None.
+ */
+pl_none plbm_set_zeroing( plbm_t plbm, pl_bool_t zeroing );
+
+
 /**
  * @brief Delete plbm.
  *
@@ -1031,6 +1774,19 @@ pl_none plbm_empty_into_plbm( plbm_t plbm, plbm_t host, pl_size_t bsize );
 pl_none plbm_del( plbm_t plbm );
 
 
+/**
+ * @brief Get allocation from plbm (slow path of plbm_get()).
+ *
+ * Used when there are no free Blocks in the current Node, i.e. new
+ * Node is taken or allocated.
+ *
+ * @param plbm Plbm handle.
+ *
+ * @return Allocation.
+ */
+pl_t plbm_get_slow( plbm_t plbm );
+
+
 /**
  * @brief Get allocation from plbm.
  *
@@ -1038,7 +1794,23 @@ pl_none plbm_del( plbm_t plbm );
  *
  * @return Allocation.
  */
-pl_t plbm_get( plbm_t plbm );
+static inline pl_t plbm_get( plbm_t plbm )
+{
+    pl_t ret;
+
+    if ( plbm->head ) {
+        ret = plbm->head;
+        plbm->head = *( (pl_t*)ret );
+        return ret;
+    } else if ( plbm->itail > 0 && plbm->node ) {
+        ret = (pl_t)( ( (pl_size_t)plbm->node->data + plbm->amask ) & ~plbm->amask )
+              + ( ( plbm->imax - plbm->itail ) * plbm->bsize );
+        plbm->itail--;
+        return ret;
+    } else {
+        return plbm_get_slow( plbm );
+    }
+}
 
 
 /**
@@ -1049,7 +1821,52 @@ pl_t plbm_get( plbm_t plbm );
  *
  * @return None.
  */
-pl_none plbm_put( plbm_t plbm, pl_t block );
+static inline pl_none plbm_put( plbm_t plbm, pl_t block )
+{
+    *( (pl_t*)block ) = plbm->head;
+    plbm->head = block;
+}
+
+
+/**
+ * @brief Get count Blocks from plbm to array.
+ *
+ * @param plbm   Plbm handle.
+ * @param blocks Array for Blocks.
+ * @param count  Block count.
+ *
+ * @return Number of Blocks got.
+ */
+pl_size_t plbm_get_n( plbm_t plbm, pl_t* blocks, pl_size_t count );
+
+
+/**
+ * @brief Get count Blocks from plbm as chain.
+ *
+ * Blocks are linked through their first element (pointer), and the
+ * last Block points to NULL.
+ *
+ * @param plbm  Plbm handle.
+ * @param count Block count.
+ *
+ * @return First Block of chain.
+ */
+pl_t plbm_get_chain( plbm_t plbm, pl_size_t count );
+
+
+/**
+ * @brief Put chain of Blocks back to plbm.
+ *
+ * Blocks must be linked through their first element (pointer). Chain
+ * is spliced to the free Blocks at once.
+ *
+ * @param plbm  Plbm handle.
+ * @param first First Block of chain.
+ * @param last  Last Block of chain.
+ *
+ * @return None.
+ */
+pl_none plbm_put_chain( plbm_t plbm, pl_t first, pl_t last );
 
 
 /**
@@ -1064,6 +1881,44 @@ pl_none plbm_put( plbm_t plbm, pl_t block );
 pl_none plbm_clear( plbm_t plbm );
 
 
+/**
+ * @brief Delete unused Nodes after the current Node.
+ *
+ * Nodes are kept as warm reserve, if they are within count Nodes or
+ * within size bytes (whichever keeps more). Deleted Nodes are returned
+ * to the host (if any). Plam host releases only its last allocation,
+ * hence Nodes below later host allocations are kept.
+ *
+ * @param plbm  Plbm handle.
+ * @param count Number of Nodes to keep.
+ * @param size  Bytes (of Nodes) to keep.
+ *
+ * @return None.
+ */
+pl_none plbm_trim( plbm_t plbm, pl_size_t count, pl_size_t size );
+
+
+/**
+ * @brief Release Nodes, which have no allocated Blocks.
+ *
+ * Live Block count of each Node is computed (to Node used) from the
+ * free Block chain. Blocks of free Nodes are removed from the chain,
+ * and the Nodes are returned to the host (if any). Plam host can't
+ * take Nodes out of order, hence its Nodes are moved after the current
+ * Node, for reuse. The first Node of plbm_use() (user memory) and the
+ * current Node are kept, and they are not counted.
+ *
+ * Nodes are sorted and each free Block is searched from them, hence
+ * the cost is O(F log F) per call, where F is the number of free
+ * Blocks and Nodes.
+ *
+ * @param plbm Plbm handle.
+ *
+ * @return Number of free Nodes released (or moved for reuse).
+ */
+pl_size_t plbm_reclaim( plbm_t plbm );
+
+
 /**
  * @brief
  *
@@ -1177,1854 +2032,3275 @@ pl_bool_t plbm_is_empty( plbm_t plbm );
 
 
 /* ------------------------------------------------------------
- * Continuous Memory Allocator:
+ * Block Bitmap Allocator:
  */
 
 /**
- * @brief Create plcm in heap (with debt).
+ * @brief Create plbb in heap (with debt).
  *
- * @param plcm Plcm handle.
- * @param size Allocation size.
+ * NOTE: Node size is rounded up to power of two.
  *
- * @return Plcm handle.
+ * @param plbb  Plbb handle.
+ * @param nsize Node size.
+ * @param bsize Block size.
+ *
+ * @return None.
  */
-plcm_t plcm_new( plcm_t plcm, pl_size_t size );
+pl_none plbb_new( plbb_t plbb, pl_size_t nsize, pl_size_t bsize );
 
 
 /**
- * @brief Create plcm in heap (with debt) for pointers.
+ * @brief Delete plbb.
  *
- * @param plcm Plcm handle.
- * @param size Allocation size for number pointers.
+ * @param plbb Plbb handle.
  *
- * @return Plcm handle.
+ * @return None.
  */
-plcm_t plcm_new_ptr( plcm_t plcm, pl_size_t size );
+pl_none plbb_del( plbb_t plbb );
 
 
 /**
- * @brief Create plcm to pre-existing allocation (no debt).
+ * @brief Get allocation from plbb.
  *
- * @param plcm Plcm handle.
- * @param mem  Allocation.
- * @param size Size of allocation.
+ * Allocation is the first free Block in the current Node.
  *
- * @return Plcm handle.
+ * @param plbb Plbb handle.
+ *
+ * @return Allocation, or NULL.
  */
-plcm_t plcm_use( plcm_t plcm, pl_t mem, pl_size_t size );
+pl_t plbb_get( plbb_t plbb );
 
 
 /**
- * @brief Initiate nested plcm from plam (no debt).
+ * @brief Put allocation back to plbb.
  *
- * @param plcm Nested plcm handle.
- * @param host Plam handle.
- * @param size Allocation size.
+ * Node (other than current) is released, when it has no allocated
+ * Blocks.
  *
- * @return Plcm handle.
+ * @param plbb  Plbb handle.
+ * @param block Block to return.
+ *
+ * @return None.
  */
-plcm_t plcm_use_plam( plcm_t plcm, plam_t host, pl_size_t size );
+pl_none plbb_put( plbb_t plbb, pl_t block );
 
 
 /**
- * @brief Initiate nested plcm from plbm (no debt).
+ * @brief Clear all allocations in plbb.
  *
- * @param plcm Nested plcm handle.
- * @param host Plbm handle.
+ * NOTE: Memory is not deallocated.
  *
- * @return Plcm handle.
+ * @param plbb Plbb handle.
+ *
+ * @return None.
  */
-plcm_t plcm_use_plbm( plcm_t plcm, plbm_t host );
+pl_none plbb_clear( plbb_t plbb );
 
 
 /**
- * @brief Create empty plcm.
+ * @brief Return node capacity (Block count).
  *
- * Empty plcm is a placeholder with handle setup for allocations.
- * However, no heap allocations are made at creation.
+ * @param plbb Plbb handle.
  *
- * @param plcm Plcm handle.
- * @param size Allocation size (for future).
+ * @return Block count.
+ */
+pl_size_t plbb_node_capacity( plbb_t plbb );
+
+
+/**
+ * @brief Return Block size.
  *
- * @return Plcm handle.
+ * @param plbb Plbb handle.
+ *
+ * @return Block size.
  */
-plcm_t plcm_empty( plcm_t plcm, pl_size_t size );
+pl_size_t plbb_block_size( plbb_t plbb );
+
+
 
+/* ------------------------------------------------------------
+ * Block Handle Allocator:
+ */
 
 /**
- * @brief Create empty plcm for pointers.
+ * @brief Create plbh in heap (with debt).
  *
- * Empty plcm is a placeholder with handle setup for allocations.
- * However, no heap allocations are made at creation.
+ * Block size must fit a handle. Block count in Node is rounded up to
+ * power of two.
  *
- * @param plcm Plcm handle.
- * @param size Allocation size (for future) for pointers.
+ * @param plbh   Plbh handle.
+ * @param bcount Block count in Node.
+ * @param bsize  Block size.
  *
- * @return Plcm handle.
+ * @return None.
  */
-plcm_t plcm_empty_ptr( plcm_t plcm, pl_size_t size );
+pl_none plbh_new( plbh_t plbh, pl_size_t bcount, pl_size_t bsize );
 
 
 /**
- * Convert Plcm to Plcm Shadow.
+ * @brief Delete plbh.
  *
- * @param plcm Plcm handle.
+ * @param plbh Plbh handle.
  *
- * @return Shadow, referencing the host.
+ * @return None.
  */
-plcm_s plcm_shadow( plcm_t plcm );
+pl_none plbh_del( plbh_t plbh );
 
 
 /**
- * Copy Plcm content to given target.
+ * @brief Get allocation from plbh.
  *
- * @param plcm   Plcm handle to copy from.
- * @param target Target plcm handle.
- * @param mem    Memory for copy.
- * @param size   Memory size for copy storage.
+ * @param plbh Plbh handle.
  *
- * @return Copy.
+ * @return Block handle, or zero.
  */
-pl_none plcm_copy_to( plcm_t plcm, plcm_t target, pl_t mem, pl_size_t size );
+pl_bh_t plbh_get( plbh_t plbh );
 
 
 /**
- * Copy Plcm content and dimensions.
+ * @brief Put allocation back to plbh.
  *
- * @param plcm Plcm handle.
+ * @param plbh   Plbh handle.
+ * @param handle Block handle.
  *
- * @return Copy.
+ * @return None.
  */
-plcm_s plcm_copy( plcm_t plcm );
+pl_none plbh_put( plbh_t plbh, pl_bh_t handle );
 
 
 /**
- * @brief Delete plcm.
- *
- * If plcm has debt, then the heap memory is deallocated. If plcm has
- * no debt, deletion is mute.
+ * @brief Return Block address of handle.
  *
- * @param plcm Plcm handle.
+ * @param plbh   Plbh handle.
+ * @param handle Block handle.
  *
- * @return NULL.
+ * @return Block address.
  */
-plcm_t plcm_del( plcm_t plcm );
+static inline pl_t plbh_ref( plbh_t plbh, pl_bh_t handle )
+{
+    pl_size_t index;
+
+    index = (pl_size_t)handle - 1;
+    return ( (pl_node_t*)plbh->table.data )[ index >> plbh->shift ]->data
+           + ( index & ( ( (pl_size_t)1 << plbh->shift ) - 1 ) ) * plbh->bsize;
+}
 
 
 /**
- * @brief Resize plcm allocation.
+ * @brief Clear all allocations in plbh.
  *
- * @param plcm Plcm handle.
- * @param size New allocation size.
+ * NOTE: Memory is not deallocated.
+ *
+ * @param plbh Plbh handle.
  *
  * @return None.
  */
-pl_none plcm_resize( plcm_t plcm, pl_size_t size );
+pl_none plbh_clear( plbh_t plbh );
 
 
 /**
- * @brief Resize plcm allocation by increase.
+ * @brief Return Block size.
  *
- * @param plcm Plcm handle.
- * @param size Allocation size increase.
+ * @param plbh Plbh handle.
  *
- * @return None.
+ * @return Block size.
  */
-pl_none plcm_increase( plcm_t plcm, pl_size_t size );
+pl_size_t plbh_block_size( plbh_t plbh );
 
 
-/**
- * @brief Ensure that (future) value fits.
- *
- * @param plcm Plcm handle.
- * @param size Value (increment) size.
- *
- * @return Location for value storage.
- */
-pl_t plcm_ensure( plcm_t plcm, pl_size_t size );
 
+/* ------------------------------------------------------------
+ * Block Shared Memory Allocator:
+ */
 
 /**
- * @brief Compact plcm allocation to minimum size.
+ * @brief Create plbs in heap (with debt).
  *
- * @param plcm Plcm handle.
+ * @param plbs  Plbs handle.
+ * @param nsize Node size.
+ * @param bsize Block size.
  *
  * @return None.
  */
-pl_none plcm_compact( plcm_t plcm );
+pl_none plbs_new( plbs_t plbs, pl_size_t nsize, pl_size_t bsize );
 
 
 /**
- * @brief Get allocation from plcm as position.
+ * @brief Delete plbs.
  *
- * Position is an offset to data start.
+ * Delete must not be called concurrently with allocations.
  *
- * @param plcm Plcm handle.
- * @param size Allocation size.
+ * @param plbs Plbs handle.
  *
- * @return Allocation position.
+ * @return None.
  */
-pl_pos_t plcm_get_pos( plcm_t plcm, pl_size_t size );
+pl_none plbs_del( plbs_t plbs );
 
 
 /**
- * @brief Get allocation from plcm as pointer reference.
+ * @brief Get allocation from plbs.
  *
- * @param plcm Plcm handle.
- * @param size Allocation size.
+ * Allocation can be performed concurrently from multiple threads.
  *
- * @return Allocation reference.
+ * @param plbs Plbs handle.
+ *
+ * @return Allocation, or NULL.
  */
-pl_t plcm_get_ref( plcm_t plcm, pl_size_t size );
+pl_t plbs_get( plbs_t plbs );
 
 
 /**
- * @brief Put allocation back to plcm.
+ * @brief Put allocation back to plbs.
  *
- * User is responsible in making the puts in reserver order with
- * correct sizes.
+ * Deallocation can be performed concurrently from multiple threads.
  *
- * @param plcm Plcm handle.
- * @param size Allocation size.
+ * @param plbs  Plbs handle.
+ * @param block Block to return.
  *
  * @return None.
  */
-pl_none plcm_put( plcm_t plcm, pl_size_t size );
+pl_none plbs_put( plbs_t plbs, pl_t block );
 
 
 /**
- * @brief Get allocation from plcm and store value to it.
+ * @brief Return Block size.
  *
- * @param plcm Plcm handle.
- * @param data Data to store.
- * @param size Allocation and data size.
+ * @param plbs Plbs handle.
  *
- * @return Allocation position.
+ * @return Block size.
  */
-pl_pos_t plcm_store( plcm_t plcm, pl_t data, pl_size_t size );
+pl_size_t plbs_block_size( plbs_t plbs );
+
 
 
+/* ------------------------------------------------------------
+ * Block Magazine Allocator:
+ */
+
 /**
- * @brief Get allocation from plcm and store pointer value to it.
+ * @brief Create plmd (Magazine Depot) in heap (with debt).
  *
- * @param plcm Plcm handle.
- * @param ptr  Pointer value.
+ * @param plmd  Plmd handle.
+ * @param nsize Node size.
+ * @param bsize Block size.
+ * @param msize Magazine size (Block count).
  *
- * @return Allocation position.
+ * @return None.
  */
-pl_pos_t plcm_store_ptr( plcm_t plcm, pl_t ptr );
+pl_none plmd_new( plmd_t plmd, pl_size_t nsize, pl_size_t bsize, pl_size_t msize );
 
 
 /**
- * @brief Get allocation from plcm and store null pointer value to it.
+ * @brief Delete plmd.
  *
- * Storage is resized, but the used count is not changed.
+ * All Magazines must be deleted or flushed before.
  *
- * @param plcm Plcm handle.
+ * @param plmd Plmd handle.
+ *
+ * @return None.
  */
-pl_none plcm_store_null( plcm_t plcm );
+pl_none plmd_del( plmd_t plmd );
 
 
 /**
- * @brief Reference allocation from plcm.
+ * @brief Return Block size.
  *
- * @param plcm Plcm handle.
- * @param pos  Allocation position.
+ * @param plmd Plmd handle.
  *
- * @return Allocation reference.
+ * @return Block size.
  */
-pl_t plcm_ref( plcm_t plcm, pl_pos_t pos );
+pl_size_t plmd_block_size( plmd_t plmd );
 
 
 /**
- * @brief Reference pointer allocation from plcm.
+ * @brief Create plmg (Magazine) for plmd.
  *
- * @param plcm Plcm handle.
- * @param pos  Pointer position.
+ * Magazine is owned by a single thread, i.e. each thread creates
+ * its own Magazine for the shared plmd.
  *
- * @return Pointer value.
+ * @param plmg Plmg handle.
+ * @param plmd Plmd handle.
+ *
+ * @return True if success.
  */
-pl_t plcm_ref_ptr( plcm_t plcm, pl_pos_t pos );
+pl_bool_t plmg_new( plmg_t plmg, plmd_t plmd );
 
 
 /**
- * @brief Set value for data.
+ * @brief Delete plmg.
  *
- * @param plcm Plcm handle.
- * @param pos  Allocation position.
- * @param data Address of data to store.
- * @param size Data size.
+ * All cached Blocks are flushed to plmd. Typically called at thread
+ * exit.
+ *
+ * @param plmg Plmg handle.
  *
  * @return None.
  */
-pl_none plcm_set( plcm_t plcm, pl_pos_t pos, const pl_t data, pl_size_t size );
+pl_none plmg_del( plmg_t plmg );
 
 
 /**
- * @brief Set pointer value to pointer position.
+ * @brief Flush all cached Blocks to plmd.
  *
- * @param plcm Plcm handle.
- * @param pos  Pointer position.
- * @param ptr  Pointer value.
+ * @param plmg Plmg handle.
  *
  * @return None.
  */
-pl_none plcm_set_ptr( plcm_t plcm, pl_pos_t pos, const pl_t ptr );
+pl_none plmg_flush( plmg_t plmg );
 
 
 /**
- * @brief Consume allocation for value (in the allocation end position).
- *
- * Use plcm_consume with plcm_ensure. First ensure allocation (with
- * plcm_ensure), then store value(s), and finally report to Plcm the
- * consumed memory, with plcm_consume.
+ * @brief Get allocation from plmg (slow path of plmg_get()).
  *
- * NOTE: Reserve does not perform plcm_resize implicitly. User must
- * ensure that pre-allocation size is sufficient.
+ * Used when the loaded array is empty, i.e. previous is swapped in
+ * or loaded is refilled from plmd.
  *
- * @param plcm Plcm handle.
- * @param size Value size.
+ * @param plmg Plmg handle.
  *
- * @return Start address for value.
+ * @return Allocation, or NULL.
  */
-pl_t plcm_consume( plcm_t plcm, pl_size_t size );
+pl_t plmg_get_slow( plmg_t plmg );
 
 
 /**
- * @brief Pop value from the end.
+ * @brief Get allocation from plmg.
  *
- * @param plcm Plcm handle.
- * @param size Value size.
+ * @param plmg Plmg handle.
  *
- * @return Popped value.
+ * @return Allocation, or NULL.
  */
-pl_t plcm_pop( plcm_t plcm, pl_size_t size );
+static inline pl_t plmg_get( plmg_t plmg )
+{
+    if ( plmg->lcnt > 0 ) {
+        return plmg->load[ --plmg->lcnt ];
+    } else {
+        return plmg_get_slow( plmg );
+    }
+}
 
 
 /**
- * @brief Pop pointer value from the end.
+ * @brief Put allocation back to plmg (slow path of plmg_put()).
  *
- * @param plcm Plcm handle.
+ * Used when the loaded array is full, i.e. previous is swapped in
+ * or flushed to plmd.
  *
- * @return Popped value.
+ * @param plmg  Plmg handle.
+ * @param block Block to return.
+ *
+ * @return None.
  */
-pl_t plcm_pop_ptr( plcm_t plcm );
+pl_none plmg_put_slow( plmg_t plmg, pl_t block );
 
 
 /**
- * @brief Remove data.
+ * @brief Put allocation back to plmg.
  *
- * @param plcm Plcm handle.
- * @param pos  Position of removal.
- * @param size Size of removal.
+ * Block may be from any Magazine of the same plmd.
+ *
+ * @param plmg  Plmg handle.
+ * @param block Block to return.
  *
  * @return None.
  */
-pl_none plcm_remove( plcm_t plcm, pl_pos_t pos, pl_size_t size );
+static inline pl_none plmg_put( plmg_t plmg, pl_t block )
+{
+    if ( plmg->lcnt < plmg->size ) {
+        plmg->load[ plmg->lcnt++ ] = block;
+    } else {
+        plmg_put_slow( plmg, block );
+    }
+}
+
+
 
+/* ------------------------------------------------------------
+ * Slab Memory Allocator:
+ */
 
 /**
- * @brief Remove pointer.
+ * @brief Create plsl.
  *
- * @param plcm Plcm handle.
- * @param pos  Pointer position of removal.
+ * Reservation is address space only, and memory is committed when
+ * Blocks are taken into use.
  *
- * @return None.
+ * @param plsl    Plsl handle.
+ * @param reserve Reservation for each pool (rounded up to power of two).
+ *
+ * @return True if success.
  */
-pl_none plcm_remove_ptr( plcm_t plcm, pl_pos_t pos );
+pl_bool_t plsl_new( plsl_t plsl, pl_size_t reserve );
 
 
 /**
- * @brief Insert data.
+ * @brief Delete plsl.
  *
- * @param plcm Plcm handle.
- * @param pos  Position of insertion.
- * @param data Data to store.
- * @param size Data size.
+ * All allocations, including large, are released.
+ *
+ * @param plsl Plsl handle.
  *
  * @return None.
  */
-pl_none plcm_insert( plcm_t plcm, pl_pos_t pos, pl_t data, pl_size_t size );
+pl_none plsl_del( plsl_t plsl );
 
 
 /**
- * @brief Insert pointer.
+ * @brief Get allocation from plsl.
  *
- * @param plcm Plcm handle.
- * @param pos  Pointer position of insertion.
- * @param ptr  Pointer value.
+ * Allocation is from the pool of the smallest fitting size class,
+ * and it is aligned to PLSL_CLASS_MIN.
  *
- * @return None.
+ * @param plsl Plsl handle.
+ * @param size Allocation size.
+ *
+ * @return Allocation, or NULL.
  */
-pl_none plcm_insert_ptr( plcm_t plcm, pl_pos_t pos, pl_t ptr );
+pl_t plsl_get( plsl_t plsl, pl_size_t size );
 
 
 /**
- * @brief Set terminating value after used data.
+ * @brief Put allocation back to plsl.
  *
- * Use this for any type of NULL termination of continuous data.
+ * Size is not needed, since the owner is found from address. NULL is
+ * ignored.
  *
- * @param plcm Plcm handle.
- * @param size Size of termination.
+ * @param plsl Plsl handle.
+ * @param mem  Allocation to return.
  *
- * @return True, if termination done and fitted.
+ * @return None.
  */
-pl_bool_t plcm_terminate( plcm_t plcm, pl_size_t size );
+pl_none plsl_put( plsl_t plsl, pl_t mem );
 
 
 /**
- * @brief Set terminating value after used data for pointers.
+ * @brief Return usable size of allocation.
  *
- * @param plcm Plcm handle.
+ * @param plsl Plsl handle.
+ * @param mem  Allocation.
  *
- * @return True, if termination done and fitted.
+ * @return Size (size class or large size).
  */
-pl_bool_t plcm_terminate_ptr( plcm_t plcm );
+pl_size_t plsl_size( plsl_t plsl, pl_t mem );
+
 
 
+/* ------------------------------------------------------------
+ * Node Depot:
+ */
+
 /**
- * @brief Reset used data to zero.
+ * @brief Create plnd.
  *
- * @param plcm Plcm handle.
+ * Plnd is a shared storage of free Nodes. Nodes are taken from plnd
+ * and returned to plnd by allocators with PL_AA_PLND affinity. When
+ * plnd is out of Nodes, new Nodes are allocated from heap.
+ *
+ * @param plnd Plnd handle.
+ * @param size Node size.
  *
  * @return None.
  */
-pl_none plcm_reset( plcm_t plcm );
+pl_none plnd_new( plnd_t plnd, pl_size_t size );
 
 
 /**
- * @brief Reset used data to zero and clear data.
+ * @brief Delete plnd.
  *
- * @param plcm Plcm handle.
+ * All free Nodes are deallocated. Nodes in use by allocators must be
+ * returned before deletion.
+ *
+ * @param plnd Plnd handle.
  *
  * @return None.
  */
-pl_none plcm_clear( plcm_t plcm );
+pl_none plnd_del( plnd_t plnd );
 
 
 /**
- * @brief Used memory size.
+ * @brief Reserve free Nodes to plnd.
  *
- * @param plcm Plcm handle.
+ * @param plnd  Plnd handle.
+ * @param count Minimum number of free Nodes.
  *
- * @return Used memory.
+ * @return Free Node count.
  */
-pl_size_t plcm_used( plcm_t plcm );
+pl_size_t plnd_reserve( plnd_t plnd, pl_size_t count );
 
 
 /**
- * @brief Used memory size as pointer count.
+ * @brief Get Node from plnd.
  *
- * @param plcm Plcm handle.
+ * @param plnd Plnd handle.
  *
- * @return Used memory as number of pointers.
+ * @return Node, or NULL.
  */
-pl_size_t plcm_used_ptr( plcm_t plcm );
+pl_t plnd_get( plnd_t plnd );
 
 
 /**
- * @brief Allocated memory size.
+ * @brief Put Node back to plnd.
  *
- * @param plcm Plcm handle.
+ * @param plnd Plnd handle.
+ * @param node Node.
  *
- * @return Allocation size.
+ * @return None.
  */
-pl_size_t plcm_size( plcm_t plcm );
+pl_none plnd_put( plnd_t plnd, pl_t node );
 
 
 /**
- * @brief Allocated memory size as pointers.
+ * @brief Return free Node count.
  *
- * @param plcm Plcm handle.
+ * @param plnd Plnd handle.
  *
- * @return Allocation size as pointers.
+ * @return Free Node count.
  */
-pl_size_t plcm_size_ptr( plcm_t plcm );
+pl_size_t plnd_count( plnd_t plnd );
 
 
 /**
- * @brief Return reference to data.
+ * @brief Return Node size.
  *
- * @param plcm Plcm handle.
+ * @param plnd Plnd handle.
  *
- * @return Data reference.
+ * @return Node size.
  */
-pl_t plcm_data( plcm_t plcm );
+pl_size_t plnd_node_size( plnd_t plnd );
+
 
 
+/* ------------------------------------------------------------
+ * Continuous Memory Allocator:
+ */
+
 /**
- * @brief Is plcm using debt?
+ * @brief Create plcm in heap (with debt).
  *
  * @param plcm Plcm handle.
+ * @param size Allocation size.
  *
- * @return True, if plcm has debt.
+ * @return Plcm handle.
  */
-pl_bool_t plcm_debt( plcm_t plcm );
+plcm_t plcm_new( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Reference to end of data (after used).
+ * @brief Create plcm in heap (with debt) for pointers.
  *
  * @param plcm Plcm handle.
+ * @param size Allocation size for number pointers.
  *
- * @return Reference to end.
+ * @return Plcm handle.
  */
-pl_t plcm_end( plcm_t plcm );
+plcm_t plcm_new_ptr( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Reference of tail data.
+ * @brief Create plcm in heap (with debt), with data alignment.
  *
- * Pointer to data is returned, not the data.
+ * Alignment is kept when plcm is resized.
  *
- * @param plcm Plcm handle.
- * @param size Tail size.
+ * @param plcm  Plcm handle.
+ * @param size  Allocation size.
+ * @param align Alignment (power of two).
  *
- * @return Reference to tail.
+ * @return Plcm handle.
  */
-pl_t plcm_tail( plcm_t plcm, pl_size_t size );
+plcm_t plcm_new_aligned( plcm_t plcm, pl_size_t size, pl_size_t align );
 
 
 /**
- * @brief Is plcm empty?
+ * @brief Create plcm to reserved address range (with debt).
  *
- * @param plcm Plcm handle.
+ * Address range is reserved (mmap) at creation, and pages are
+ * committed (mprotect) as plcm grows. Data is never moved, hence
+ * references to plcm memory remain valid. Reservation and size are
+ * rounded up to page size.
  *
- * @return True, if plcm is empty.
+ * Growing beyond the reservation fails (e.g. plcm_get_ref() returns
+ * NULL), but plcm and its data remain valid.
+ *
+ * @param plcm    Plcm handle.
+ * @param size    Initial (committed) size.
+ * @param reserve Reserved size.
+ *
+ * @return Plcm handle (NULL on failure).
  */
-pl_bool_t plcm_is_empty( plcm_t plcm );
+plcm_t plcm_new_reserve( plcm_t plcm, pl_size_t size, pl_size_t reserve );
 
 
 /**
- * @brief Find pointer from plcm.
+ * @brief Create plcm to mapped memory (with debt).
+ *
+ * Memory is mapped (mmap) at creation, and plcm grows by remapping
+ * (mremap) the pages. Large data is not copied at growth, since the
+ * kernel moves the pages instead. Size is rounded up to page size.
  *
  * @param plcm Plcm handle.
- * @param ref  Pointer to find.
+ * @param size Initial size.
  *
- * @return Index, or -1 for not found.
+ * @return Plcm handle (NULL on failure).
  */
-pl_pos_t plcm_find_ptr( plcm_t plcm, pl_t ref );
+plcm_t plcm_new_mmap( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Find object from plcm.
+ * @brief Create plcm to pre-existing allocation (no debt).
  *
- * @param plcm    Plcm handle.
- * @param compare Comparison function.
- * @param size    Item size in bytes.
- * @param ref     Pointer for reference.
+ * @param plcm Plcm handle.
+ * @param mem  Allocation.
+ * @param size Size of allocation.
  *
- * @return Index, or -1 for not found.
+ * @return Plcm handle.
  */
-pl_pos_t plcm_find_with( plcm_t plcm, plcm_compare_fn_t compare, pl_size_t size, pl_t ref );
-
-
+plcm_t plcm_use( plcm_t plcm, pl_t mem, pl_size_t size );
 
-/* ------------------------------------------------------------
- * Unified Memory Allocator:
- */
 
 /**
- * @brief Initiate plum with allocator.
+ * @brief Initiate nested plcm from plam (no debt).
  *
- * @param plum Plum handle.
- * @param type Allocator type.
- * @param host Allocator host (the actual allocator).
+ * @param plcm Nested plcm handle.
+ * @param host Plam handle.
+ * @param size Allocation size.
  *
- * @return None.
+ * @return Plcm handle.
  */
-pl_none plum_use( plum_t plum, pl_aa_t type, pl_t host );
+plcm_t plcm_use_plam( plcm_t plcm, plam_t host, pl_size_t size );
 
 
 /**
- * @brief Get allocation from plum.
+ * @brief Initiate nested plcm from plbm (no debt).
  *
- * @param plum Plum handle.
- * @param size Allocation size.
+ * @param plcm Nested plcm handle.
+ * @param host Plbm handle.
  *
- * @return Allocation.
+ * @return Plcm handle.
  */
-pl_t plum_get( plum_t plum, pl_size_t size );
+plcm_t plcm_use_plbm( plcm_t plcm, plbm_t host );
 
 
 /**
- * @brief Put allocation back to plum.
+ * @brief Deploy plcm inside plam (no debt).
  *
- * @param plum Plum handle.
- * @param mem  Allocation pointer.
- * @param size Allocation size.
+ * Plcm grows in place, when it is the last allocation in the current
+ * Node of host. Otherwise the data is relocated to a new allocation
+ * from host, i.e. heap is not used. Deletion returns the memory to
+ * host, if plcm is still the last allocation.
  *
- * @return Address or NULL if no memory was reclaimed.
+ * @param plcm Nested plcm handle.
+ * @param host Plam handle.
+ * @param size Initial size.
+ *
+ * @return Plcm handle (NULL on failure).
  */
-pl_t plum_put( plum_t plum, pl_t mem, pl_size_t size );
+plcm_t plcm_into_plam( plcm_t plcm, plam_t host, pl_size_t size );
 
 
 /**
- * @brief Get allocation from plum and store the data.
+ * @brief Create empty plcm.
  *
- * @param plum Plum handle.
- * @param data Data to store.
- * @param size Allocation size.
+ * Empty plcm is a placeholder with handle setup for allocations.
+ * However, no heap allocations are made at creation.
  *
- * @return Pointer to stored data, null for failure.
+ * @param plcm Plcm handle.
+ * @param size Allocation size (for future).
+ *
+ * @return Plcm handle.
  */
-pl_t plum_store( plum_t plum, const pl_t data, pl_size_t size );
+plcm_t plcm_empty( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Get allocation from plum and store pointer value to it.
+ * @brief Create empty plcm for pointers.
  *
- * @param plum Plum handle.
- * @param ptr  Pointer value.
+ * Empty plcm is a placeholder with handle setup for allocations.
+ * However, no heap allocations are made at creation.
  *
- * @return Pointer to stored data, null for failure.
+ * @param plcm Plcm handle.
+ * @param size Allocation size (for future) for pointers.
+ *
+ * @return Plcm handle.
  */
-pl_t plum_store_ptr( plum_t plum, pl_t ptr );
+plcm_t plcm_empty_ptr( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Update allocation size in plum.
+ * @brief Set zeroing of allocated memory for plcm.
  *
- * Current allocation content is copied to updated allocation.
+ * Memory is zeroed by default, at creation and when plcm grows.
+ * Zeroing can be skipped for data that is always overwritten, e.g.
+ * file content. Setting applies to allocations after the call, hence
+ * empty plcm (plcm_empty()) is used to cover also the first
+ * allocation.
  *
- * @param plum  Plum handle.
- * @param mem   Allocation pointer.
- * @param osize Allocation size of current.
- * @param nsize Allocation size of new.
+ * @param plcm    Plcm handle.
+ * @param zeroing Zero memory, if true.
  *
- * @return Updated allocation.
+ * @return None.
  */
-pl_t plum_update( plum_t plum, pl_t mem, pl_size_t osize, pl_size_t nsize );
+pl_none plcm_set_zeroing( plcm_t plcm, pl_bool_t zeroing );
 
 
 /**
- * @brief Return plum allocator (host) type.
+ * @brief Set growth policy for plcm.
  *
- * @param plum Plum handle.
+ * By default the size is doubled, when plcm runs out of memory.
+ * PL_GP_HALF and PL_GP_PAGE reduce the peak memory of large data,
+ * and PL_GP_CAPPED limits the growth step to cap (bytes). Cap of 0
+ * means no cap, i.e. PL_GP_CAPPED doubles the size.
  *
- * @return Type.
+ * Growth policy does not apply to plcm_new_reserve() plcm.
+ *
+ * @param plcm   Plcm handle.
+ * @param growth Growth policy.
+ * @param cap    Maximum growth step for PL_GP_CAPPED.
+ *
+ * @return None.
  */
-pl_aa_t plum_type( plum_t plum );
+pl_none plcm_set_growth( plcm_t plcm, pl_gp_t growth, pl_size_t cap );
 
 
 /**
- * @brief Return plum allocator (host).
+ * Convert Plcm to Plcm Shadow.
  *
- * @param plum Plum handle.
+ * @param plcm Plcm handle.
  *
- * @return Allocator.
+ * @return Shadow, referencing the host.
  */
-pl_t plum_host( plum_t plum );
-
-
+plcm_s plcm_shadow( plcm_t plcm );
 
-/* ------------------------------------------------------------
- * String Storage:
- */
 
 /**
- * @brief Create plss from plsr.
+ * Copy Plcm content to given target.
  *
- * @param plcm Plcm handle.
- * @param plsr Plsr handle.
+ * @param plcm   Plcm handle to copy from.
+ * @param target Target plcm handle.
+ * @param mem    Memory for copy.
+ * @param size   Memory size for copy storage.
  *
- * @return None.
+ * @return Copy.
  */
-plcm_t plss_from_plsr( plcm_t plcm, plsr_s plsr );
+pl_none plcm_copy_to( plcm_t plcm, plcm_t target, pl_t mem, pl_size_t size );
 
 
 /**
- * @brief Append plsr to plcm.
+ * Copy Plcm content and dimensions.
  *
  * @param plcm Plcm handle.
- * @param str  Plsr handle.
  *
- * @return Plcm handle.
+ * @return Copy.
  */
-plcm_t plss_append( plcm_t plcm, plsr_s str );
+plcm_s plcm_copy( plcm_t plcm );
 
 
 /**
- * @brief Append c-string to plcm.
+ * @brief Delete plcm.
+ *
+ * If plcm has debt, then the heap memory is deallocated. If plcm has
+ * no debt, deletion is mute.
  *
  * @param plcm Plcm handle.
- * @param str  C-string handle.
  *
- * @return Plcm handle.
+ * @return NULL.
  */
-plcm_t plss_append_string( plcm_t plcm, const char* str );
+plcm_t plcm_del( plcm_t plcm );
 
 
 /**
- * @brief Append char to plcm.
+ * @brief Resize plcm allocation.
+ *
+ * Resize fails, if reserved plcm (plcm_new_reserve()) exceeds the
+ * reservation. Then plcm is not changed, i.e. the data is kept.
  *
  * @param plcm Plcm handle.
- * @param ch   Char.
+ * @param size New allocation size.
  *
- * @return Plcm handle.
+ * @return True on success.
  */
-plcm_t plss_append_char( plcm_t plcm, char ch );
+pl_bool_t plcm_resize( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Remove sub-string.
+ * @brief Resize plcm allocation by increase.
  *
  * @param plcm Plcm handle.
- * @param pos  Position of removal.
- * @param size Size of removal.
+ * @param size Allocation size increase.
  *
  * @return None.
  */
-pl_none plss_remove( plcm_t plcm, pl_pos_t pos, pl_size_t size );
+pl_none plcm_increase( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Insert sub-string.
+ * @brief Ensure that (future) value fits.
  *
  * @param plcm Plcm handle.
- * @param pos  Position of insertion.
- * @param data Data to store.
- * @param size Data size.
+ * @param size Value (increment) size.
  *
- * @return None.
+ * @return Location for value storage (NULL on failure).
  */
-pl_none plss_insert( plcm_t plcm, pl_pos_t pos, pl_t data, pl_size_t size );
+pl_t plcm_ensure( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Set (overwrite) plcm content.
+ * @brief Compact plcm allocation to minimum size.
  *
  * @param plcm Plcm handle.
- * @param str  Plsr handle.
  *
- * @return Plcm handle.
+ * @return None.
  */
-plcm_t plss_set( plcm_t plcm, plsr_s str );
+pl_none plcm_compact( plcm_t plcm );
 
 
 /**
- * Refresh string length of plcm.
+ * @brief Get allocation from plcm as position.
  *
- * Useful when some function has filled string content and it should
- * be in sync with the Plcm itself.
+ * Position is an offset to data start.
  *
  * @param plcm Plcm handle.
+ * @param size Allocation size.
  *
- * @return Plcm.
+ * @return Allocation position (-1 on failure).
  */
-plcm_t plss_refresh( plcm_t plcm );
+pl_pos_t plcm_get_pos( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Compact plss (pclm) allocation to minimum size.
+ * @brief Get allocation from plcm as pointer reference.
  *
  * @param plcm Plcm handle.
+ * @param size Allocation size.
  *
- * @return None.
+ * @return Allocation reference (NULL on failure).
  */
-plcm_t plss_compact( plcm_t plcm );
+static inline pl_t plcm_get_ref( plcm_t plcm, pl_size_t size )
+{
+    pl_t ret;
+
+    if ( _plcm_is_empty( plcm ) || plcm->used + size > plcm->size ) {
+        if ( !plcm_resize( plcm, plcm->used + size ) ) {
+            return NULL;
+        }
+    }
+    ret = plcm->data + plcm->used;
+    plcm->used += size;
+    return ret;
+}
 
 
 /**
- * @brief Format string to plcm, append.
+ * @brief Put allocation back to plcm.
+ *
+ * User is responsible in making the puts in reserver order with
+ * correct sizes.
  *
  * @param plcm Plcm handle.
- * @param fmt  Format specifier.
+ * @param size Allocation size.
  *
- * @return Plcm handle.
+ * @return None.
  */
-plcm_t plss_format_string( plcm_t plcm, const char* fmt, ... );
+pl_none plcm_put( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Format string to plcm, overwrite.
+ * @brief Get allocation from plcm and store value to it.
  *
  * @param plcm Plcm handle.
- * @param fmt  Format specifier.
+ * @param data Data to store.
+ * @param size Allocation and data size.
  *
- * @return Plcm handle.
+ * @return Allocation position (-1 on failure).
  */
-plcm_t plss_reformat_string( plcm_t plcm, const char* fmt, ... );
+pl_pos_t plcm_store( plcm_t plcm, pl_t data, pl_size_t size );
 
 
 /**
- * @brief Format string to plcm, append.
+ * @brief Get allocation from plcm and store pointer value to it.
  *
  * @param plcm Plcm handle.
- * @param fmt  Format specifier.
- * @param ap   Variable arguments.
+ * @param ptr  Pointer value.
  *
- * @return None.
+ * @return Allocation position.
  */
-pl_none plss_va_format_string( plcm_t plcm, const char* fmt, va_list ap );
+pl_pos_t plcm_store_ptr( plcm_t plcm, pl_t ptr );
 
 
 /**
- * @brief Read file into an existing plcm and return plcm for file
- *        content.
+ * @brief Get allocation from plcm and store null pointer value to it.
  *
- * @param plcm     Plcm handle.
- * @param filename Filename.
+ * Storage is resized, but the used count is not changed. Nothing is
+ * stored, if plcm can't grow.
  *
- * @return Plcm, NULL with failure.
+ * @param plcm Plcm handle.
  */
-plcm_t plss_read_file( plcm_t plcm, const char* filename );
+pl_none plcm_store_null( plcm_t plcm );
 
 
 /**
- * @brief Read file into an existing plcm and return plcm for file
- *        content with null padding in the start and end.
+ * @brief Reference allocation from plcm.
  *
- * @param plcm     Plcm handle.
- * @param filename Filename.
- * @param left     Start pad.
- * @param right    End pad.
+ * @param plcm Plcm handle.
+ * @param pos  Allocation position.
  *
- * @return plcm, NULL with failure.
+ * @return Allocation reference.
  */
-plcm_t plss_read_file_with_pad( plcm_t      plcm,
-                                const char* filename,
-                                pl_size_t   left,
-                                pl_size_t   right );
+pl_t plcm_ref( plcm_t plcm, pl_pos_t pos );
 
 
 /**
- * @brief Read a line from file stream to an existing plcm, with the
- *        possible newline at the end of line.
+ * @brief Reference pointer allocation from plcm.
  *
- * @param plcm     Plcm handle.
- * @param fh       File stream.
+ * @param plcm Plcm handle.
+ * @param pos  Pointer position.
  *
- * @return plcm, NULL with failure.
+ * @return Pointer value.
  */
-plcm_t plss_read_line_with_newline( plcm_t plcm, FILE* fh );
+pl_t plcm_ref_ptr( plcm_t plcm, pl_pos_t pos );
 
 
 /**
- * @brief Read a line (no newline) from file stream to an existing
- *        plcm.
+ * @brief Set value for data.
  *
- * @param plcm     Plcm handle.
- * @param fh       File stream.
+ * @param plcm Plcm handle.
+ * @param pos  Allocation position.
+ * @param data Address of data to store.
+ * @param size Data size.
  *
- * @return plcm, NULL with failure.
+ * @return None.
  */
-plcm_t plss_read_line( plcm_t plcm, FILE* fh );
+pl_none plcm_set( plcm_t plcm, pl_pos_t pos, const pl_t data, pl_size_t size );
 
 
 /**
- * @brief Write plcm content to file.
+ * @brief Set pointer value to pointer position.
  *
- * @param plcm     Plcm handle.
- * @param filename Filename.
+ * @param plcm Plcm handle.
+ * @param pos  Pointer position.
+ * @param ptr  Pointer value.
  *
- * @return plcm, NULL for failure.
+ * @return None.
  */
-plcm_t plss_write_file( plcm_t plcm, const char* filename );
+pl_none plcm_set_ptr( plcm_t plcm, pl_pos_t pos, const pl_t ptr );
 
 
 /**
- * @brief Write plsr content to file stream.
+ * @brief Consume allocation for value (in the allocation end position).
  *
- * @param plsr Plsr handle.
- * @param fh   File stream.
+ * Use plcm_consume with plcm_ensure. First ensure allocation (with
+ * plcm_ensure), then store value(s), and finally report to Plcm the
+ * consumed memory, with plcm_consume.
  *
- * @return Number of bytes written.
+ * NOTE: Reserve does not perform plcm_resize implicitly. User must
+ * ensure that pre-allocation size is sufficient.
+ *
+ * @param plcm Plcm handle.
+ * @param size Value size.
+ *
+ * @return Start address for value.
  */
-pl_size_t plss_write_to( plsr_s plsr, FILE* fh );
+pl_t plcm_consume( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief String in plcm.
+ * @brief Pop value from the end.
  *
  * @param plcm Plcm handle.
+ * @param size Value size.
  *
- * @return String reference.
+ * @return Popped value.
  */
-const char* plss_string( plcm_t plcm );
+pl_t plcm_pop( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief String length in plcm.
+ * @brief Pop pointer value from the end.
  *
  * @param plcm Plcm handle.
  *
- * @return String length.
+ * @return Popped value.
  */
-pl_size_t plss_length( plcm_t plcm );
+pl_t plcm_pop_ptr( plcm_t plcm );
 
 
 /**
- * @brief String in plcm.
+ * @brief Remove data.
  *
  * @param plcm Plcm handle.
+ * @param pos  Position of removal.
+ * @param size Size of removal.
  *
- * @return Plsr handle.
+ * @return None.
  */
-plsr_s plss_ref( plcm_t plcm );
+pl_none plcm_remove( plcm_t plcm, pl_pos_t pos, pl_size_t size );
 
 
 /**
- * @brief Is plss string empty?
+ * @brief Remove pointer.
  *
  * @param plcm Plcm handle.
+ * @param pos  Pointer position of removal.
  *
- * @return True, if plss string is empty.
+ * @return None.
  */
-pl_bool_t plss_is_empty( plcm_t plcm );
+pl_none plcm_remove_ptr( plcm_t plcm, pl_pos_t pos );
 
 
+/**
+ * @brief Insert data.
+ *
+ * @param plcm Plcm handle.
+ * @param pos  Position of insertion.
+ * @param data Data to store.
+ * @param size Data size.
+ *
+ * @return None.
+ */
+pl_none plcm_insert( plcm_t plcm, pl_pos_t pos, pl_t data, pl_size_t size );
+
 
-/* ------------------------------------------------------------
- * String Referencing:
+/**
+ * @brief Insert pointer.
+ *
+ * @param plcm Plcm handle.
+ * @param pos  Pointer position of insertion.
+ * @param ptr  Pointer value.
+ *
+ * @return None.
  */
+pl_none plcm_insert_ptr( plcm_t plcm, pl_pos_t pos, pl_t ptr );
+
 
 /**
- * @brief Create plsr from plcm.
+ * @brief Set terminating value after used data.
+ *
+ * Use this for any type of NULL termination of continuous data.
  *
  * @param plcm Plcm handle.
+ * @param size Size of termination.
  *
- * @return Plsr.
+ * @return True, if termination done and fitted.
  */
-plsr_s plsr_from_plcm( plcm_t plcm );
+pl_bool_t plcm_terminate( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Create plsr from c-string.
+ * @brief Set terminating value after used data for pointers.
  *
- * @param str C-string.
+ * @param plcm Plcm handle.
  *
- * @return Plsr handle.
+ * @return True, if termination done and fitted.
  */
-plsr_s plsr_from_string( const char* str );
+pl_bool_t plcm_terminate_ptr( plcm_t plcm );
 
 
 /**
- * @brief Create plsr from c-string and length.
+ * @brief Reset used data to zero.
  *
- * @param str    C-string.
- * @param length C-string length.
+ * @param plcm Plcm handle.
  *
- * @return Plsr handle.
+ * @return None.
  */
-plsr_s plsr_from_string_and_length( const char* str, pl_size_t length );
+pl_none plcm_reset( plcm_t plcm );
 
 
 /**
- * @brief String in plsr.
+ * @brief Reset used data to zero and clear data.
  *
- * @param plsr Plsr handle.
+ * @param plcm Plcm handle.
  *
- * @return String reference.
+ * @return None.
  */
-const char* plsr_string( plsr_s plsr );
+pl_none plcm_clear( plcm_t plcm );
 
 
 /**
- * @brief String length in plsr.
+ * @brief Used memory size.
  *
- * @param plsr Plsr handle.
+ * @param plcm Plcm handle.
  *
- * @return String length.
+ * @return Used memory.
  */
-pl_size_t plsr_length( plsr_s plsr );
+pl_size_t plcm_used( plcm_t plcm );
 
 
 /**
- * @brief Compare two plsr.
+ * @brief Used memory size as pointer count.
  *
- * @param p1 Plsr handle.
- * @param p2 Plsr handle.
+ * @param plcm Plcm handle.
  *
- * @return True, if length and content match.
+ * @return Used memory as number of pointers.
  */
-pl_bool_t plsr_compare( plsr_s p1, plsr_s p2 );
+pl_size_t plcm_used_ptr( plcm_t plcm );
 
 
 /**
- * @brief Compare two plsr for n characters.
+ * @brief Allocated memory size.
  *
- * @param p1 Plsr handle.
- * @param p2 Plsr handle.
- * @param n  Comparison length.
+ * @param plcm Plcm handle.
  *
- * @return True, content match for the given length.
+ * @return Allocation size.
  */
-pl_bool_t plsr_compare_n( plsr_s p1, plsr_s p2, pl_size_t n );
+pl_size_t plcm_size( plcm_t plcm );
 
 
 /**
- * @brief Create a null plsr.
+ * @brief Allocated memory size as pointers.
  *
- * @return Plsr handle.
+ * @param plcm Plcm handle.
+ *
+ * @return Allocation size as pointers.
  */
-plsr_s plsr_null( pl_none );
+pl_size_t plcm_size_ptr( plcm_t plcm );
 
 
 /**
- * @brief Is plsr null?
+ * @brief Return reference to data.
  *
- * @param plsr Plsr handle.
+ * @param plcm Plcm handle.
  *
- * @return True, if plsr is null.
+ * @return Data reference.
  */
-pl_bool_t plsr_is_null( plsr_s plsr );
+pl_t plcm_data( plcm_t plcm );
 
 
 /**
- * @brief Is plsr an empty string?
+ * @brief Is plcm using debt?
  *
- * Empty means that there is a string associated, but length is zero.
+ * @param plcm Plcm handle.
  *
- * @param plsr Plsr handle.
+ * @return True, if plcm has debt.
+ */
+pl_bool_t plcm_debt( plcm_t plcm );
+
+
+/**
+ * @brief Reference to end of data (after used).
  *
- * @return True, if plsr is empty.
+ * @param plcm Plcm handle.
+ *
+ * @return Reference to end.
  */
-pl_bool_t plsr_is_empty( plsr_s plsr );
+pl_t plcm_end( plcm_t plcm );
 
 
 /**
- * @brief Return next line content, without the terminating newline.
+ * @brief Reference of tail data.
  *
- * The next line is a string reference starting from current offset to
- * the newline or eof. Offset is updated to be after next newline or
- * at eof, if eof was encountered. First line is returned by passing
- * offset with initial value 0.
+ * Pointer to data is returned, not the data.
  *
- * @param         plsr   Plsr handle.
- * @param[in,out] offset Current offset.
+ * @param plcm Plcm handle.
+ * @param size Tail size.
  *
- * @return Plsr to current line, or null for eof.
+ * @return Reference to tail.
  */
-plsr_s plsr_next_line( plsr_s plsr, pl_size_p offset );
+pl_t plcm_tail( plcm_t plcm, pl_size_t size );
 
 
 /**
- * @brief Return char at index.
+ * @brief Is plcm empty?
  *
- * Note: return 0, if index is out-of-range.
+ * @param plcm Plcm handle.
  *
- * @param plsr  Plsr handle.
- * @param index Char index.
+ * @return True, if plcm is empty.
+ */
+pl_bool_t plcm_is_empty( plcm_t plcm );
+
+
+/**
+ * @brief Find pointer from plcm.
  *
- * @return Indexed char.
+ * @param plcm Plcm handle.
+ * @param ref  Pointer to find.
+ *
+ * @return Index, or -1 for not found.
  */
-char plsr_index( plsr_s plsr, pl_pos_t index );
+pl_pos_t plcm_find_ptr( plcm_t plcm, pl_t ref );
 
 
 /**
- * @brief Return range of plsr.
+ * @brief Find object from plcm.
  *
- * @param plsr  Plsr handle.
- * @param start Start index (inclusive).
- * @param end   End index (exclusive).
+ * @param plcm    Plcm handle.
+ * @param compare Comparison function.
+ * @param size    Item size in bytes.
+ * @param ref     Pointer for reference.
  *
- * @return Plsr.
+ * @return Index, or -1 for not found.
  */
-plsr_s plsr_range( plsr_s plsr, pl_size_t start, pl_size_t end );
+pl_pos_t plcm_find_with( plcm_t plcm, plcm_compare_fn_t compare, pl_size_t size, pl_t ref );
 
 
 
 /* ------------------------------------------------------------
- * Universal Interface:
+ * Inline Continuous Memory Allocator:
  */
 
-
 /**
- * @brief Initialize ui structure.
+ * @brief Initiate plci to inline storage (no debt).
  *
- * @param ui  UI, Universal Interface.
- * @param env Environment for UI.
- * @param fun Method for UI.
+ * Returned plcm handle is used with all plcm and plss functions. Data
+ * is moved to heap (with debt), when it exceeds PLCI_SIZE.
+ *
+ * @param plci Plci handle.
+ *
+ * @return Plcm handle.
  */
-pl_none plui_init( plui_t ui, pl_t env, plui_fn_t fun );
+plcm_t plci_new( plci_t plci );
 
 
 /**
- * @brief Use Universal Interface.
+ * @brief Delete plci.
  *
- * @param ui   UI, Universal Interface.
- * @param argi Input argument, opaque pointer.
- * @param argo Output argument (response), opaque pointer.
+ * Heap memory (if any) is deallocated, and plci is reset to the
+ * inline storage.
+ *
+ * @param plci Plci handle.
+ *
+ * @return None.
  */
-pl_none plui_do( plui_t ui, pl_t argi, pl_t argo );
-
+pl_none plci_del( plci_t plci );
 
 
-/* ------------------------------------------------------------
- * Array:
+/**
+ * @brief Return true if plci data is in inline storage.
+ *
+ * @param plci Plci handle.
+ *
+ * @return True if inline.
  */
+pl_bool_t plci_is_inline( plci_t plci );
+
 
 /**
- * @brief Initialize array for the data and dimensions.
+ * @brief Return plcm handle of plci.
  *
- * @param data Data for array.
- * @param step Item size of array.
- * @param size Item count of array.
+ * Reference to inline storage is refreshed, since plci might have
+ * been copied (e.g. as part of a struct) after the previous access.
+ *
+ * @param plci Plci handle.
+ *
+ * @return Plcm handle.
+ */
+static inline plcm_t plci_plcm( plci_t plci )
+{
+    if ( plci->plcm.type == PL_AA_SELF && plci->plcm.data ) {
+        plci->plcm.data = plci->local;
+    }
+    return &plci->plcm;
+}
+
+
+
+/* ------------------------------------------------------------
+ * Unified Memory Allocator:
+ */
+
+/**
+ * @brief Initiate plum with allocator.
+ *
+ * @param plum Plum handle.
+ * @param type Allocator type.
+ * @param host Allocator host (the actual allocator).
+ *
+ * @return None.
+ */
+pl_none plum_use( plum_t plum, pl_aa_t type, pl_t host );
+
+
+/**
+ * @brief Get allocation from plum.
+ *
+ * @param plum Plum handle.
+ * @param size Allocation size.
+ *
+ * @return Allocation.
+ */
+pl_t plum_get( plum_t plum, pl_size_t size );
+
+
+/**
+ * @brief Put allocation back to plum.
+ *
+ * @param plum Plum handle.
+ * @param mem  Allocation pointer.
+ * @param size Allocation size.
+ *
+ * @return Address or NULL if no memory was reclaimed.
+ */
+pl_t plum_put( plum_t plum, pl_t mem, pl_size_t size );
+
+
+/**
+ * @brief Get allocation from plum and store the data.
+ *
+ * @param plum Plum handle.
+ * @param data Data to store.
+ * @param size Allocation size.
+ *
+ * @return Pointer to stored data, null for failure.
+ */
+pl_t plum_store( plum_t plum, const pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Get allocation from plum and store pointer value to it.
+ *
+ * @param plum Plum handle.
+ * @param ptr  Pointer value.
+ *
+ * @return Pointer to stored data, null for failure.
+ */
+pl_t plum_store_ptr( plum_t plum, pl_t ptr );
+
+
+/**
+ * @brief Update allocation size in plum.
+ *
+ * Current allocation content is copied to updated allocation.
+ *
+ * @param plum  Plum handle.
+ * @param mem   Allocation pointer.
+ * @param osize Allocation size of current.
+ * @param nsize Allocation size of new.
+ *
+ * @return Updated allocation.
+ */
+pl_t plum_update( plum_t plum, pl_t mem, pl_size_t osize, pl_size_t nsize );
+
+
+/**
+ * @brief Return plum allocator (host) type.
+ *
+ * @param plum Plum handle.
+ *
+ * @return Type.
+ */
+pl_aa_t plum_type( plum_t plum );
+
+
+/**
+ * @brief Return plum allocator (host).
+ *
+ * @param plum Plum handle.
+ *
+ * @return Allocator.
+ */
+pl_t plum_host( plum_t plum );
+
+
+
+/* ------------------------------------------------------------
+ * String Storage:
+ */
+
+/**
+ * @brief Create plss from plsr.
+ *
+ * @param plcm Plcm handle.
+ * @param plsr Plsr handle.
+ *
+ * @return None.
+ */
+plcm_t plss_from_plsr( plcm_t plcm, plsr_s plsr );
+
+
+/**
+ * @brief Append plsr to plcm.
+ *
+ * Nothing is appended, if plcm can't grow (e.g. reservation is
+ * exhausted).
+ *
+ * @param plcm Plcm handle.
+ * @param str  Plsr handle.
+ *
+ * @return Plcm handle, NULL if plcm can't grow.
+ */
+plcm_t plss_append( plcm_t plcm, plsr_s str );
+
+
+/**
+ * @brief Append c-string to plcm.
+ *
+ * @param plcm Plcm handle.
+ * @param str  C-string handle.
+ *
+ * @return Plcm handle, NULL if plcm can't grow.
+ */
+plcm_t plss_append_string( plcm_t plcm, const char* str );
+
+
+/**
+ * @brief Append char to plcm.
+ *
+ * @param plcm Plcm handle.
+ * @param ch   Char.
+ *
+ * @return Plcm handle, NULL if plcm can't grow.
+ */
+plcm_t plss_append_char( plcm_t plcm, char ch );
+
+
+/**
+ * @brief Remove sub-string.
+ *
+ * @param plcm Plcm handle.
+ * @param pos  Position of removal.
+ * @param size Size of removal.
+ *
+ * @return None.
+ */
+pl_none plss_remove( plcm_t plcm, pl_pos_t pos, pl_size_t size );
+
+
+/**
+ * @brief Insert sub-string.
+ *
+ * Nothing is inserted, if plcm can't grow.
+ *
+ * @param plcm Plcm handle.
+ * @param pos  Position of insertion.
+ * @param data Data to store.
+ * @param size Data size.
+ *
+ * @return None.
+ */
+pl_none plss_insert( plcm_t plcm, pl_pos_t pos, pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Set (overwrite) plcm content.
+ *
+ * @param plcm Plcm handle.
+ * @param str  Plsr handle.
+ *
+ * @return Plcm handle, NULL if plcm can't grow.
+ */
+plcm_t plss_set( plcm_t plcm, plsr_s str );
+
+
+/**
+ * Refresh string length of plcm.
+ *
+ * Useful when some function has filled string content and it should
+ * be in sync with the Plcm itself.
+ *
+ * @param plcm Plcm handle.
+ *
+ * @return Plcm.
+ */
+plcm_t plss_refresh( plcm_t plcm );
+
+
+/**
+ * @brief Compact plss (pclm) allocation to minimum size.
+ *
+ * @param plcm Plcm handle.
+ *
+ * @return None.
+ */
+plcm_t plss_compact( plcm_t plcm );
+
+
+/**
+ * @brief Format string to plcm, append.
+ *
+ * @param plcm Plcm handle.
+ * @param fmt  Format specifier.
+ *
+ * @return Plcm handle.
+ */
+plcm_t plss_format_string( plcm_t plcm, const char* fmt, ... );
+
+
+/**
+ * @brief Format string to plcm, overwrite.
+ *
+ * @param plcm Plcm handle.
+ * @param fmt  Format specifier.
+ *
+ * @return Plcm handle.
+ */
+plcm_t plss_reformat_string( plcm_t plcm, const char* fmt, ... );
+
+
+/**
+ * @brief Format string to plcm, append.
+ *
+ * Nothing is appended, if plcm can't grow.
+ *
+ * @param plcm Plcm handle.
+ * @param fmt  Format specifier.
+ * @param ap   Variable arguments.
+ *
+ * @return None.
+ */
+pl_none plss_va_format_string( plcm_t plcm, const char* fmt, va_list ap );
+
+
+/**
+ * @brief Read file into an existing plcm and return plcm for file
+ *        content.
+ *
+ * @param plcm     Plcm handle.
+ * @param filename Filename.
+ *
+ * @return Plcm, NULL with failure.
+ */
+plcm_t plss_read_file( plcm_t plcm, const char* filename );
+
+
+/**
+ * @brief Read file into an existing plcm and return plcm for file
+ *        content with null padding in the start and end.
+ *
+ * @param plcm     Plcm handle.
+ * @param filename Filename.
+ * @param left     Start pad.
+ * @param right    End pad.
+ *
+ * @return plcm, NULL with failure.
+ */
+plcm_t plss_read_file_with_pad( plcm_t      plcm,
+                                const char* filename,
+                                pl_size_t   left,
+                                pl_size_t   right );
+
+
+/**
+ * @brief Read a line from file stream to an existing plcm, with the
+ *        possible newline at the end of line.
+ *
+ * @param plcm     Plcm handle.
+ * @param fh       File stream.
+ *
+ * @return plcm, NULL with failure.
+ */
+plcm_t plss_read_line_with_newline( plcm_t plcm, FILE* fh );
+
+
+/**
+ * @brief Read a line (no newline) from file stream to an existing
+ *        plcm.
+ *
+ * @param plcm     Plcm handle.
+ * @param fh       File stream.
+ *
+ * @return plcm, NULL with failure.
+ */
+plcm_t plss_read_line( plcm_t plcm, FILE* fh );
+
+
+/**
+ * @brief Write plcm content to file.
+ *
+ * @param plcm     Plcm handle.
+ * @param filename Filename.
+ *
+ * @return plcm, NULL for failure.
+ */
+plcm_t plss_write_file( plcm_t plcm, const char* filename );
+
+
+/**
+ * @brief Write plsr content to file stream.
+ *
+ * @param plsr Plsr handle.
+ * @param fh   File stream.
+ *
+ * @return Number of bytes written.
+ */
+pl_size_t plss_write_to( plsr_s plsr, FILE* fh );
+
+
+/**
+ * @brief String in plcm.
+ *
+ * @param plcm Plcm handle.
+ *
+ * @return String reference.
+ */
+const char* plss_string( plcm_t plcm );
+
+
+/**
+ * @brief String length in plcm.
+ *
+ * @param plcm Plcm handle.
+ *
+ * @return String length.
+ */
+pl_size_t plss_length( plcm_t plcm );
+
+
+/**
+ * @brief String in plcm.
+ *
+ * @param plcm Plcm handle.
+ *
+ * @return Plsr handle.
+ */
+plsr_s plss_ref( plcm_t plcm );
+
+
+/**
+ * @brief Is plss string empty?
+ *
+ * @param plcm Plcm handle.
+ *
+ * @return True, if plss string is empty.
+ */
+pl_bool_t plss_is_empty( plcm_t plcm );
+
+
+
+/* ------------------------------------------------------------
+ * String Referencing:
+ */
+
+/**
+ * @brief Create plsr from plcm.
+ *
+ * @param plcm Plcm handle.
+ *
+ * @return Plsr.
+ */
+plsr_s plsr_from_plcm( plcm_t plcm );
+
+
+/**
+ * @brief Create plsr from c-string.
+ *
+ * @param str C-string.
+ *
+ * @return Plsr handle.
+ */
+plsr_s plsr_from_string( const char* str );
+
+
+/**
+ * @brief Create plsr from c-string and length.
+ *
+ * @param str    C-string.
+ * @param length C-string length.
+ *
+ * @return Plsr handle.
+ */
+plsr_s plsr_from_string_and_length( const char* str, pl_size_t length );
+
+
+/**
+ * @brief String in plsr.
+ *
+ * @param plsr Plsr handle.
+ *
+ * @return String reference.
+ */
+const char* plsr_string( plsr_s plsr );
+
+
+/**
+ * @brief String length in plsr.
+ *
+ * @param plsr Plsr handle.
+ *
+ * @return String length.
+ */
+pl_size_t plsr_length( plsr_s plsr );
+
+
+/**
+ * @brief Compare two plsr.
+ *
+ * @param p1 Plsr handle.
+ * @param p2 Plsr handle.
+ *
+ * @return True, if length and content match.
+ */
+pl_bool_t plsr_compare( plsr_s p1, plsr_s p2 );
+
+
+/**
+ * @brief Compare two plsr for n characters.
+ *
+ * @param p1 Plsr handle.
+ * @param p2 Plsr handle.
+ * @param n  Comparison length.
+ *
+ * @return True, content match for the given length.
+ */
+pl_bool_t plsr_compare_n( plsr_s p1, plsr_s p2, pl_size_t n );
+
+
+/**
+ * @brief Create a null plsr.
+ *
+ * @return Plsr handle.
+ */
+plsr_s plsr_null( pl_none );
+
+
+/**
+ * @brief Is plsr null?
+ *
+ * @param plsr Plsr handle.
+ *
+ * @return True, if plsr is null.
+ */
+pl_bool_t plsr_is_null( plsr_s plsr );
+
+
+/**
+ * @brief Is plsr an empty string?
+ *
+ * Empty means that there is a string associated, but length is zero.
+ *
+ * @param plsr Plsr handle.
+ *
+ * @return True, if plsr is empty.
+ */
+pl_bool_t plsr_is_empty( plsr_s plsr );
+
+
+/**
+ * @brief Return next line content, without the terminating newline.
+ *
+ * The next line is a string reference starting from current offset to
+ * the newline or eof. Offset is updated to be after next newline or
+ * at eof, if eof was encountered. First line is returned by passing
+ * offset with initial value 0.
+ *
+ * @param         plsr   Plsr handle.
+ * @param[in,out] offset Current offset.
+ *
+ * @return Plsr to current line, or null for eof.
+ */
+plsr_s plsr_next_line( plsr_s plsr, pl_size_p offset );
+
+
+/**
+ * @brief Return char at index.
+ *
+ * Note: return 0, if index is out-of-range.
+ *
+ * @param plsr  Plsr handle.
+ * @param index Char index.
+ *
+ * @return Indexed char.
+ */
+char plsr_index( plsr_s plsr, pl_pos_t index );
+
+
+/**
+ * @brief Return range of plsr.
+ *
+ * @param plsr  Plsr handle.
+ * @param start Start index (inclusive).
+ * @param end   End index (exclusive).
+ *
+ * @return Plsr.
+ */
+plsr_s plsr_range( plsr_s plsr, pl_size_t start, pl_size_t end );
+
+
+
+/* ------------------------------------------------------------
+ * Universal Interface:
+ */
+
+
+/**
+ * @brief Initialize ui structure.
+ *
+ * @param ui  UI, Universal Interface.
+ * @param env Environment for UI.
+ * @param fun Method for UI.
+ */
+pl_none plui_init( plui_t ui, pl_t env, plui_fn_t fun );
+
+
+/**
+ * @brief Use Universal Interface.
+ *
+ * @param ui   UI, Universal Interface.
+ * @param argi Input argument, opaque pointer.
+ * @param argo Output argument (response), opaque pointer.
+ */
+pl_none plui_do( plui_t ui, pl_t argi, pl_t argo );
+
+
+
+/* ------------------------------------------------------------
+ * Array:
+ */
+
+/**
+ * @brief Initialize array for the data and dimensions.
+ *
+ * @param data Data for array.
+ * @param step Item size of array.
+ * @param size Item count of array.
  *
  * @return Plar.
  */
-plar_s plar_init( pl_t data, pl_size_t step, pl_size_t size );
+plar_s plar_init( pl_t data, pl_size_t step, pl_size_t size );
+
+
+/**
+ * @brief Return item from array.
+ *
+ * @param plar  Plar.
+ * @param index Index.
+ *
+ * @return Item.
+ */
+pl_t plar_get( plar_s plar, pl_size_t index );
+
+
+/**
+ * @brief Set values of item(s).
+ *
+ * @param plar  Plar.
+ * @param index Start index.
+ * @param count Count of items to set.
+ * @param data  Values.
+ *
+ * @return None.
+ */
+pl_none plar_set( plar_s plar, pl_size_t index, pl_size_t count, pl_t data );
+
+
+/**
+ * @brief Insert values to array.
+ *
+ *        === c
+ *     ++++++++   ->   +++===+++++
+ *        i               i
+ *
+ * @param plar  Plar.
+ * @param index Start index for insertion.
+ * @param count Count of items to insert.
+ * @param data  Values to insert.
+ *
+ * @return Updated plar.
+ */
+plar_s plar_insert( plar_s plar, pl_size_t index, pl_size_t count, pl_t data );
+
+
+/**
+ * @brief Remove slice from array.
+ *
+ *        --- c
+ *     +++++++++++   ->   ++++++++
+ *        i                  i
+ *
+ * @param plar  Plar.
+ * @param index Start index.
+ * @param count Count of items to remove.
+ *
+ * @return Updated plar.
+ */
+plar_s plar_remove( plar_s plar, pl_size_t index, pl_size_t count );
+
+
+/**
+ * @brief Return the byte size of item slice.
+ *
+ * @param plar  Plar.
+ * @param count Number of items.
+ *
+ * @return Byte size.
+ */
+pl_size_t plar_size_of_slice( plar_s plar, pl_size_t count );
+
+
+/**
+ * @brief Return the byte size of array items.
+ *
+ * @param plar Plar.
+ *
+ * @return Byte size.
+ */
+pl_size_t plar_size_in_bytes( plar_s plar );
+
+
+/**
+ * @brief Return array data.
+ *
+ * @param plar Plar.
+ *
+ * @return Data.
+ */
+pl_t plar_data( plar_s plar );
+
+
+/**
+ * @brief Return array item size.
+ *
+ * @param plar Plar.
+ *
+ * @return Item size.
+ */
+pl_size_t plar_step( plar_s plar );
+
+
+/**
+ * @brief Return array item count.
+ *
+ * @param plar Plar.
+ *
+ * @return Item count.
+ */
+pl_size_t plar_size( plar_s plar );
+
+
+
+/* ------------------------------------------------------------
+ * List (singly-linked):
+ */
+
+/**
+ * @brief Initialize list to plbm.
+ *
+ * @param plbm Plbm handle.
+ *
+ * @return Plls.
+ */
+plls_s plls_init( plbm_t plbm );
+
+
+/**
+ * @brief Append after place.
+ *
+ * @param plls  Plls handle.
+ * @param place Place of append.
+ * @param data  Data to append.
+ *
+ * @return None.
+ */
+pl_none plls_append( plls_t plls, plls_node_p place, const pl_t data );
+
+
+/**
+ * @brief Append after place with size.
+ *
+ * @param plls  Plls handle.
+ * @param place Place of append.
+ * @param data  Data to append.
+ * @param size  Size of data.
+ *
+ * @return None.
+ */
+pl_none plls_append_with_size( plls_t plls, plls_node_p place, const pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Insert at place.
+ *
+ * @param plls  Plls handle.
+ * @param place Place of insert.
+ * @param data  Data to insert.
+ *
+ * @return None.
+ */
+pl_none plls_insert( plls_t plls, plls_node_p place, const pl_t data );
+
+
+/**
+ * @brief Insert at place with size.
+ *
+ * @param plls  Plls handle.
+ * @param place Place of insert.
+ * @param data  Data to insert.
+ * @param size  Size of data.
+ *
+ * @return None.
+ */
+pl_none plls_insert_with_size( plls_t plls, plls_node_p place, const pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Remove node from list.
+ *
+ * Current node is removed, if place is at list start and the node is
+ * the only remaining.
+ *
+ * @param plls  Plls handle.
+ * @param place Place of removal.
+ *
+ * @return Pointer to current node (if possible).
+ */
+plls_node_p plls_remove( plls_t plls, plls_node_p place );
+
+
+/**
+ * @brief Store data at end of list.
+ *
+ * @param plls Plls handle.
+ * @param data Data to store.
+ *
+ * @return None.
+ */
+pl_none plls_store( plls_t plls, const pl_t data );
+
+
+/**
+ * @brief Store data at end of list.
+ *
+ * @param plls Plls handle.
+ * @param data Data to store.
+ * @param size Size of data.
+ *
+ * @return None.
+ */
+pl_none plls_store_with_size( plls_t plls, const pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Push data to front of list.
+ *
+ * @param plls Plls handle.
+ * @param data Data to store.
+ *
+ * @return None.
+ */
+pl_none plls_push( plls_t plls, const pl_t data );
+
+
+/**
+ * @brief Pop data from front of list.
+ *
+ * @param plls Plls handle.
+ *
+ * @return Popped data.
+ */
+plls_node_t plls_pop( plls_t plls );
+
+
+/**
+ * @brief Return plls node overhead.
+ *
+ * @return Overhead in bytes.
+ */
+pl_size_t plls_node_overhead( void );
+
+
+/**
+ * @brief Return data from node.
+ *
+ * @param node Node.
+ *
+ * @return Data.
+ */
+pl_t plls_node_data( plls_node_t node );
+
+
+/**
+ * @brief Return next node.
+ *
+ * @param node Current node.
+ *
+ * @return Next node (or null).
+ */
+plls_node_p plls_node_next( plls_node_p node );
+
+
+/**
+ * @brief Is node at start of list?
+ *
+ * @param node Node.
+ * @param plls Plls handle.
+ *
+ * @return True if at start.
+ */
+pl_bool_t plls_node_at_start( plls_node_t node, plls_t plls );
+
+
+/**
+ * @brief Is node at end of list?
+ *
+ * @param node Node.
+ * @param plls Plls handle.
+ *
+ * @return True if at end.
+ */
+pl_bool_t plls_node_at_end( plls_node_t node, plls_t plls );
+
+
+/**
+ * @brief Return list host (plbm).
+ *
+ * @param plls Plls handle.
+ *
+ * @return Host.
+ */
+plbm_t plls_host( plls_t plls );
+
+
+/**
+ * @brief Return pointer to list head.
+ *
+ * @param plls Plls handle.
+ *
+ * @return Pointer to list head.
+ */
+plls_node_p plls_head( plls_t plls );
+
+
+/**
+ * @brief Return list tail (node).
+ *
+ * @param plls Plls handle.
+ *
+ * @return Pointer to list tail.
+ */
+plls_node_p plls_tail( plls_t plls );
+
+
+/**
+ * @brief Return node from list index.
+ *
+ * @param plls  Plls handle.
+ * @param index Node index.
+ *
+ * @return Pointer to node from index (or NULL);
+ */
+plls_node_p plls_index( plls_t plls, pl_size_t index );
+
+
+/**
+ * @brief Return node count of list.
+ *
+ * @param plls Plls handle.
+ *
+ * @return Node count.
+ */
+pl_size_t plls_size( plls_t plls );
+
+
+/**
+ * @brief Clear list, i.e. return all nodes to host.
+ *
+ * @param plls Plls handle.
+ *
+ * @return None.
+ */
+pl_none plls_clear( plls_t plls );
+
+
+
+/* ------------------------------------------------------------
+ * List (doubly-linked):
+ */
+
+/**
+ * @brief Initialize list to plbm.
+ *
+ * @param plbm Plbm handle.
+ *
+ * @return Plld.
+ */
+plld_s plld_init( plbm_t plbm );
+
+
+/**
+ * @brief Append after place.
+ *
+ * @param plld  Plld handle.
+ * @param place Place of append.
+ * @param data  Data to append.
+ *
+ * @return None.
+ */
+pl_none plld_append( plld_t plld, plld_node_t place, const pl_t data );
+
+
+/**
+ * @brief Append after place with size.
+ *
+ * @param plld  Plld handle.
+ * @param place Place of append.
+ * @param data  Data to append.
+ * @param size  Size of data.
+ *
+ * @return None.
+ */
+pl_none plld_append_with_size( plld_t plld, plld_node_t place, const pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Insert at place.
+ *
+ * @param plld  Plld handle.
+ * @param place Place of insert.
+ * @param data  Data to insert.
+ *
+ * @return None.
+ */
+pl_none plld_insert( plld_t plld, plld_node_t place, const pl_t data );
+
+
+/**
+ * @brief Insert at place with size.
+ *
+ * @param plld  Plld handle.
+ * @param place Place of insert.
+ * @param data  Data to insert.
+ * @param size  Size of data.
+ *
+ * @return None.
+ */
+pl_none plld_insert_with_size( plld_t plld, plld_node_t place, const pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Remove node from list.
+ *
+ * @param plld  Plld handle.
+ * @param place Place of removal.
+ *
+ * @return Next node (if possible).
+ */
+plld_node_t plld_remove( plld_t plld, plld_node_t place );
+
+
+/**
+ * @brief Store data at end of list.
+ *
+ * @param plld Plld handle.
+ * @param data Data to store.
+ *
+ * @return None.
+ */
+pl_none plld_store( plld_t plld, const pl_t data );
+
+
+/**
+ * @brief Store data at end of list.
+ *
+ * @param plld Plld handle.
+ * @param data Data to store.
+ * @param size Size of data.
+ *
+ * @return None.
+ */
+pl_none plld_store_with_size( plld_t plld, const pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Return plld node overhead.
+ *
+ * @return Overhead in bytes.
+ */
+pl_size_t plld_node_overhead( void );
+
+
+/**
+ * @brief Return data from node.
+ *
+ * @param node Node.
+ *
+ * @return Data.
+ */
+pl_t plld_node_data( plld_node_t node );
+
+
+/**
+ * @brief Return next node.
+ *
+ * @param node Current node.
+ *
+ * @return Next node (or null).
+ */
+plld_node_t plld_node_next( plld_node_t node );
+
+
+/**
+ * @brief Return previous node.
+ *
+ * @param node Current node.
+ *
+ * @return Previous node (or null).
+ */
+plld_node_t plld_node_prev( plld_node_t node );
+
+
+/**
+ * @brief Is node at start of list?
+ *
+ * @param node Node.
+ *
+ * @return True if at start.
+ */
+pl_bool_t plld_node_at_start( plld_node_t node );
+
+
+/**
+ * @brief Is node at end of list?
+ *
+ * @param node Node.
+ *
+ * @return True if at end.
+ */
+pl_bool_t plld_node_at_end( plld_node_t node );
+
+
+/**
+ * @brief Return list host (plbm).
+ *
+ * @param plld Plld handle.
+ *
+ * @return Host.
+ */
+plbm_t plld_host( plld_t plld );
+
+
+/**
+ * @brief Return list head (node).
+ *
+ * @param plld Plld handle.
+ *
+ * @return List head node.
+ */
+plld_node_t plld_head( plld_t plld );
+
+
+/**
+ * @brief Return list tail (node).
+ *
+ * @param plld Plld handle.
+ *
+ * @return List tail node.
+ */
+plld_node_t plld_tail( plld_t plld );
+
+
+/**
+ * @brief Return node from list index.
+ *
+ * @param plld  Plld handle.
+ * @param index Node index.
+ *
+ * @return Node from index (or NULL);
+ */
+plld_node_t plld_index( plld_t plld, pl_size_t index );
+
+
+/**
+ * @brief Return node count of list.
+ *
+ * @param plld Plld handle.
+ *
+ * @return Node count.
+ */
+pl_size_t plld_size( plld_t plld );
+
+
+/**
+ * @brief Clear list, i.e. return all nodes to host.
+ *
+ * @param plld Plld handle.
+ *
+ * @return None.
+ */
+pl_none plld_clear( plld_t plld );
+
+
+
+/* ------------------------------------------------------------
+ * List (doubly-linked with handles):
+ */
+
+/**
+ * @brief Initialize list to plbh.
+ *
+ * @param plbh Plbh handle.
+ *
+ * @return Pllh.
+ */
+pllh_s pllh_init( plbh_t plbh );
+
+
+/**
+ * @brief Append after place.
+ *
+ * @param pllh  Pllh handle.
+ * @param place Place of append.
+ * @param data  Data to append.
+ *
+ * @return None.
+ */
+pl_none pllh_append( pllh_t pllh, pl_bh_t place, const pl_t data );
+
+
+/**
+ * @brief Append after place with size.
+ *
+ * @param pllh  Pllh handle.
+ * @param place Place of append.
+ * @param data  Data to append.
+ * @param size  Size of data.
+ *
+ * @return None.
+ */
+pl_none pllh_append_with_size( pllh_t pllh, pl_bh_t place, const pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Insert at place.
+ *
+ * @param pllh  Pllh handle.
+ * @param place Place of insert.
+ * @param data  Data to insert.
+ *
+ * @return None.
+ */
+pl_none pllh_insert( pllh_t pllh, pl_bh_t place, const pl_t data );
+
+
+/**
+ * @brief Insert at place with size.
+ *
+ * @param pllh  Pllh handle.
+ * @param place Place of insert.
+ * @param data  Data to insert.
+ * @param size  Size of data.
+ *
+ * @return None.
+ */
+pl_none pllh_insert_with_size( pllh_t pllh, pl_bh_t place, const pl_t data, pl_size_t size );
+
+
+/**
+ * @brief Remove node from list.
+ *
+ * @param pllh  Pllh handle.
+ * @param place Place of removal.
+ *
+ * @return Next node (if possible).
+ */
+pl_bh_t pllh_remove( pllh_t pllh, pl_bh_t place );
 
 
 /**
- * @brief Return item from array.
+ * @brief Store data at end of list.
  *
- * @param plar  Plar.
- * @param index Index.
+ * @param pllh Pllh handle.
+ * @param data Data to store.
  *
- * @return Item.
+ * @return None.
  */
-pl_t plar_get( plar_s plar, pl_size_t index );
+pl_none pllh_store( pllh_t pllh, const pl_t data );
 
 
 /**
- * @brief Set values of item(s).
+ * @brief Store data at end of list.
  *
- * @param plar  Plar.
- * @param index Start index.
- * @param count Count of items to set.
- * @param data  Values.
+ * @param pllh Pllh handle.
+ * @param data Data to store.
+ * @param size Size of data.
  *
  * @return None.
  */
-pl_none plar_set( plar_s plar, pl_size_t index, pl_size_t count, pl_t data );
+pl_none pllh_store_with_size( pllh_t pllh, const pl_t data, pl_size_t size );
 
 
 /**
- * @brief Insert values to array.
+ * @brief Return pllh node overhead.
  *
- *        === c
- *     ++++++++   ->   +++===+++++
- *        i               i
+ * @return Overhead in bytes.
+ */
+pl_size_t pllh_node_overhead( void );
+
+
+/**
+ * @brief Return data from node.
  *
- * @param plar  Plar.
- * @param index Start index for insertion.
- * @param count Count of items to insert.
- * @param data  Values to insert.
+ * @param pllh Pllh handle.
+ * @param node Node.
  *
- * @return Updated plar.
+ * @return Data.
  */
-plar_s plar_insert( plar_s plar, pl_size_t index, pl_size_t count, pl_t data );
+pl_t pllh_node_data( pllh_t pllh, pl_bh_t node );
 
 
 /**
- * @brief Remove slice from array.
- *
- *        --- c
- *     +++++++++++   ->   ++++++++
- *        i                  i
+ * @brief Return next node.
  *
- * @param plar  Plar.
- * @param index Start index.
- * @param count Count of items to remove.
+ * @param pllh Pllh handle.
+ * @param node Current node.
  *
- * @return Updated plar.
+ * @return Next node (or zero).
  */
-plar_s plar_remove( plar_s plar, pl_size_t index, pl_size_t count );
+pl_bh_t pllh_node_next( pllh_t pllh, pl_bh_t node );
 
 
 /**
- * @brief Return the byte size of item slice.
+ * @brief Return previous node.
  *
- * @param plar  Plar.
- * @param count Number of items.
+ * @param pllh Pllh handle.
+ * @param node Current node.
  *
- * @return Byte size.
+ * @return Previous node (or zero).
  */
-pl_size_t plar_size_of_slice( plar_s plar, pl_size_t count );
+pl_bh_t pllh_node_prev( pllh_t pllh, pl_bh_t node );
 
 
 /**
- * @brief Return the byte size of array items.
+ * @brief Return list head (node).
  *
- * @param plar Plar.
+ * @param pllh Pllh handle.
  *
- * @return Byte size.
+ * @return List head node.
  */
-pl_size_t plar_size_in_bytes( plar_s plar );
+pl_bh_t pllh_head( pllh_t pllh );
 
 
 /**
- * @brief Return array data.
+ * @brief Return list tail (node).
  *
- * @param plar Plar.
+ * @param pllh Pllh handle.
  *
- * @return Data.
+ * @return List tail node.
  */
-pl_t plar_data( plar_s plar );
+pl_bh_t pllh_tail( pllh_t pllh );
 
 
 /**
- * @brief Return array item size.
+ * @brief Return node count of list.
  *
- * @param plar Plar.
+ * @param pllh Pllh handle.
  *
- * @return Item size.
+ * @return Node count.
  */
-pl_size_t plar_step( plar_s plar );
+pl_size_t pllh_size( pllh_t pllh );
 
 
 /**
- * @brief Return array item count.
+ * @brief Clear list, i.e. return all nodes to host.
  *
- * @param plar Plar.
+ * @param pllh Pllh handle.
  *
- * @return Item count.
+ * @return None.
  */
-pl_size_t plar_size( plar_s plar );
+pl_none pllh_clear( pllh_t pllh );
 
 
 
 /* ------------------------------------------------------------
- * List (singly-linked):
+ * List (unrolled):
  */
 
 /**
  * @brief Initialize list to plbm.
  *
  * @param plbm Plbm handle.
+ * @param capa Data capasity per node.
  *
- * @return Plls.
+ * @return Pllu.
  */
-plls_s plls_init( plbm_t plbm );
+pllu_s pllu_init( plbm_t plbm, pl_size_t capa );
 
 
 /**
- * @brief Append after place.
+ * @brief Store data at end of list.
  *
- * @param plls  Plls handle.
- * @param place Place of append.
- * @param data  Data to append.
+ * @param pllu Pllu handle.
+ * @param data Data to store.
+ * @param size Data size.
  *
  * @return None.
  */
-pl_none plls_append( plls_t plls, plls_node_p place, const pl_t data );
+pl_none pllu_store( pllu_t pllu, const pl_t data, pl_size_t size );
 
 
 /**
- * @brief Append after place with size.
- *
- * @param plls  Plls handle.
- * @param place Place of append.
- * @param data  Data to append.
- * @param size  Size of data.
+ * @brief Return pllu node overhead.
  *
- * @return None.
+ * @return Overhead in bytes.
  */
-pl_none plls_append_with_size( plls_t plls, plls_node_p place, const pl_t data, pl_size_t size );
+pl_size_t pllu_node_overhead( void );
 
 
 /**
- * @brief Insert at place.
+ * @brief Initialize pllu cursor.
  *
- * @param plls  Plls handle.
- * @param place Place of insert.
- * @param data  Data to insert.
+ * @param pllu Pllu handle.
  *
- * @return None.
+ * @return Cursor.
  */
-pl_none plls_insert( plls_t plls, plls_node_p place, const pl_t data );
+
+pllu_cursor_s pllu_cursor_init( pllu_t pllu );
 
 
 /**
- * @brief Insert at place with size.
+ * @brief Initialize pllu cursor to end.
  *
- * @param plls  Plls handle.
- * @param place Place of insert.
- * @param data  Data to insert.
- * @param size  Size of data.
+ * @param pllu Pllu handle.
  *
- * @return None.
+ * @return Cursor.
  */
-pl_none plls_insert_with_size( plls_t plls, plls_node_p place, const pl_t data, pl_size_t size );
+pllu_cursor_s pllu_cursor_init_to_end( pllu_t pllu );
 
 
 /**
- * @brief Remove node from list.
- *
- * Current node is removed, if place is at list start and the node is
- * the only remaining.
+ * @brief Return node of cursor.
  *
- * @param plls  Plls handle.
- * @param place Place of removal.
+ * @param cursor Cursor.
  *
- * @return Pointer to current node (if possible).
+ * @return Node.
  */
-plls_node_p plls_remove( plls_t plls, plls_node_p place );
+pllu_node_t pllu_cursor_node( pllu_cursor_t cursor );
 
 
 /**
- * @brief Store data at end of list.
+ * @brief Return node data from cursor.
  *
- * @param plls Plls handle.
- * @param data Data to store.
+ * @param      cursor Cursor.
+ * @param[out] size   Data size.
  *
- * @return None.
+ * @return Data.
  */
-pl_none plls_store( plls_t plls, const pl_t data );
+pl_t pllu_cursor_data( pllu_cursor_t cursor, pl_size_p size );
 
 
 /**
- * @brief Store data at end of list.
+ * @brief Return node byte count from cursor.
  *
- * @param plls Plls handle.
- * @param data Data to store.
- * @param size Size of data.
+ * @param cursor Cursor.
  *
- * @return None.
+ * @return Byte count.
  */
-pl_none plls_store_with_size( plls_t plls, const pl_t data, pl_size_t size );
+pl_size_t pllu_cursor_used( pllu_cursor_t cursor );
 
 
 /**
- * @brief Push data to front of list.
+ * @brief Step to next node.
  *
- * @param plls Plls handle.
- * @param data Data to store.
+ * NOTE: cursor:node goes to NULL, when last node end is passed.
  *
- * @return None.
+ * @param cursor Current cursor.
  */
-pl_none plls_push( plls_t plls, const pl_t data );
+pl_none pllu_cursor_next( pllu_cursor_t cursor );
 
 
 /**
- * @brief Pop data from front of list.
+ * @brief Step to previous node.
  *
- * @param plls Plls handle.
+ * NOTE: cursor:node goes to NULL, when first node end is passed.
  *
- * @return Popped data.
+ * @param cursor Current cursor.
  */
-plls_node_t plls_pop( plls_t plls );
+pl_none pllu_cursor_prev( pllu_cursor_t cursor );
 
 
 /**
- * @brief Return plls node overhead.
+ * @brief Return node data from cursor and advance node.
  *
- * @return Overhead in bytes.
+ * NOTE: cursor:node goes to NULL, when last node end is passed.
+ *
+ * @param      cursor Cursor.
+ * @param[out] size   Byte count.
+ *
+ * @return Data.
  */
-pl_size_t plls_node_overhead( void );
+pl_t pllu_cursor_data_step( pllu_cursor_t cursor, pl_size_p size );
 
 
 /**
- * @brief Return data from node.
+ * @brief Return data from cursor position.
  *
- * @param node Node.
+ * @param cursor Cursor.
  *
  * @return Data.
  */
-pl_t plls_node_data( plls_node_t node );
+pl_t pllu_cursor_item( pllu_cursor_t cursor );
 
 
 /**
- * @brief Return next node.
+ * @brief Step to next cursor position.
  *
- * @param node Current node.
+ * NOTE: cursor:node goes to NULL, when last node end is passed.
  *
- * @return Next node (or null).
+ * @param cursor Current cursor.
+ * @param size   Item size;
+ *
+ * @return Next cursor (or null).
  */
-plls_node_p plls_node_next( plls_node_p node );
+pl_none pllu_cursor_next_item( pllu_cursor_t cursor, pl_size_t step );
 
 
 /**
- * @brief Is node at start of list?
+ * @brief Step to previous cursor position.
  *
- * @param node Node.
- * @param plls Plls handle.
+ * NOTE: cursor:node goes to NULL, when first node end is passed.
  *
- * @return True if at start.
+ * @param cursor Current cursor.
+ * @param size   Item size;
+ *
+ * @return Previous cursor (or null).
  */
-pl_bool_t plls_node_at_start( plls_node_t node, plls_t plls );
+pl_none pllu_cursor_prev_item( pllu_cursor_t cursor, pl_size_t step );
 
 
 /**
- * @brief Is node at end of list?
+ * @brief Return item from cursor and advance item.
  *
- * @param node Node.
- * @param plls Plls handle.
+ * NOTE: cursor:node goes to NULL, when last node end is passed.
  *
- * @return True if at end.
+ * @param cursor Cursor.
+ * @param size   Item size;
+ *
+ * @return Data.
  */
-pl_bool_t plls_node_at_end( plls_node_t node, plls_t plls );
+pl_t pllu_cursor_item_step( pllu_cursor_t cursor, pl_size_t step );
 
 
 /**
  * @brief Return list host (plbm).
  *
- * @param plls Plls handle.
+ * @param pllu Pllu handle.
  *
  * @return Host.
  */
-plbm_t plls_host( plls_t plls );
+plbm_t pllu_host( pllu_t pllu );
 
 
 /**
- * @brief Return pointer to list head.
+ * @brief Return list head (node).
  *
- * @param plls Plls handle.
+ * @param pllu Pllu handle.
  *
- * @return Pointer to list head.
+ * @return List head node.
  */
-plls_node_p plls_head( plls_t plls );
+pllu_node_t pllu_head( pllu_t pllu );
 
 
 /**
  * @brief Return list tail (node).
  *
- * @param plls Plls handle.
+ * @param pllu Pllu handle.
  *
- * @return Pointer to list tail.
+ * @return List tail node.
  */
-plls_node_p plls_tail( plls_t plls );
+pllu_node_t pllu_tail( pllu_t pllu );
+
+
+/**
+ * @brief Return node count of list.
+ *
+ * @param pllu Pllu handle.
+ *
+ * @return Node count.
+ */
+pl_size_t pllu_size( pllu_t pllu );
 
 
 /**
- * @brief Return node from list index.
+ * @brief Return data capacity per node.
  *
- * @param plls  Plls handle.
- * @param index Node index.
+ * @param pllu Pllu handle.
  *
- * @return Pointer to node from index (or NULL);
+ * @return Data capacity.
  */
-plls_node_p plls_index( plls_t plls, pl_size_t index );
+pl_size_t pllu_capa( pllu_t pllu );
 
 
 /**
- * @brief Return node count of list.
+ * @brief Clear list, i.e. return all nodes to host.
  *
- * @param plls Plls handle.
+ * @param pllu Pllu handle.
  *
- * @return Node count.
+ * @return None.
  */
-pl_size_t plls_size( plls_t plls );
+pl_none pllu_clear( pllu_t pllu );
 
 
 
 /* ------------------------------------------------------------
- * List (doubly-linked):
+ * Slot Map:
  */
 
 /**
- * @brief Initialize list to plbm.
+ * @brief Create plsm in heap (with debt).
  *
- * @param plbm Plbm handle.
+ * @param plsm  Plsm handle.
+ * @param isize Item size.
  *
- * @return Plld.
+ * @return None.
  */
-plld_s plld_init( plbm_t plbm );
+pl_none plsm_new( plsm_t plsm, pl_size_t isize );
 
 
 /**
- * @brief Append after place.
+ * @brief Delete plsm.
  *
- * @param plld  Plld handle.
- * @param place Place of append.
- * @param data  Data to append.
+ * @param plsm Plsm handle.
  *
  * @return None.
  */
-pl_none plld_append( plld_t plld, plld_node_t place, const pl_t data );
+pl_none plsm_del( plsm_t plsm );
 
 
 /**
- * @brief Append after place with size.
+ * @brief Insert item (copy) to plsm.
  *
- * @param plld  Plld handle.
- * @param place Place of append.
- * @param data  Data to append.
- * @param size  Size of data.
+ * @param plsm Plsm handle.
+ * @param data Item data.
  *
- * @return None.
+ * @return Item id.
  */
-pl_none plld_append_with_size( plld_t plld, plld_node_t place, const pl_t data, pl_size_t size );
+pl_id_t plsm_insert( plsm_t plsm, const pl_t data );
 
 
 /**
- * @brief Insert at place.
+ * @brief Remove item from plsm.
  *
- * @param plld  Plld handle.
- * @param place Place of insert.
- * @param data  Data to insert.
+ * Last item is moved to the place of the removed item.
  *
- * @return None.
+ * @param plsm Plsm handle.
+ * @param id   Item id.
+ *
+ * @return True if item was found.
  */
-pl_none plld_insert( plld_t plld, plld_node_t place, const pl_t data );
+pl_bool_t plsm_remove( plsm_t plsm, pl_id_t id );
 
 
 /**
- * @brief Insert at place with size.
+ * @brief Reference item with id.
  *
- * @param plld  Plld handle.
- * @param place Place of insert.
- * @param data  Data to insert.
- * @param size  Size of data.
+ * Reference is valid until next insert or remove.
  *
- * @return None.
+ * @param plsm Plsm handle.
+ * @param id   Item id.
+ *
+ * @return Item, or NULL for stale (or invalid) id.
  */
-pl_none plld_insert_with_size( plld_t plld, plld_node_t place, const pl_t data, pl_size_t size );
+pl_t plsm_ref( plsm_t plsm, pl_id_t id );
 
 
 /**
- * @brief Remove node from list.
+ * @brief Return id of item at index.
  *
- * @param plld  Plld handle.
- * @param place Place of removal.
+ * @param plsm  Plsm handle.
+ * @param index Item index.
  *
- * @return Next node (if possible).
+ * @return Item id.
  */
-plld_node_t plld_remove( plld_t plld, plld_node_t place );
+pl_id_t plsm_id( plsm_t plsm, pl_size_t index );
 
 
 /**
- * @brief Store data at end of list.
+ * @brief Return items (for iteration).
  *
- * @param plld Plld handle.
- * @param data Data to store.
+ * @param plsm Plsm handle.
  *
- * @return None.
+ * @return Items.
  */
-pl_none plld_store( plld_t plld, const pl_t data );
+pl_t plsm_data( plsm_t plsm );
 
 
 /**
- * @brief Store data at end of list.
+ * @brief Return item count.
  *
- * @param plld Plld handle.
- * @param data Data to store.
- * @param size Size of data.
+ * @param plsm Plsm handle.
  *
- * @return None.
+ * @return Item count.
  */
-pl_none plld_store_with_size( plld_t plld, const pl_t data, pl_size_t size );
+pl_size_t plsm_size( plsm_t plsm );
 
 
 /**
- * @brief Return plld node overhead.
+ * @brief Remove all items.
  *
- * @return Overhead in bytes.
- */
-pl_size_t plld_node_overhead( void );
-
-
-/**
- * @brief Return data from node.
+ * All ids become stale.
  *
- * @param node Node.
+ * @param plsm Plsm handle.
  *
- * @return Data.
+ * @return None.
  */
-pl_t plld_node_data( plld_node_t node );
+pl_none plsm_clear( plsm_t plsm );
+
+
 
+/* ------------------------------------------------------------
+ * Gap Buffer:
+ */
 
 /**
- * @brief Return next node.
+ * @brief Create plgb in heap (with debt).
  *
- * @param node Current node.
+ * @param plgb Plgb handle.
+ * @param size Initial storage size.
  *
- * @return Next node (or null).
+ * @return None.
  */
-plld_node_t plld_node_next( plld_node_t node );
+pl_none plgb_new( plgb_t plgb, pl_size_t size );
 
 
 /**
- * @brief Return previous node.
+ * @brief Delete plgb.
  *
- * @param node Current node.
+ * @param plgb Plgb handle.
  *
- * @return Previous node (or null).
+ * @return None.
  */
-plld_node_t plld_node_prev( plld_node_t node );
+pl_none plgb_del( plgb_t plgb );
 
 
 /**
- * @brief Is node at start of list?
+ * @brief Return content length.
  *
- * @param node Node.
+ * @param plgb Plgb handle.
  *
- * @return True if at start.
+ * @return Content length.
  */
-pl_bool_t plld_node_at_start( plld_node_t node );
+pl_size_t plgb_length( plgb_t plgb );
 
 
 /**
- * @brief Is node at end of list?
+ * @brief Move gap to position.
  *
- * @param node Node.
+ * Content between the current and the new position is moved.
  *
- * @return True if at end.
+ * @param plgb Plgb handle.
+ * @param pos  Position (at most length).
+ *
+ * @return None.
  */
-pl_bool_t plld_node_at_end( plld_node_t node );
+pl_none plgb_move( plgb_t plgb, pl_pos_t pos );
 
 
 /**
- * @brief Return list host (plbm).
+ * @brief Insert data to position.
  *
- * @param plld Plld handle.
+ * Nothing is inserted, if storage can't grow.
  *
- * @return Host.
+ * @param plgb Plgb handle.
+ * @param pos  Position (at most length).
+ * @param data Data to insert.
+ * @param size Data size.
+ *
+ * @return None.
  */
-plbm_t plld_host( plld_t plld );
+pl_none plgb_insert( plgb_t plgb, pl_pos_t pos, const pl_t data, pl_size_t size );
 
 
 /**
- * @brief Return list head (node).
+ * @brief Remove data from position.
  *
- * @param plld Plld handle.
+ * @param plgb Plgb handle.
+ * @param pos  Position (nothing is removed beyond length).
+ * @param size Size to remove (limited to content end).
  *
- * @return List head node.
+ * @return None.
  */
-plld_node_t plld_head( plld_t plld );
+pl_none plgb_remove( plgb_t plgb, pl_pos_t pos, pl_size_t size );
 
 
 /**
- * @brief Return list tail (node).
+ * @brief Reference content at position.
  *
- * @param plld Plld handle.
+ * Reference is valid until next edit.
  *
- * @return List tail node.
+ * @param plgb Plgb handle.
+ * @param pos  Position.
+ *
+ * @return Reference.
  */
-plld_node_t plld_tail( plld_t plld );
+pl_t plgb_ref( plgb_t plgb, pl_pos_t pos );
 
 
 /**
- * @brief Return node from list index.
+ * @brief Return content as continuous string.
  *
- * @param plld  Plld handle.
- * @param index Node index.
+ * Gap is moved to the end, and content is null terminated. Plsr is
+ * valid until next edit.
  *
- * @return Node from index (or NULL);
+ * @param plgb Plgb handle.
+ *
+ * @return Content (null plsr, if storage can't grow).
  */
-plld_node_t plld_index( plld_t plld, pl_size_t index );
+plsr_s plgb_plsr( plgb_t plgb );
 
 
 /**
- * @brief Return node count of list.
+ * @brief Remove all content.
  *
- * @param plld Plld handle.
+ * @param plgb Plgb handle.
  *
- * @return Node count.
+ * @return None.
  */
-pl_size_t plld_size( plld_t plld );
+pl_none plgb_clear( plgb_t plgb );
 
 
 
 /* ------------------------------------------------------------
- * List (unrolled):
+ * Rope:
  */
 
 /**
- * @brief Initialize list to plbm.
+ * @brief Initialize rope to plbm.
  *
  * @param plbm Plbm handle.
  * @param capa Data capasity per node.
  *
- * @return Pllu.
+ * @return Plro.
  */
-pllu_s pllu_init( plbm_t plbm, pl_size_t capa );
+plro_s plro_init( plbm_t plbm, pl_size_t capa );
 
 
 /**
- * @brief Store data at end of list.
+ * @brief Return plro node overhead.
  *
- * @param pllu Pllu handle.
- * @param data Data to store.
+ * Plbm block size is capasity plus overhead.
+ *
+ * @return Node overhead.
+ */
+pl_size_t plro_node_overhead( void );
+
+
+/**
+ * @brief Return content length.
+ *
+ * @param plro Plro handle.
+ *
+ * @return Content length.
+ */
+pl_size_t plro_length( plro_t plro );
+
+
+/**
+ * @brief Insert data to position.
+ *
+ * @param plro Plro handle.
+ * @param pos  Position (at most length).
+ * @param data Data to insert.
  * @param size Data size.
  *
  * @return None.
  */
-pl_none pllu_store( pllu_t pllu, const pl_t data, pl_size_t size );
+pl_none plro_insert( plro_t plro, pl_pos_t pos, const pl_t data, pl_size_t size );
 
 
 /**
- * @brief Return pllu node overhead.
+ * @brief Remove data from position.
  *
- * @return Overhead in bytes.
+ * @param plro Plro handle.
+ * @param pos  Position.
+ * @param size Size to remove (limited to content end).
+ *
+ * @return None.
  */
-pl_size_t pllu_node_overhead( void );
+pl_none plro_remove( plro_t plro, pl_pos_t pos, pl_size_t size );
 
 
 /**
- * @brief Initialize pllu cursor.
+ * @brief Split rope at position.
  *
- * @param pllu Pllu handle.
+ * Plro keeps the content before position, and the rest is returned
+ * as a new rope (with the same host).
  *
- * @return Cursor.
+ * @param plro Plro handle.
+ * @param pos  Position.
+ *
+ * @return Content after position.
  */
-
-pllu_cursor_s pllu_cursor_init( pllu_t pllu );
+plro_s plro_split( plro_t plro, pl_pos_t pos );
 
 
 /**
- * @brief Initialize pllu cursor to end.
+ * @brief Concatenate rope to end of plro.
  *
- * @param pllu Pllu handle.
+ * Ropes must have the same host. Other rope becomes empty.
  *
- * @return Cursor.
+ * @param plro  Plro handle.
+ * @param other Rope to concatenate.
+ *
+ * @return None.
  */
-pllu_cursor_s pllu_cursor_init_to_end( pllu_t pllu );
+pl_none plro_concat( plro_t plro, plro_t other );
 
 
 /**
- * @brief Return node of cursor.
+ * @brief Reference content at position.
  *
- * @param cursor Cursor.
+ * @param plro Plro handle.
+ * @param pos  Position.
  *
- * @return Node.
+ * @return Reference, or NULL if position is out of range.
  */
-pllu_node_t pllu_cursor_node( pllu_cursor_t cursor );
+pl_t plro_ref( plro_t plro, pl_pos_t pos );
 
 
 /**
- * @brief Return node data from cursor.
+ * @brief Store content to end of plcm.
  *
- * @param      cursor Cursor.
- * @param[out] size   Data size.
+ * Nothing is stored, if plcm can't grow.
  *
- * @return Data.
+ * @param plro Plro handle.
+ * @param plcm Plcm handle.
+ *
+ * @return None.
  */
-pl_t pllu_cursor_data( pllu_cursor_t cursor, pl_size_p size );
+pl_none plro_flatten( plro_t plro, plcm_t plcm );
 
 
 /**
- * @brief Return node byte count from cursor.
+ * @brief Remove all content, i.e. return all nodes to host.
  *
- * @param cursor Cursor.
+ * @param plro Plro handle.
  *
- * @return Byte count.
+ * @return None.
  */
-pl_size_t pllu_cursor_used( pllu_cursor_t cursor );
+pl_none plro_clear( plro_t plro );
 
 
 /**
- * @brief Step to next node.
+ * @brief Initialize plro cursor to position.
  *
- * NOTE: cursor:node goes to NULL, when last node end is passed.
+ * @param plro Plro handle.
+ * @param pos  Position.
  *
- * @param cursor Current cursor.
+ * @return Cursor.
  */
-pl_none pllu_cursor_next( pllu_cursor_t cursor );
+plro_cursor_s plro_cursor_init( plro_t plro, pl_pos_t pos );
 
 
 /**
- * @brief Step to previous node.
+ * @brief Return content slice at cursor, and advance cursor.
  *
- * NOTE: cursor:node goes to NULL, when first node end is passed.
+ * Slice extends from cursor to end of node, and it is not null
+ * terminated.
  *
- * @param cursor Current cursor.
+ * @param cursor Cursor.
+ *
+ * @return Slice, or null plsr at end.
  */
-pl_none pllu_cursor_prev( pllu_cursor_t cursor );
+plsr_s plro_cursor_next( plro_cursor_t cursor );
+
 
 
+/* ------------------------------------------------------------
+ * Ring Buffer:
+ */
+
 /**
- * @brief Return node data from cursor and advance node.
+ * @brief Create plrb in heap (with debt).
  *
- * NOTE: cursor:node goes to NULL, when last node end is passed.
+ * Item size of 0 creates an invalid plrb, which does not accept items.
  *
- * @param      cursor Cursor.
- * @param[out] size   Byte count.
+ * @param plrb  Plrb handle.
+ * @param isize Item size.
+ * @param count Initial item capacity.
  *
- * @return Data.
+ * @return None.
  */
-pl_t pllu_cursor_data_step( pllu_cursor_t cursor, pl_size_p size );
+pl_none plrb_new( plrb_t plrb, pl_size_t isize, pl_size_t count );
 
 
 /**
- * @brief Return data from cursor position.
+ * @brief Delete plrb.
  *
- * @param cursor Cursor.
+ * @param plrb Plrb handle.
  *
- * @return Data.
+ * @return None.
  */
-pl_t pllu_cursor_item( pllu_cursor_t cursor );
+pl_none plrb_del( plrb_t plrb );
 
 
 /**
- * @brief Step to next cursor position.
+ * @brief Add item (copy) to end.
  *
- * NOTE: cursor:node goes to NULL, when last node end is passed.
+ * Nothing is added, if plrb is invalid or storage can't grow.
  *
- * @param cursor Current cursor.
- * @param size   Item size;
+ * @param plrb Plrb handle.
+ * @param item Item data.
  *
- * @return Next cursor (or null).
+ * @return None.
  */
-pl_none pllu_cursor_next_item( pllu_cursor_t cursor, pl_size_t step );
+pl_none plrb_push_back( plrb_t plrb, const pl_t item );
 
 
 /**
- * @brief Step to previous cursor position.
+ * @brief Add item (copy) to front.
  *
- * NOTE: cursor:node goes to NULL, when first node end is passed.
+ * Nothing is added, if plrb is invalid or storage can't grow.
  *
- * @param cursor Current cursor.
- * @param size   Item size;
+ * @param plrb Plrb handle.
+ * @param item Item data.
  *
- * @return Previous cursor (or null).
+ * @return None.
  */
-pl_none pllu_cursor_prev_item( pllu_cursor_t cursor, pl_size_t step );
+pl_none plrb_push_front( plrb_t plrb, const pl_t item );
 
 
 /**
- * @brief Return item from cursor and advance item.
- *
- * NOTE: cursor:node goes to NULL, when last node end is passed.
+ * @brief Remove item from end.
  *
- * @param cursor Cursor.
- * @param size   Item size;
+ * @param plrb Plrb handle.
+ * @param item Storage for item data (or NULL).
  *
- * @return Data.
+ * @return True if item was removed.
  */
-pl_t pllu_cursor_item_step( pllu_cursor_t cursor, pl_size_t step );
+pl_bool_t plrb_pop_back( plrb_t plrb, pl_t item );
 
 
 /**
- * @brief Return list host (plbm).
+ * @brief Remove item from front.
  *
- * @param pllu Pllu handle.
+ * @param plrb Plrb handle.
+ * @param item Storage for item data (or NULL).
  *
- * @return Host.
+ * @return True if item was removed.
  */
-plbm_t pllu_host( pllu_t pllu );
+pl_bool_t plrb_pop_front( plrb_t plrb, pl_t item );
 
 
 /**
- * @brief Return list head (node).
+ * @brief Reference item at index.
  *
- * @param pllu Pllu handle.
+ * Index 0 is the front item. Reference is valid until next push.
  *
- * @return List head node.
+ * @param plrb  Plrb handle.
+ * @param index Item index.
+ *
+ * @return Item, or NULL if index is out of range.
  */
-pllu_node_t pllu_head( pllu_t pllu );
+pl_t plrb_ref( plrb_t plrb, pl_size_t index );
 
 
 /**
- * @brief Return list tail (node).
+ * @brief Return item count.
  *
- * @param pllu Pllu handle.
+ * @param plrb Plrb handle.
  *
- * @return List tail node.
+ * @return Item count.
  */
-pllu_node_t pllu_tail( pllu_t pllu );
+pl_size_t plrb_count( plrb_t plrb );
 
 
 /**
- * @brief Return node count of list.
+ * @brief Return items as continuous spans.
  *
- * @param pllu Pllu handle.
+ * Items are in one span, or in two spans if the storage is wrapped
+ * around. Spans are valid until next push.
  *
- * @return Node count.
+ * @param plrb  Plrb handle.
+ * @param spans Storage for two spans.
+ *
+ * @return Span count (0-2).
  */
-pl_size_t pllu_size( pllu_t pllu );
+pl_size_t plrb_spans( plrb_t plrb, plsr_s* spans );
 
 
 /**
- * @brief Return data capacity per node.
+ * @brief Remove all items.
  *
- * @param pllu Pllu handle.
+ * @param plrb Plrb handle.
  *
- * @return Data capacity.
+ * @return None.
  */
-pl_size_t pllu_capa( pllu_t pllu );
+pl_none plrb_clear( plrb_t plrb );
 
 
 #endif
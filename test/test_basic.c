@@ -82,6 +82,7 @@ void test_plam( void )
 {
     plam_s plam;
     plam_s plam2;
+    plam_s plam3;
     char   mem[ 1024 ];
     plbm_s plbm;
     pl_t   m;
@@ -228,7 +229,8 @@ void test_plam( void )
     TEST_ASSERT_EQUAL( 256, plam_used( &plam ) );
     TEST_ASSERT( m != NULL );
     m = plam_get( &plam, 1024 );
-    TEST_ASSERT( m == NULL );
+    TEST_ASSERT( m != NULL );
+    TEST_ASSERT_EQUAL( 256, plam_used( &plam ) );
     plam_del( &plam );
 
     plam_use( &plam2, mem, 1024 );
@@ -238,7 +240,8 @@ void test_plam( void )
     TEST_ASSERT_EQUAL( 256, plam_used( &plam ) );
     TEST_ASSERT( m != NULL );
     m = plam_get( &plam, 1024 );
-    TEST_ASSERT( m == NULL );
+    TEST_ASSERT( m != NULL );
+    TEST_ASSERT_EQUAL( 256, plam_used( &plam ) );
     plam_del( &plam );
 
 
@@ -281,6 +284,248 @@ void test_plam( void )
     plam_del( &plam );
 
 
+    /* Test plam_mark/plam_rewind. */
+    plam_mark_s mark;
+    plam_new( &plam, 1024 );
+    m = plam_get( &plam, 100 );
+    mark = plam_mark( &plam );
+    m1 = plam_get( &plam, 256 );
+    for ( int i = 0; i < 20; i++ ) {
+        m = plam_get( &plam, 256 );
+        TEST_ASSERT( m != NULL );
+    }
+    TEST_ASSERT( plam.node != mark.node );
+    plam_rewind( &plam, mark );
+    TEST_ASSERT( plam.node == mark.node );
+    TEST_ASSERT_EQUAL( 100, plam_used( &plam ) );
+    m2 = plam_get( &plam, 256 );
+    TEST_ASSERT( m1 == m2 );
+    /* Nodes after mark are reused from start. */
+    for ( int i = 0; i < 3; i++ ) {
+        m = plam_get( &plam, 256 );
+    }
+    TEST_ASSERT( plam.node == mark.node->next );
+    TEST_ASSERT_EQUAL( 256, plam_used( &plam ) );
+    plam_del( &plam );
+
+    plam_empty( &plam, 1024 );
+    mark = plam_mark( &plam );
+    TEST_ASSERT( mark.node == NULL );
+    m1 = plam_get( &plam, 512 );
+    m = plam_get( &plam, 512 );
+    m = plam_get( &plam, 512 );
+    plam_rewind( &plam, mark );
+    TEST_ASSERT_EQUAL( 0, plam_used( &plam ) );
+    m2 = plam_get( &plam, 512 );
+    TEST_ASSERT( m1 == m2 );
+    plam_del( &plam );
+
+
+    /* Test plam_grow and oversize allocations. */
+    plam_empty( &plam, 256 );
+    plam_grow( &plam, 4096 );
+    m = plam_get( &plam, 200 );
+    TEST_ASSERT_EQUAL( 256, plam_size( &plam ) );
+    m = plam_get( &plam, 200 );
+    TEST_ASSERT_EQUAL( 512, plam_size( &plam ) );
+    m = plam_get( &plam, 2000 );
+    TEST_ASSERT_EQUAL( 2048, plam_size( &plam ) );
+    TEST_ASSERT_EQUAL( 2000, plam_used( &plam ) );
+    TEST_ASSERT_EQUAL( 2048 - sizeof( pl_node_s ) - 2000, plam_free( &plam ) );
+    m = plam_get( &plam, 3000 );
+    TEST_ASSERT_EQUAL( 4096, plam_size( &plam ) );
+    mark = plam_mark( &plam );
+    m1 = plam_get( &plam, 10000 );
+    TEST_ASSERT( m1 != NULL );
+    memset( m1, 1, 10000 );
+    TEST_ASSERT_EQUAL( 3000, plam_used( &plam ) );
+    m2 = plam_get( &plam, 20000 );
+    TEST_ASSERT( m2 != NULL );
+    plam_put( &plam, 20000 );
+    TEST_ASSERT( plam.large != NULL && plam.large->next == NULL );
+    TEST_ASSERT_EQUAL( 3000, plam_used( &plam ) );
+    m2 = plam_get( &plam, 20000 );
+    plam_rewind( &plam, mark );
+    TEST_ASSERT( plam.large == NULL );
+    TEST_ASSERT_EQUAL( 3000, plam_used( &plam ) );
+    m1 = plam_get( &plam, 10000 );
+    plam_clear( &plam );
+    TEST_ASSERT( plam.large == NULL );
+    /* First (smallest) Node is reused. */
+    m = plam_get( &plam, 200 );
+    TEST_ASSERT_EQUAL( 256 - sizeof( pl_node_s ) - 200, plam_free( &plam ) );
+    plam_del( &plam );
+
+    plam_empty( &plam, 1024 );
+    m = plam_get( &plam, 5000 );
+    TEST_ASSERT( m != NULL );
+    TEST_ASSERT( !plam_is_empty( &plam ) );
+    TEST_ASSERT_EQUAL( 0, plam_used( &plam ) );
+    plam_del( &plam );
+    TEST_ASSERT( plam_is_empty( &plam ) );
+
+
+    /* Test mapped Nodes. */
+    plam_new_mmap( &plam, 1000, PL_MF_POPULATE );
+    TEST_ASSERT_EQUAL( 0, plam_size( &plam ) % 4096 );
+    TEST_ASSERT_EQUAL( plam_node_capacity( &plam ), plam_free( &plam ) );
+    m1 = plam_get( &plam, 1000 );
+    memset( m1, 1, 1000 );
+    plam_grow( &plam, 1 << 16 );
+    for ( int i = 0; i < 100; i++ ) {
+        m = plam_get( &plam, 1000 );
+        TEST_ASSERT( m != NULL );
+        memset( m, 1, 1000 );
+    }
+    m = plam_get( &plam, 100000 );
+    TEST_ASSERT( m != NULL );
+    memset( m, 1, 100000 );
+    plam_put( &plam, 100000 );
+    m = plam_get( &plam, 100000 );
+    plam_del( &plam );
+
+    plam_empty_mmap( &plam, 1000, PL_MF_HUGETLB | PL_MF_POPULATE );
+    TEST_ASSERT_EQUAL( PLINTH_HUGE_PAGE_SIZE, plam_size( &plam ) );
+    m = plam_get( &plam, 1000 );
+    TEST_ASSERT( m != NULL );
+    TEST_ASSERT_EQUAL( PLINTH_HUGE_PAGE_SIZE - sizeof( pl_node_s ) - 1000, plam_free( &plam ) );
+    plam_del( &plam );
+
+    plam_new_mmap( &plam, 2, PL_MF_HUGE );
+    TEST_ASSERT( plam_is_empty( &plam ) );
+
+    /* Test plam_set_zeroing. */
+    plam_empty_aligned( &plam, 1024, 64 );
+    plam_set_zeroing( &plam, pl_false );
+    TEST_ASSERT_EQUAL( PL_MF_NOZERO, plam.flags );
+    for ( int i = 0; i < 8; i++ ) {
+        m = plam_get( &plam, 500 );
+        memset( m, 1, 500 );
+    }
+    m = plam_get( &plam, 5000 );
+    memset( m, 1, 5000 );
+    plam_set_zeroing( &plam, pl_true );
+    TEST_ASSERT_EQUAL( 0, plam.flags );
+    plam_del( &plam );
+
+    plam_empty( &plam, 1024 );
+    plam_set_zeroing( &plam, pl_false );
+    m = plam_get( &plam, 500 );
+    memset( m, 1, 500 );
+    plam_del( &plam );
+
+
+    /* Test plam_trim. */
+    plam_new( &plam, 1024 );
+    for ( int i = 0; i < 16; i++ ) {
+        m = plam_get( &plam, 512 );
+    }
+    plam_clear( &plam );
+    plam_trim( &plam, 2, 0 );
+    TEST_ASSERT( plam.node->next->next != NULL );
+    TEST_ASSERT( plam.node->next->next->next == NULL );
+    plam_trim( &plam, 0, 1024 );
+    TEST_ASSERT( plam.node->next != NULL );
+    TEST_ASSERT( plam.node->next->next == NULL );
+    plam_trim( &plam, 0, 0 );
+    TEST_ASSERT( plam.node->next == NULL );
+    for ( int i = 0; i < 4; i++ ) {
+        m = plam_get( &plam, 512 );
+        TEST_ASSERT( m != NULL );
+    }
+    plam_del( &plam );
+
+    plam_use( &plam, mem, 1024 );
+    for ( int i = 0; i < 4; i++ ) {
+        m = plam_get( &plam, 512 );
+    }
+    plam_clear( &plam );
+    plam_trim( &plam, 0, 0 );
+    TEST_ASSERT( plam.node == (pl_node_t)mem );
+    TEST_ASSERT( plam.node->next == NULL );
+    plam_del( &plam );
+
+    plam_new( &plam2, 4096 );
+    plam_empty_into_plam( &plam, &plam2, 1024 );
+    for ( int i = 0; i < 3; i++ ) {
+        m = plam_get( &plam, 512 );
+    }
+    TEST_ASSERT_EQUAL( 3072, plam_used( &plam2 ) );
+    plam_clear( &plam );
+    plam_trim( &plam, 0, 0 );
+    TEST_ASSERT_EQUAL( 1024, plam_used( &plam2 ) );
+    plam_del( &plam );
+    TEST_ASSERT_EQUAL( 0, plam_used( &plam2 ) );
+    plam_del( &plam2 );
+
+    /* Nodes below host allocations are kept. */
+    plam_new( &plam2, 8192 );
+    plam_empty_into_plam( &plam, &plam2, 512 );
+    for ( int i = 0; i < 4; i++ ) {
+        m = plam_get( &plam, 400 );
+    }
+    m1 = plam_get( &plam2, 1000 );
+    TEST_ASSERT_EQUAL( 3048, plam_used( &plam2 ) );
+    plam_clear( &plam );
+    plam_trim( &plam, 0, 0 );
+    TEST_ASSERT_EQUAL( 3048, plam_used( &plam2 ) );
+    TEST_ASSERT( plam.node->next != NULL );
+    m2 = plam_get( &plam2, 100 );
+    TEST_ASSERT( m2 == (char*)m1 + 1000 );
+    plam_put( &plam2, 100 );
+    plam_put( &plam2, 1000 );
+    plam_trim( &plam, 0, 0 );
+    TEST_ASSERT_EQUAL( 512, plam_used( &plam2 ) );
+    TEST_ASSERT( plam.node->next == NULL );
+    plam_del( &plam );
+    TEST_ASSERT_EQUAL( 0, plam_used( &plam2 ) );
+    plam_del( &plam2 );
+
+    plam_trim( &plam, 0, 0 );
+
+
+    /* Test nested plam teardown (stack of scratch arenas). */
+    plam_new( &plam2, 1024 );
+    m1 = plam_get( &plam2, 100 );
+    plam_into_plam( &plam, &plam2, 512 );
+    for ( int i = 0; i < 8; i++ ) {
+        m = plam_get( &plam, 256 );
+    }
+    m = plam_get( &plam, 2000 );
+    plam_empty_into_plam( &plam3, &plam, 256 );
+    for ( int i = 0; i < 8; i++ ) {
+        m = plam_get( &plam3, 128 );
+    }
+    TEST_ASSERT( plam2.node->prev != NULL );
+    plam_del( &plam3 );
+    plam_del( &plam );
+    TEST_ASSERT( plam2.node->prev == NULL );
+    TEST_ASSERT( plam2.large == NULL );
+    TEST_ASSERT_EQUAL( 100, plam_used( &plam2 ) );
+    m2 = plam_get( &plam2, 100 );
+    TEST_ASSERT( m2 == (char*)m1 + 100 );
+    plam_del( &plam2 );
+
+    /* Oversize Nodes of nested plam are not taken from host. */
+    plam_new( &plam2, 8192 );
+    plam_into_plam( &plam, &plam2, 512 );
+    m = plam_get( &plam, 100 );
+    mark = plam_mark( &plam );
+    m = plam_get( &plam, 1000 );
+    TEST_ASSERT( plam.large != NULL );
+    TEST_ASSERT_EQUAL( 512, plam_used( &plam2 ) );
+    m = plam_get( &plam, 400 );
+    TEST_ASSERT_EQUAL( 1024, plam_used( &plam2 ) );
+    plam_rewind( &plam, mark );
+    TEST_ASSERT( plam.large == NULL );
+    TEST_ASSERT_EQUAL( 1024, plam_used( &plam2 ) );
+    m1 = plam_get( &plam, 400 );
+    m2 = plam_get( &plam2, 1000 );
+    TEST_ASSERT( (char*)m2 >= (char*)m1 + 400 );
+    plam_del( &plam );
+    plam_del( &plam2 );
+
+
     /* Cover plam__node_del. */
     plam_new( &plam, 1024 );
     TEST_ASSERT_EQUAL( 0, plam_used( &plam ) );
@@ -344,7 +589,7 @@ void test_plam( void )
     TEST_ASSERT_EQUAL( 512, plam_used( &plam ) );
     TEST_ASSERT( m != NULL );
     m = plam_get_aligned( &plam, 256, 256 );
-    TEST_ASSERT_EQUAL( 1000, plam_used( &plam ) );
+    TEST_ASSERT_EQUAL( 992, plam_used( &plam ) );
     TEST_ASSERT( m != NULL );
     m = plam_get_aligned( &plam, 256, 0 );
     TEST_ASSERT_EQUAL( 256, plam_used( &plam ) );
@@ -362,7 +607,7 @@ void test_plam( void )
     TEST_ASSERT_EQUAL( 512, plam_used( &plam ) );
     TEST_ASSERT( m != NULL );
     m = plam_get_aligned( &plam, 256, 256 );
-    TEST_ASSERT_EQUAL( 1000, plam_used( &plam ) );
+    TEST_ASSERT_EQUAL( 992, plam_used( &plam ) );
     TEST_ASSERT( m != NULL );
     m = plam_get_aligned( &plam, 256, 0 );
     TEST_ASSERT_EQUAL( 256, plam_used( &plam ) );
@@ -372,6 +617,193 @@ void test_plam( void )
 }
 
 
+static pl_t plnd_worker( pl_t arg )
+{
+    plam_t plam;
+    char*  s;
+    int    ok;
+
+    ok = 1;
+    plam = plam_local( (plnd_t)arg );
+    for ( int i = 0; i < 100; i++ ) {
+        s = plam_format_string( plam, "item%d", i );
+        if ( s == NULL ) {
+            ok = 0;
+        }
+    }
+    if ( plam != plam_local( (plnd_t)arg ) ) {
+        ok = 0;
+    }
+    /* Nodes are returned to plnd at thread exit. */
+    return ok ? arg : NULL;
+}
+
+
+void test_plnd( void )
+{
+    plnd_s    plnd;
+    plam_s    plam;
+    plam_t    local;
+    pthread_t thread[ 4 ];
+    pl_t      ret;
+    pl_t      m;
+    pl_size_t count;
+
+    plnd_new( &plnd, 256 );
+    TEST_ASSERT_EQUAL( 0, plnd_count( &plnd ) );
+    TEST_ASSERT_EQUAL( 256, plnd_node_size( &plnd ) );
+    TEST_ASSERT_EQUAL( 2, plnd_reserve( &plnd, 2 ) );
+
+    /* Nested plam, nodes from depot. */
+    plam_into_plnd( &plam, &plnd );
+    TEST_ASSERT_EQUAL( 1, plnd_count( &plnd ) );
+    for ( int i = 0; i < 4; i++ ) {
+        m = plam_get( &plam, 200 );
+        TEST_ASSERT( m != NULL );
+    }
+    TEST_ASSERT_EQUAL( 0, plnd_count( &plnd ) );
+    plam_del( &plam );
+    TEST_ASSERT_EQUAL( 4, plnd_count( &plnd ) );
+
+    plam_empty_into_plnd( &plam, &plnd );
+    TEST_ASSERT( plam_is_empty( &plam ) );
+    m = plam_get( &plam, 200 );
+    TEST_ASSERT( m != NULL );
+    TEST_ASSERT_EQUAL( 3, plnd_count( &plnd ) );
+    plam_del( &plam );
+    TEST_ASSERT_EQUAL( 4, plnd_count( &plnd ) );
+
+    /* Thread local plams. */
+    for ( int i = 0; i < 4; i++ ) {
+        pthread_create( &thread[ i ], NULL, plnd_worker, &plnd );
+    }
+    for ( int i = 0; i < 4; i++ ) {
+        pthread_join( thread[ i ], &ret );
+        TEST_ASSERT( ret == &plnd );
+    }
+    count = plnd_count( &plnd );
+    TEST_ASSERT( count >= 4 );
+
+    local = plam_local( &plnd );
+    m = plam_get( local, 200 );
+    TEST_ASSERT( m != NULL );
+    TEST_ASSERT_EQUAL( count - 1, plnd_count( &plnd ) );
+    plam_local_del();
+    TEST_ASSERT_EQUAL( count, plnd_count( &plnd ) );
+
+    plnd_del( &plnd );
+}
+
+
+#define PLAS_THREADS 8
+#define PLAS_ALLOCS 5000
+
+pl_struct( plas_range )
+{
+    uint8_t*  mem;
+    pl_size_t size;
+};
+
+pl_struct( plas_job )
+{
+    plas_t       plas;
+    pl_size_t    id;
+    plas_range_s range[ PLAS_ALLOCS ];
+};
+
+static pl_t plas_worker( pl_t arg )
+{
+    plas_job_t job;
+    pl_size_t  size;
+
+    job = arg;
+    for ( pl_size_t i = 0; i < PLAS_ALLOCS; i++ ) {
+        size = 1 + ( ( i * 7 + job->id ) % 61 );
+        job->range[ i ].mem = plas_get( job->plas, size );
+        job->range[ i ].size = size;
+        if ( job->range[ i ].mem ) {
+            memset( job->range[ i ].mem, (int)job->id + 1, size );
+        }
+    }
+    return NULL;
+}
+
+static int plas_range_compare( const void* a, const void* b )
+{
+    const plas_range_s* ra = a;
+    const plas_range_s* rb = b;
+    if ( ra->mem < rb->mem ) {
+        return -1;
+    } else if ( ra->mem > rb->mem ) {
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+
+void test_plas( void )
+{
+    plas_s         plas;
+    pthread_t      thread[ PLAS_THREADS ];
+    plas_job_t     job;
+    plas_range_t   all;
+    pl_size_t      count;
+    pl_bool_t      intact;
+    pl_t           m;
+    char*          s1;
+
+    plas_new( &plas, 1024 );
+    TEST_ASSERT_EQUAL( 1024 - sizeof( pl_node_s ), plas_node_capacity( &plas ) );
+    TEST_ASSERT( plas_get( &plas, 1024 ) == NULL );
+    s1 = "testing...";
+    m = plas_store( &plas, s1, strlen( s1 ) + 1 );
+    TEST_ASSERT( strcmp( s1, m ) == 0 );
+    plas_del( &plas );
+
+    plas_new( &plas, 2 );
+    TEST_ASSERT( plas_get( &plas, 1 ) == NULL );
+    plas_del( &plas );
+
+    /* Concurrent allocations must not overlap. */
+    plas_new( &plas, 4096 );
+    job = pl_alloc_memory( PLAS_THREADS * sizeof( plas_job_s ) );
+    for ( pl_size_t i = 0; i < PLAS_THREADS; i++ ) {
+        job[ i ].plas = &plas;
+        job[ i ].id = i;
+        pthread_create( &thread[ i ], NULL, plas_worker, &job[ i ] );
+    }
+    for ( pl_size_t i = 0; i < PLAS_THREADS; i++ ) {
+        pthread_join( thread[ i ], NULL );
+    }
+
+    count = PLAS_THREADS * PLAS_ALLOCS;
+    all = pl_alloc_memory( count * sizeof( plas_range_s ) );
+    intact = pl_true;
+    for ( pl_size_t i = 0; i < PLAS_THREADS; i++ ) {
+        for ( pl_size_t j = 0; j < PLAS_ALLOCS; j++ ) {
+            TEST_ASSERT( job[ i ].range[ j ].mem != NULL );
+            for ( pl_size_t k = 0; k < job[ i ].range[ j ].size; k++ ) {
+                if ( job[ i ].range[ j ].mem[ k ] != i + 1 ) {
+                    intact = pl_false;
+                }
+            }
+            all[ i * PLAS_ALLOCS + j ] = job[ i ].range[ j ];
+        }
+    }
+    TEST_ASSERT( intact );
+
+    qsort( all, count, sizeof( plas_range_s ), plas_range_compare );
+    for ( pl_size_t i = 1; i < count; i++ ) {
+        TEST_ASSERT( all[ i - 1 ].mem + all[ i - 1 ].size <= all[ i ].mem );
+    }
+
+    pl_free_memory( all );
+    pl_free_memory( job );
+    plas_del( &plas );
+}
+
+
 void test_plbm( void )
 {
     plbm_s plbm;
@@ -421,6 +853,105 @@ void test_plbm( void )
     }
     plbm_del( &plbm );
 
+    /* Test batch get and put. */
+    plbm_new_with_count( &plbm, 4, 8 );
+    TEST_ASSERT_EQUAL( 10, plbm_get_n( &plbm, mm, 10 ) );
+    for ( int i = 0; i < 10; i++ ) {
+        TEST_ASSERT( mm[ i ] != NULL );
+        *(pl_size_t*)mm[ i ] = i;
+    }
+    for ( int i = 0; i < 9; i++ ) {
+        *(pl_t*)mm[ i ] = mm[ i + 1 ];
+    }
+    plbm_put_chain( &plbm, mm[ 0 ], mm[ 9 ] );
+    m1 = plbm_get_chain( &plbm, 12 );
+    m2 = m1;
+    for ( int i = 0; i < 12; i++ ) {
+        if ( i < 10 ) {
+            TEST_ASSERT( m2 == mm[ i ] );
+        }
+        m3 = m2;
+        m2 = *(pl_t*)m2;
+    }
+    TEST_ASSERT( m2 == NULL );
+    plbm_put_chain( &plbm, m1, m3 );
+    TEST_ASSERT( plbm_get( &plbm ) == mm[ 0 ] );
+    TEST_ASSERT( plbm_get_chain( &plbm, 0 ) == NULL );
+    plbm_del( &plbm );
+
+    /* Batch get carves the init tail of Node at once. */
+    plbm_new_with_count( &plbm, 8, 16 );
+    m1 = plbm_get( &plbm );
+    m2 = plbm_get( &plbm );
+    plbm_put( &plbm, m1 );
+    TEST_ASSERT_EQUAL( 12, plbm_get_n( &plbm, mm, 12 ) );
+    TEST_ASSERT( mm[ 0 ] == m1 );
+    TEST_ASSERT( mm[ 1 ] == m2 + 16 );
+    for ( int i = 1; i < 11; i++ ) {
+        if ( i != 6 ) {
+            TEST_ASSERT( mm[ i + 1 ] == mm[ i ] + 16 );
+        }
+    }
+    TEST_ASSERT( plbm.node->prev != NULL );
+    TEST_ASSERT_EQUAL( 3, plbm.itail );
+    TEST_ASSERT( plbm.head == NULL );
+    plbm_put( &plbm, mm[ 3 ] );
+    plbm_put( &plbm, mm[ 2 ] );
+    m1 = plbm_get_chain( &plbm, 8 );
+    m2 = m1;
+    for ( int i = 0; i < 8; i++ ) {
+        if ( i < 2 ) {
+            TEST_ASSERT( m2 == mm[ 2 + i ] );
+        } else if ( i < 5 ) {
+            TEST_ASSERT( m2 == mm[ 11 ] + ( i - 1 ) * 16 );
+        }
+        m3 = m2;
+        m2 = *(pl_t*)m2;
+    }
+    TEST_ASSERT( m2 == NULL );
+    TEST_ASSERT_EQUAL( 5, plbm.itail );
+    plbm_del( &plbm );
+
+    /* Test plbm_trim. */
+    plbm_new_with_count( &plbm, 4, 8 );
+    for ( int i = 0; i < 16; i++ ) {
+        m1 = plbm_get( &plbm );
+    }
+    plbm_clear( &plbm );
+    plbm_trim( &plbm, 1, 0 );
+    TEST_ASSERT( plbm.node->next != NULL );
+    TEST_ASSERT( plbm.node->next->next == NULL );
+    plbm_trim( &plbm, 0, 0 );
+    TEST_ASSERT( plbm.node->next == NULL );
+    for ( int i = 0; i < 8; i++ ) {
+        m1 = plbm_get( &plbm );
+        TEST_ASSERT( m1 != NULL );
+    }
+    plbm_del( &plbm );
+
+    plbm_new( &plbm2, 128, 64 );
+    plbm_empty_into_plbm( &plbm, &plbm2, 8 );
+    for ( int i = 0; i < 16; i++ ) {
+        m1 = plbm_get( &plbm );
+    }
+    plbm_clear( &plbm );
+    TEST_ASSERT( plbm2.head == NULL );
+    plbm_trim( &plbm, 0, 0 );
+    TEST_ASSERT( plbm2.head != NULL );
+    plbm_del( &plbm );
+    plbm_del( &plbm2 );
+
+    plbm_new_mmap( &plbm, 1000, 8, PL_MF_HUGE );
+    TEST_ASSERT_EQUAL( 0, plbm_node_size( &plbm ) % 4096 );
+    for ( int i = 0; i < 1000; i++ ) {
+        m1 = plbm_get( &plbm );
+        TEST_ASSERT( m1 != NULL );
+        memset( m1, 1, 8 );
+    }
+    plbm_del( &plbm );
+    plbm_new_mmap( &plbm, 1, 0, PL_MF_NONE );
+    TEST_ASSERT( plbm_is_empty( &plbm ) );
+
     /* Test plbm_empty* */
     plbm_empty( &plbm, sizeof( pl_node_s ) + 2 * 8, 8 );
     m1 = plbm_get( &plbm );
@@ -552,6 +1083,533 @@ void test_plbm( void )
     s1 = plbm_ref_ptr( &plbm, m2 );
     TEST_ASSERT_TRUE( !strcmp( s2, s1 ) );
     plbm_del( &plbm );
+
+    /* Reclaim free Nodes. */
+    plbm_new_with_count( &plbm, 4, 32 );
+    for ( int i = 0; i < 12; i++ ) {
+        mm[ i ] = plbm_get( &plbm );
+    }
+    TEST_ASSERT_EQUAL( 0, plbm_reclaim( &plbm ) );
+    for ( int i = 4; i < 8; i++ ) {
+        plbm_put( &plbm, mm[ i ] );
+    }
+    plbm_put( &plbm, mm[ 0 ] );
+    TEST_ASSERT_EQUAL( 1, plbm_reclaim( &plbm ) );
+    TEST_ASSERT( plbm.node->prev->prev == NULL );
+    TEST_ASSERT_EQUAL( 3, plbm.node->prev->used );
+    TEST_ASSERT_EQUAL( 4, plbm.node->used );
+    TEST_ASSERT( plbm_get( &plbm ) == mm[ 0 ] );
+    plbm_del( &plbm );
+
+    /* Current Node becomes fresh. */
+    plbm_new_with_count( &plbm, 4, 32 );
+    for ( int i = 0; i < 6; i++ ) {
+        mm[ i ] = plbm_get( &plbm );
+    }
+    plbm_put( &plbm, mm[ 5 ] );
+    plbm_put( &plbm, mm[ 4 ] );
+    TEST_ASSERT_EQUAL( 0, plbm_reclaim( &plbm ) );
+    TEST_ASSERT( plbm.head == NULL );
+    TEST_ASSERT_EQUAL( 4, plbm.itail );
+    TEST_ASSERT( plbm_get( &plbm ) == mm[ 4 ] );
+    plbm_del( &plbm );
+
+    /* User Node is kept. */
+    plbm_use( &plbm, mem, sizeof( pl_node_s ) + 4 * 32, 32 );
+    for ( int i = 0; i < 6; i++ ) {
+        mm[ i ] = plbm_get( &plbm );
+    }
+    for ( int i = 0; i < 4; i++ ) {
+        plbm_put( &plbm, mm[ i ] );
+    }
+    TEST_ASSERT_EQUAL( 0, plbm_reclaim( &plbm ) );
+    TEST_ASSERT( plbm.node->prev == (pl_node_t)mem );
+    TEST_ASSERT( plbm_get( &plbm ) == mm[ 3 ] );
+    plbm_del( &plbm );
+
+    /* Plam host Nodes are reused. */
+    plam_new( &plam, 4096 );
+    plbm_into_plam( &plbm, &plam, sizeof( pl_node_s ) + 4 * 32, 32 );
+    for ( int i = 0; i < 9; i++ ) {
+        mm[ i ] = plbm_get( &plbm );
+    }
+    for ( int i = 0; i < 4; i++ ) {
+        plbm_put( &plbm, mm[ i ] );
+    }
+    TEST_ASSERT_EQUAL( 1, plbm_reclaim( &plbm ) );
+    TEST_ASSERT( plbm.node->next == (pl_node_t)( mm[ 0 ] - sizeof( pl_node_s ) ) );
+    TEST_ASSERT( plbm.node->prev->prev == NULL );
+    for ( int i = 0; i < 3; i++ ) {
+        plbm_get( &plbm );
+    }
+    TEST_ASSERT( plbm_get( &plbm ) == mm[ 0 ] );
+    plbm_del( &plbm );
+    plam_del( &plam );
+
+    /* Aligned Blocks. */
+    plbm_new_aligned( &plbm, 1000, 40, 64 );
+    TEST_ASSERT_EQUAL( 64, plbm_block_size( &plbm ) );
+    TEST_ASSERT_EQUAL( ( 1024 - 64 ) / 64, plbm.imax );
+    for ( int i = 0; i < 24; i++ ) {
+        mm[ i ] = plbm_get( &plbm );
+        TEST_ASSERT_EQUAL( 0, (pl_size_t)mm[ i ] % 64 );
+        memset( mm[ i ], 0xff, 64 );
+    }
+    TEST_ASSERT( plbm.node->prev != NULL );
+    plbm_del( &plbm );
+
+    plam_new( &plam, 4096 );
+    plam_get( &plam, 8 );
+    plbm_into_plam_aligned( &plbm, &plam, 512, 32, 128 );
+    TEST_ASSERT_EQUAL( 128, plbm_block_size( &plbm ) );
+    TEST_ASSERT_EQUAL( ( 512 - sizeof( pl_node_s ) - 127 ) / 128, plbm.imax );
+    for ( int i = 0; i < 8; i++ ) {
+        mm[ i ] = plbm_get( &plbm );
+        TEST_ASSERT_EQUAL( 0, (pl_size_t)mm[ i ] % 128 );
+        TEST_ASSERT( mm[ i ] + 128 <= (pl_t)plbm.node + 512 );
+    }
+    plbm_del( &plbm );
+    plam_del( &plam );
+
+    plbm_new( &plbm2, 4096, 1024 );
+    plbm_into_plbm_aligned( &plbm, &plbm2, 64, 256 );
+    mm[ 0 ] = plbm_get( &plbm );
+    TEST_ASSERT_EQUAL( 0, (pl_size_t)mm[ 0 ] % 256 );
+    plbm_del( &plbm );
+    plbm_del( &plbm2 );
+
+    plbm_new_aligned( &plbm, 64, 40, 64 );
+    TEST_ASSERT( plbm.node == NULL );
+    TEST_ASSERT_EQUAL( 0, plbm.imax );
+
+    /* Nodes without zeroing. */
+    plbm_empty( &plbm, 256, 16 );
+    plbm_set_zeroing( &plbm, pl_false );
+    TEST_ASSERT_EQUAL( PL_MF_NOZERO, plbm.flags );
+    for ( int i = 0; i < 24; i++ ) {
+        mm[ i ] = plbm_get( &plbm );
+        memset( mm[ i ], 0xff, 16 );
+    }
+    plbm_set_zeroing( &plbm, pl_true );
+    TEST_ASSERT_EQUAL( 0, plbm.flags );
+    plbm_del( &plbm );
+}
+
+
+void test_plbb( void )
+{
+    plbb_s    plbb;
+    pl_u8_t*  m[ 8 ];
+    pl_u8_t*  first;
+    pl_u8_t*  block;
+    pl_size_t count;
+
+    plbb_new( &plbb, 4000, 1 );
+    TEST_ASSERT_EQUAL( 4096, plbb.nsize );
+    TEST_ASSERT_EQUAL( 1, plbb_block_size( &plbb ) );
+    count = plbb_node_capacity( &plbb );
+    TEST_ASSERT_EQUAL( 3608, count );
+    TEST_ASSERT( sizeof( pl_node_s ) + plbb.wcount * 8 + count <= 4096 );
+
+    /* Address order. */
+    for ( int i = 0; i < 8; i++ ) {
+        m[ i ] = plbb_get( &plbb );
+    }
+    TEST_ASSERT_EQUAL( 0, (pl_size_t)plbb.node % 4096 );
+    for ( int i = 1; i < 8; i++ ) {
+        TEST_ASSERT( m[ i ] == m[ i - 1 ] + 1 );
+    }
+    first = m[ 0 ];
+    plbb_put( &plbb, m[ 5 ] );
+    plbb_put( &plbb, m[ 2 ] );
+    TEST_ASSERT( plbb_get( &plbb ) == m[ 2 ] );
+    TEST_ASSERT( plbb_get( &plbb ) == m[ 5 ] );
+    TEST_ASSERT( plbb_get( &plbb ) == m[ 7 ] + 1 );
+
+    /* Full Node, and a new one. */
+    for ( pl_size_t i = 9; i < count; i++ ) {
+        block = plbb_get( &plbb );
+        TEST_ASSERT( block == first + i );
+        *block = 0xff;
+    }
+    TEST_ASSERT_EQUAL( count, plbb.node->used );
+    block = plbb_get( &plbb );
+    TEST_ASSERT( plbb.node->prev == (pl_node_t)( first - sizeof( pl_node_s ) - plbb.wcount * 8 ) );
+    TEST_ASSERT( block == plbb.node->data + plbb.wcount * 8 );
+
+    /* Free Block in old Node is used, when current becomes full. */
+    plbb_put( &plbb, first + 100 );
+    for ( pl_size_t i = 1; i < count; i++ ) {
+        plbb_get( &plbb );
+    }
+    TEST_ASSERT( plbb_get( &plbb ) == first + 100 );
+
+    /* Node is released, when all its Blocks are put. */
+    TEST_ASSERT( plbb.node->next != NULL );
+    block = plbb.node->next->data + plbb.wcount * 8;
+    for ( pl_size_t i = 0; i < count; i++ ) {
+        plbb_put( &plbb, block + i );
+    }
+    TEST_ASSERT( plbb.node->prev == NULL && plbb.node->next == NULL );
+    TEST_ASSERT_EQUAL( count, plbb.node->used );
+
+    plbb_clear( &plbb );
+    TEST_ASSERT_EQUAL( 0, plbb.node->used );
+    TEST_ASSERT( plbb_get( &plbb ) == plbb.node->data + plbb.wcount * 8 );
+    plbb_del( &plbb );
+
+    /* Odd Block size, with partial last bitmap word. */
+    plbb_new( &plbb, 256, 3 );
+    count = plbb_node_capacity( &plbb );
+    TEST_ASSERT_EQUAL( 69, count );
+    for ( pl_size_t i = 0; i < 2 * count; i++ ) {
+        block = plbb_get( &plbb );
+        TEST_ASSERT( block != NULL );
+        memset( block, 0xff, 3 );
+    }
+    TEST_ASSERT( plbb.node->prev != NULL );
+    plbb_del( &plbb );
+
+    plbb_new( &plbb, 4096, 0 );
+    TEST_ASSERT( plbb_get( &plbb ) == NULL );
+    plbb_del( &plbb );
+}
+
+
+void test_plbh( void )
+{
+    plbh_s    plbh;
+    pl_bh_t   h[ 40 ];
+    pl_u32_t* block;
+
+    plbh_new( &plbh, 15, 4 );
+    TEST_ASSERT_EQUAL( 4, plbh.shift );
+    TEST_ASSERT_EQUAL( 4, plbh_block_size( &plbh ) );
+    for ( pl_u32_t i = 0; i < 40; i++ ) {
+        h[ i ] = plbh_get( &plbh );
+        TEST_ASSERT_EQUAL( i + 1, h[ i ] );
+        block = plbh_ref( &plbh, h[ i ] );
+        *block = i;
+    }
+    TEST_ASSERT_EQUAL( 3, plcm_used_for_type( &plbh.table, pl_node_t ) );
+    TEST_ASSERT( plbh_ref( &plbh, h[ 1 ] ) == plbh_ref( &plbh, h[ 0 ] ) + 4 );
+    for ( pl_u32_t i = 0; i < 40; i++ ) {
+        TEST_ASSERT_EQUAL( i, *(pl_u32_t*)plbh_ref( &plbh, h[ i ] ) );
+    }
+
+    plbh_put( &plbh, h[ 20 ] );
+    plbh_put( &plbh, h[ 3 ] );
+    TEST_ASSERT_EQUAL( h[ 3 ], plbh_get( &plbh ) );
+    TEST_ASSERT_EQUAL( h[ 20 ], plbh_get( &plbh ) );
+    TEST_ASSERT_EQUAL( 41, plbh_get( &plbh ) );
+
+    /* Nodes are reused after clear. */
+    plbh_clear( &plbh );
+    TEST_ASSERT_EQUAL( 1, plbh_get( &plbh ) );
+    TEST_ASSERT( plbh_ref( &plbh, 1 ) == plbh_ref( &plbh, h[ 0 ] ) );
+    TEST_ASSERT_EQUAL( 3, plcm_used_for_type( &plbh.table, pl_node_t ) );
+    plbh_del( &plbh );
+
+    plbh_new( &plbh, 16, 2 );
+    TEST_ASSERT_EQUAL( 0, plbh_get( &plbh ) );
+    plbh_del( &plbh );
+}
+
+
+#define PLBS_THREADS 8
+#define PLBS_ROUNDS 20000
+#define PLBS_HOLD 8
+
+pl_struct( plbs_job )
+{
+    plbs_t    plbs;
+    pl_size_t id;
+    pl_size_t fail;
+};
+
+static pl_t plbs_worker( pl_t arg )
+{
+    plbs_job_t job;
+    pl_size_t* block[ PLBS_HOLD ];
+    pl_size_t  stamp;
+
+    job = arg;
+    for ( pl_size_t i = 0; i < PLBS_ROUNDS; i++ ) {
+        stamp = ( job->id << 32 ) | i;
+        for ( pl_size_t j = 0; j < PLBS_HOLD; j++ ) {
+            block[ j ] = plbs_get( job->plbs );
+            if ( block[ j ] == NULL ) {
+                job->fail++;
+                return NULL;
+            }
+            /* First element is the link of a free Block. */
+            block[ j ][ 1 ] = stamp;
+            block[ j ][ 2 ] = j;
+        }
+        for ( pl_size_t j = 0; j < PLBS_HOLD; j++ ) {
+            if ( block[ j ][ 1 ] != stamp || block[ j ][ 2 ] != j ) {
+                job->fail++;
+            }
+            plbs_put( job->plbs, block[ j ] );
+        }
+    }
+    return NULL;
+}
+
+
+void test_plbs( void )
+{
+    plbs_s     plbs;
+    pthread_t  thread[ PLBS_THREADS ];
+    plbs_job_s job[ PLBS_THREADS ];
+    pl_t       m1;
+    pl_t       m2;
+    pl_size_t  count;
+    pl_node_t  node;
+
+    plbs_new( &plbs, sizeof( pl_node_s ) + 4 * 32, 32 );
+    TEST_ASSERT_EQUAL( 32, plbs_block_size( &plbs ) );
+    m1 = plbs_get( &plbs );
+    m2 = plbs_get( &plbs );
+    TEST_ASSERT( m1 != NULL && m2 != NULL && m1 != m2 );
+    plbs_put( &plbs, m1 );
+    TEST_ASSERT( plbs_get( &plbs ) == m1 );
+    plbs_put( &plbs, m2 );
+    plbs_put( &plbs, m1 );
+    plbs_del( &plbs );
+
+    plbs_new( &plbs, 8, 32 );
+    TEST_ASSERT( plbs_get( &plbs ) == NULL );
+    plbs_del( &plbs );
+
+    /* Concurrent gets and puts must not share Blocks. */
+    plbs_new( &plbs, sizeof( pl_node_s ) + 16 * 32, 32 );
+    for ( pl_size_t i = 0; i < PLBS_THREADS; i++ ) {
+        job[ i ].plbs = &plbs;
+        job[ i ].id = i;
+        job[ i ].fail = 0;
+        pthread_create( &thread[ i ], NULL, plbs_worker, &job[ i ] );
+    }
+    for ( pl_size_t i = 0; i < PLBS_THREADS; i++ ) {
+        pthread_join( thread[ i ], NULL );
+    }
+    for ( pl_size_t i = 0; i < PLBS_THREADS; i++ ) {
+        TEST_ASSERT_EQUAL( 0, job[ i ].fail );
+    }
+
+    /* Nodes are allocated only when all Blocks are in use. */
+    count = 1;
+    for ( node = plbs.plbm.node; node->prev; node = node->prev ) {
+        count++;
+    }
+    TEST_ASSERT( count <= PLBS_THREADS * PLBS_HOLD / 16 + PLBS_THREADS );
+    plbs_del( &plbs );
+}
+
+
+pl_struct( plmg_job )
+{
+    plmd_t    plmd;
+    pl_size_t id;
+    pl_size_t fail;
+};
+
+static pl_t plmg_worker( pl_t arg )
+{
+    plmg_job_t job;
+    plmg_s     plmg;
+    pl_size_t* block[ PLBS_HOLD ];
+    pl_size_t  stamp;
+
+    job = arg;
+    plmg_new( &plmg, job->plmd );
+    for ( pl_size_t i = 0; i < PLBS_ROUNDS; i++ ) {
+        stamp = ( job->id << 32 ) | i;
+        for ( pl_size_t j = 0; j < PLBS_HOLD; j++ ) {
+            block[ j ] = plmg_get( &plmg );
+            if ( block[ j ] == NULL ) {
+                job->fail++;
+                plmg_del( &plmg );
+                return NULL;
+            }
+            block[ j ][ 1 ] = stamp;
+            block[ j ][ 2 ] = j;
+        }
+        for ( pl_size_t j = 0; j < PLBS_HOLD; j++ ) {
+            if ( block[ j ][ 1 ] != stamp || block[ j ][ 2 ] != j ) {
+                job->fail++;
+            }
+            plmg_put( &plmg, block[ j ] );
+        }
+    }
+    plmg_del( &plmg );
+    return NULL;
+}
+
+
+void test_plmg( void )
+{
+    plmd_s     plmd;
+    plmg_s     plmg;
+    pthread_t  thread[ PLBS_THREADS ];
+    plmg_job_s job[ PLBS_THREADS ];
+    pl_t       m[ 9 ];
+    pl_size_t  count;
+    pl_node_t  node;
+    pl_t       block;
+
+    plmd_new( &plmd, sizeof( pl_node_s ) + 16 * 32, 32, 4 );
+    TEST_ASSERT_EQUAL( 32, plmd_block_size( &plmd ) );
+    TEST_ASSERT_TRUE( plmg_new( &plmg, &plmd ) );
+
+    /* First get refills a full Magazine from depot. */
+    m[ 0 ] = plmg_get( &plmg );
+    TEST_ASSERT( m[ 0 ] != NULL );
+    TEST_ASSERT_EQUAL( 3, plmg.lcnt );
+    TEST_ASSERT_EQUAL( 12, plmd.plbm.itail );
+    plmg_put( &plmg, m[ 0 ] );
+    TEST_ASSERT( plmg_get( &plmg ) == m[ 0 ] );
+
+    /* Two refills, and no depot traffic on puts. */
+    for ( pl_size_t i = 1; i < 8; i++ ) {
+        m[ i ] = plmg_get( &plmg );
+        TEST_ASSERT( m[ i ] != NULL && m[ i ] != m[ i - 1 ] );
+    }
+    TEST_ASSERT_EQUAL( 8, plmd.plbm.itail );
+    for ( pl_size_t i = 0; i < 8; i++ ) {
+        plmg_put( &plmg, m[ i ] );
+    }
+    TEST_ASSERT_EQUAL( 4, plmg.lcnt );
+    TEST_ASSERT_EQUAL( 4, plmg.pcnt );
+    TEST_ASSERT( plmd.plbm.head == NULL );
+
+    /* Both arrays full, previous is flushed to depot. */
+    m[ 8 ] = plbm_get( &plmd.plbm );
+    plmg_put( &plmg, m[ 8 ] );
+    TEST_ASSERT_EQUAL( 1, plmg.lcnt );
+    TEST_ASSERT_EQUAL( 4, plmg.pcnt );
+    count = 0;
+    for ( block = plmd.plbm.head; block; block = *(pl_t*)block ) {
+        count++;
+    }
+    TEST_ASSERT_EQUAL( 4, count );
+
+    /* Flush returns everything. */
+    plmg_flush( &plmg );
+    TEST_ASSERT_EQUAL( 0, plmg.lcnt );
+    TEST_ASSERT_EQUAL( 0, plmg.pcnt );
+    count = 0;
+    for ( block = plmd.plbm.head; block; block = *(pl_t*)block ) {
+        count++;
+    }
+    TEST_ASSERT_EQUAL( 9, count );
+    plmg_del( &plmg );
+    plmd_del( &plmd );
+
+    /* Invalid Magazine size. */
+    plmd_new( &plmd, sizeof( pl_node_s ) + 16 * 32, 32, 0 );
+    TEST_ASSERT_FALSE( plmg_new( &plmg, &plmd ) );
+    TEST_ASSERT( plmg_get( &plmg ) == NULL );
+    plmg_del( &plmg );
+    plmd_del( &plmd );
+
+    /* Concurrent Magazines over one depot. */
+    plmd_new( &plmd, sizeof( pl_node_s ) + 16 * 32, 32, 16 );
+    for ( pl_size_t i = 0; i < PLBS_THREADS; i++ ) {
+        job[ i ].plmd = &plmd;
+        job[ i ].id = i;
+        job[ i ].fail = 0;
+        pthread_create( &thread[ i ], NULL, plmg_worker, &job[ i ] );
+    }
+    for ( pl_size_t i = 0; i < PLBS_THREADS; i++ ) {
+        pthread_join( thread[ i ], NULL );
+    }
+    for ( pl_size_t i = 0; i < PLBS_THREADS; i++ ) {
+        TEST_ASSERT_EQUAL( 0, job[ i ].fail );
+    }
+
+    /* All Blocks are back in depot after thread exit. */
+    count = 0;
+    for ( node = plmd.plbm.node; node; node = node->prev ) {
+        count += 16;
+    }
+    count -= plmd.plbm.itail;
+    for ( block = plmd.plbm.head; block; block = *(pl_t*)block ) {
+        count--;
+    }
+    TEST_ASSERT_EQUAL( 0, count );
+    plmd_del( &plmd );
+}
+
+
+void test_plsl( void )
+{
+    plsl_s    plsl;
+    pl_t      m[ 32 ];
+    pl_t      large;
+    pl_size_t count;
+
+    TEST_ASSERT_TRUE( plsl_new( &plsl, 64 * 1024 ) );
+
+    /* Size classes. */
+    m[ 0 ] = plsl_get( &plsl, 1 );
+    m[ 1 ] = plsl_get( &plsl, 16 );
+    m[ 2 ] = plsl_get( &plsl, 17 );
+    m[ 3 ] = plsl_get( &plsl, 100 );
+    m[ 4 ] = plsl_get( &plsl, 4096 );
+    m[ 5 ] = plsl_get( &plsl, 0 );
+    TEST_ASSERT_EQUAL( 16, plsl_size( &plsl, m[ 0 ] ) );
+    TEST_ASSERT_EQUAL( 16, plsl_size( &plsl, m[ 1 ] ) );
+    TEST_ASSERT_EQUAL( 32, plsl_size( &plsl, m[ 2 ] ) );
+    TEST_ASSERT_EQUAL( 128, plsl_size( &plsl, m[ 3 ] ) );
+    TEST_ASSERT_EQUAL( 4096, plsl_size( &plsl, m[ 4 ] ) );
+    TEST_ASSERT_EQUAL( 16, plsl_size( &plsl, m[ 5 ] ) );
+    TEST_ASSERT( m[ 1 ] == m[ 0 ] + 16 );
+    for ( pl_size_t i = 0; i < 6; i++ ) {
+        TEST_ASSERT_EQUAL( 0, (pl_size_t)m[ i ] % PLSL_CLASS_MIN );
+        memset( m[ i ], 0xff, plsl_size( &plsl, m[ i ] ) );
+    }
+    TEST_ASSERT( plsl.large == NULL );
+
+    /* Put without size, and reuse from the same class. */
+    plsl_put( &plsl, m[ 3 ] );
+    TEST_ASSERT( plsl_get( &plsl, 65 ) == m[ 3 ] );
+    plsl_put( &plsl, m[ 2 ] );
+    TEST_ASSERT( plsl_get( &plsl, 100 ) != m[ 2 ] );
+    TEST_ASSERT( plsl_get( &plsl, 20 ) == m[ 2 ] );
+    plsl_put( &plsl, NULL );
+
+    /* Large allocations. */
+    large = plsl_get( &plsl, 5000 );
+    TEST_ASSERT( large != NULL );
+    TEST_ASSERT_EQUAL( 5000, plsl_size( &plsl, large ) );
+    memset( large, 0xff, 5000 );
+    m[ 6 ] = plsl_get( &plsl, 10000 );
+    TEST_ASSERT( plsl.large != NULL );
+    plsl_put( &plsl, large );
+    plsl_put( &plsl, m[ 6 ] );
+    TEST_ASSERT( plsl.large == NULL );
+
+    /* Full pool falls back to large allocations. */
+    count = 0;
+    for ( pl_size_t i = 0; i < 32; i++ ) {
+        m[ i ] = plsl_get( &plsl, 4000 );
+        TEST_ASSERT( m[ i ] != NULL );
+        if ( plsl_size( &plsl, m[ i ] ) == 4000 ) {
+            count++;
+        }
+    }
+    /* One 4096 Block is in use already. */
+    TEST_ASSERT_EQUAL( 32 - ( 64 * 1024 - sizeof( pl_node_s ) ) / 4096 + 1, count );
+    for ( pl_size_t i = 0; i < 32; i++ ) {
+        plsl_put( &plsl, m[ i ] );
+    }
+    TEST_ASSERT( plsl.large == NULL );
+
+    /* Delete releases also the unreturned large allocations. */
+    plsl_get( &plsl, 8000 );
+    plsl_del( &plsl );
+    TEST_ASSERT( plsl.large == NULL );
 }
 
 
@@ -801,6 +1859,260 @@ void test_plcm( void )
     plcm_consume( &plcm, strlen( s1 ) );
     TEST_ASSERT_TRUE( !strcmp( s1, plss_string( &plcm ) ) );
     plcm_del( &plcm );
+
+
+    /* Test reserved plcm. */
+    TEST_ASSERT( plcm_new_reserve( &plcm, 100, 1 << 30 ) != NULL );
+    TEST_ASSERT_EQUAL( 0, plcm_size( &plcm ) % 4096 );
+    TEST_ASSERT_EQUAL( pl_true, plcm_debt( &plcm ) );
+    s2 = plcm_data( &plcm );
+    s3 = plcm_get_ref( &plcm, 8 );
+    memcpy( s3, "abcdefg", 8 );
+    for ( int i = 0; i < 100000; i++ ) {
+        plcm_store_ptr( &plcm, s1 );
+    }
+    TEST_ASSERT( plcm_data( &plcm ) == s2 );
+    TEST_ASSERT_TRUE( !strcmp( "abcdefg", s3 ) );
+    TEST_ASSERT( *(char**)plcm_ref( &plcm, plcm_used( &plcm ) - sizeof( pl_t ) ) == s1 );
+    plcm_reset( &plcm );
+    plcm_get_ref( &plcm, 5000 );
+    plcm_compact( &plcm );
+    TEST_ASSERT_EQUAL( PLINTH_ALIGN_TO( 5000, 4096 ), plcm_size( &plcm ) );
+    s3 = plcm_get_ref( &plcm, 100000 );
+    memset( s3, 1, 100000 );
+    TEST_ASSERT( plcm_data( &plcm ) == s2 );
+    plcm_del( &plcm );
+
+    TEST_ASSERT( plcm_new_reserve( &plcm, 8192, 4096 ) == NULL );
+    TEST_ASSERT( plcm_new_reserve( &plcm, 0, 0 ) == NULL );
+    plcm_new_reserve( &plcm, 0, 8192 );
+    TEST_ASSERT_EQUAL( 0, plcm_size( &plcm ) );
+    s3 = plcm_get_ref( &plcm, 8192 );
+    TEST_ASSERT_EQUAL( 8192, plcm_size( &plcm ) );
+    memset( s3, 'x', 8192 );
+    TEST_ASSERT( plcm_get_ref( &plcm, 1 ) == NULL );
+    TEST_ASSERT_EQUAL( pl_false, plcm_is_empty( &plcm ) );
+    TEST_ASSERT_EQUAL( 8192, plcm_used( &plcm ) );
+    TEST_ASSERT( plcm_data( &plcm ) == s3 );
+    plcm_del( &plcm );
+
+    /* Data survives overrun of reservation. */
+    plcm_new_reserve( &plcm, 0, 8192 );
+    s2 = plcm_data( &plcm );
+    for ( int i = 0; i < 1250; i++ ) {
+        TEST_ASSERT( plcm_store( &plcm, &i, sizeof( int ) ) >= 0 );
+    }
+    TEST_ASSERT_EQUAL( 5000, plcm_used( &plcm ) );
+    TEST_ASSERT_EQUAL( -1, plcm_store( &plcm, mem, 4000 ) );
+    TEST_ASSERT( plcm_get_ref( &plcm, 4000 ) == NULL );
+    TEST_ASSERT( plcm_ensure( &plcm, 4000 ) == NULL );
+    TEST_ASSERT_FALSE( plcm_resize( &plcm, 8193 ) );
+    TEST_ASSERT_EQUAL( 5000, plcm_used( &plcm ) );
+    TEST_ASSERT( plcm_data( &plcm ) == s2 );
+    for ( int i = 0; i < 1250; i++ ) {
+        TEST_ASSERT_EQUAL( i, *(int*)plcm_ref( &plcm, i * sizeof( int ) ) );
+    }
+    TEST_ASSERT( plcm_get_pos( &plcm, 3192 ) == 5000 );
+    TEST_ASSERT_TRUE( plcm_resize( &plcm, 8192 ) );
+    plcm_del( &plcm );
+
+    /* String append stops at the end of reservation. */
+    plcm_new_reserve( &plcm, 0, 4096 );
+    for ( int i = 0; i < 600; i++ ) {
+        if ( plss_append_string( &plcm, "abcdefgh" ) == NULL ) {
+            TEST_ASSERT_EQUAL( 511, i );
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL( 4088, plcm_used( &plcm ) );
+    TEST_ASSERT_EQUAL( 4096, plcm_size( &plcm ) );
+    TEST_ASSERT_EQUAL( 4088, strlen( plss_string( &plcm ) ) );
+    sr = plsr_from_string_and_length( plcm_data( &plcm ), 4096 );
+    TEST_ASSERT( plss_set( &plcm, sr ) == NULL );
+    plss_insert( &plcm, 0, "abcdefgh", 8 );
+    plss_format_string( &plcm, "%s", "abcdefgh" );
+    plcm_store_null( &plcm );
+    TEST_ASSERT_EQUAL( 4088, plcm_used( &plcm ) );
+    TEST_ASSERT_EQUAL( 4088, strlen( plss_string( &plcm ) ) );
+    plcm_del( &plcm );
+
+    /* Aligned data is kept aligned in growth and compaction. */
+    plcm_new_aligned( &plcm, 100, 64 );
+    TEST_ASSERT_EQUAL( 128, plcm_size( &plcm ) );
+    TEST_ASSERT_EQUAL( 0, (pl_size_t)plcm_data( &plcm ) % 64 );
+    for ( int i = 0; i < 1000; i++ ) {
+        plcm_store( &plcm, &i, sizeof( int ) );
+        TEST_ASSERT_EQUAL( 0, (pl_size_t)plcm_data( &plcm ) % 64 );
+    }
+    for ( int i = 0; i < 1000; i++ ) {
+        TEST_ASSERT_EQUAL( i, *(int*)plcm_ref( &plcm, i * sizeof( int ) ) );
+    }
+    plcm_compact( &plcm );
+    TEST_ASSERT_EQUAL( 4032, plcm_size( &plcm ) );
+    TEST_ASSERT_EQUAL( 0, (pl_size_t)plcm_data( &plcm ) % 64 );
+    TEST_ASSERT_EQUAL( 999, *(int*)plcm_ref( &plcm, 999 * sizeof( int ) ) );
+    plcm_del( &plcm );
+
+    /* Growth without zeroing. */
+    plcm_empty( &plcm, 64 );
+    plcm_set_zeroing( &plcm, pl_false );
+    TEST_ASSERT_EQUAL( PL_MF_NOZERO, plcm.flags );
+    for ( int i = 0; i < 1000; i++ ) {
+        plcm_store( &plcm, &i, sizeof( int ) );
+    }
+    TEST_ASSERT_EQUAL( 4096, plcm_size( &plcm ) );
+    for ( int i = 0; i < 1000; i++ ) {
+        TEST_ASSERT_EQUAL( i, *(int*)plcm_ref( &plcm, i * sizeof( int ) ) );
+    }
+    plcm_set_zeroing( &plcm, pl_true );
+    TEST_ASSERT_EQUAL( 0, plcm.flags );
+    plcm_del( &plcm );
+
+    plcm_new_aligned( &plcm, 64, 64 );
+    plcm_set_zeroing( &plcm, pl_false );
+    for ( int i = 0; i < 100; i++ ) {
+        plcm_store( &plcm, &i, sizeof( int ) );
+    }
+    TEST_ASSERT_EQUAL( 0, (pl_size_t)plcm_data( &plcm ) % 64 );
+    TEST_ASSERT_EQUAL( 99, *(int*)plcm_ref( &plcm, 99 * sizeof( int ) ) );
+    plcm_del( &plcm );
+
+    /* Growth policies. */
+    plcm_new( &plcm, 1024 );
+    plcm_set_growth( &plcm, PL_GP_HALF, 0 );
+    plcm_get_pos( &plcm, 1025 );
+    TEST_ASSERT_EQUAL( 1536, plcm_size( &plcm ) );
+    plcm_get_pos( &plcm, 2000 );
+    TEST_ASSERT_EQUAL( 3072, plcm_size( &plcm ) );
+    plcm_set_growth( &plcm, PL_GP_PAGE, 0 );
+    plcm_get_pos( &plcm, 1000 );
+    TEST_ASSERT_EQUAL( 4096, plcm_size( &plcm ) );
+    plcm_set_growth( &plcm, PL_GP_CAPPED, 1000 );
+    plcm_get_pos( &plcm, 100 );
+    TEST_ASSERT_EQUAL( 5120, plcm_size( &plcm ) );
+    plcm_set_growth( &plcm, PL_GP_CAPPED, 1 << 20 );
+    plcm_get_pos( &plcm, 2000 );
+    TEST_ASSERT_EQUAL( 10240, plcm_size( &plcm ) );
+    plcm_del( &plcm );
+
+    /* Cap of 0 is no cap. */
+    plcm_new( &plcm, 4096 );
+    plcm_set_growth( &plcm, PL_GP_CAPPED, 0 );
+    plcm_get_pos( &plcm, 4097 );
+    TEST_ASSERT_EQUAL( 8192, plcm_size( &plcm ) );
+    plcm_del( &plcm );
+
+    plcm_use( &plcm, mem, 128 );
+    plcm_set_growth( &plcm, PL_GP_HALF, 0 );
+    plcm_get_pos( &plcm, 129 );
+    TEST_ASSERT_EQUAL( 192, plcm_size( &plcm ) );
+    TEST_ASSERT_EQUAL( PL_AA_HEAP, plcm.type );
+    plcm_del( &plcm );
+
+    /* Mapped plcm, grown with remap. */
+    plcm_new_mmap( &plcm, 0 );
+    TEST_ASSERT_EQUAL( 4096, plcm_size( &plcm ) );
+    TEST_ASSERT_EQUAL( pl_true, plcm_debt( &plcm ) );
+    for ( int i = 0; i < 10000; i++ ) {
+        plcm_store( &plcm, &i, sizeof( int ) );
+    }
+    TEST_ASSERT_EQUAL( 65536, plcm_size( &plcm ) );
+    for ( int i = 0; i < 10000; i++ ) {
+        TEST_ASSERT_EQUAL( i, *(int*)plcm_ref( &plcm, i * sizeof( int ) ) );
+    }
+    plcm_set_growth( &plcm, PL_GP_PAGE, 0 );
+    plcm_get_pos( &plcm, 30000 );
+    TEST_ASSERT_EQUAL( 73728, plcm_size( &plcm ) );
+    plcm_put( &plcm, 30000 );
+    plcm_compact( &plcm );
+    TEST_ASSERT_EQUAL( 40960, plcm_size( &plcm ) );
+    TEST_ASSERT_EQUAL( 9999, *(int*)plcm_ref( &plcm, 9999 * sizeof( int ) ) );
+    plcm_reset( &plcm );
+    plcm_compact( &plcm );
+    TEST_ASSERT_EQUAL( 4096, plcm_size( &plcm ) );
+    plcm_del( &plcm );
+
+    /* Plam hosted plcm, grown at the tip of host. */
+    plam_new( &plam, 16384 );
+    plam_get( &plam, 64 );
+    plcm_into_plam( &plcm, &plam, 64 );
+    TEST_ASSERT_EQUAL( pl_false, plcm_debt( &plcm ) );
+    TEST_ASSERT( plcm_data( &plcm ) == plam.node->data + 64 );
+    for ( int i = 0; i < 200; i++ ) {
+        plcm_store( &plcm, &i, sizeof( int ) );
+    }
+    TEST_ASSERT_EQUAL( 1024, plcm_size( &plcm ) );
+    TEST_ASSERT( plcm_data( &plcm ) == plam.node->data + 64 );
+    TEST_ASSERT_EQUAL( 64 + 1024, plam.node->used );
+    plcm_compact( &plcm );
+    TEST_ASSERT_EQUAL( 800, plcm_size( &plcm ) );
+    TEST_ASSERT_EQUAL( 64 + 800, plam.node->used );
+
+    /* Relocation within host, when not at the tip. */
+    plam_get( &plam, 16 );
+    plcm_get_pos( &plcm, 100 );
+    TEST_ASSERT_EQUAL( 1600, plcm_size( &plcm ) );
+    TEST_ASSERT( plcm_data( &plcm ) == plam.node->data + 880 );
+    TEST_ASSERT_EQUAL( 880 + 1600, plam.node->used );
+    for ( int i = 0; i < 200; i++ ) {
+        TEST_ASSERT_EQUAL( i, *(int*)plcm_ref( &plcm, i * sizeof( int ) ) );
+    }
+
+    /* Only the required size is taken, when growth does not fit. */
+    plcm_get_pos( &plcm, 13600 );
+    TEST_ASSERT_EQUAL( 14500, plcm_size( &plcm ) );
+    TEST_ASSERT_EQUAL( 880 + 14500, plam.node->used );
+    TEST_ASSERT_EQUAL( 199, *(int*)plcm_ref( &plcm, 199 * sizeof( int ) ) );
+    plcm_del( &plcm );
+    TEST_ASSERT_EQUAL( 880, plam.node->used );
+    plam_del( &plam );
+}
+
+
+void test_plci( void )
+{
+    plci_s plci;
+    plci_s copy;
+    plcm_t plcm;
+
+    plcm = plci_new( &plci );
+    TEST_ASSERT_EQUAL( pl_true, plci_is_inline( &plci ) );
+    TEST_ASSERT_EQUAL( PLCI_SIZE, plcm_size( plcm ) );
+    TEST_ASSERT_EQUAL( pl_false, plcm_debt( plcm ) );
+
+    plss_set( plcm, plsr_from_string( "short" ) );
+    plss_append_string( plcm, " string" );
+    TEST_ASSERT( strcmp( "short string", plss_string( plcm ) ) == 0 );
+    TEST_ASSERT_EQUAL( pl_true, plci_is_inline( &plci ) );
+    TEST_ASSERT( plcm_data( plcm ) == plci.local );
+
+    /* Copy refers to its own inline storage. */
+    copy = plci;
+    plcm = plci_plcm( &copy );
+    TEST_ASSERT( plcm_data( plcm ) == copy.local );
+    plss_append_char( plcm, '!' );
+    TEST_ASSERT( strcmp( "short string!", plss_string( plcm ) ) == 0 );
+    TEST_ASSERT( strcmp( "short string", plss_string( plci_plcm( &plci ) ) ) == 0 );
+
+    /* Spill to heap. */
+    plcm = plci_plcm( &plci );
+    plss_append_string( plcm, " that does not fit inline" );
+    TEST_ASSERT( strcmp( "short string that does not fit inline", plss_string( plcm ) ) == 0 );
+    TEST_ASSERT_EQUAL( pl_false, plci_is_inline( &plci ) );
+    TEST_ASSERT_EQUAL( pl_true, plcm_debt( plcm ) );
+    TEST_ASSERT( plci_plcm( &plci ) == plcm );
+    TEST_ASSERT( plcm_data( plcm ) != plci.local );
+
+    plci_del( &plci );
+    TEST_ASSERT_EQUAL( pl_true, plci_is_inline( &plci ) );
+    TEST_ASSERT_EQUAL( 0, plcm_used( plci_plcm( &plci ) ) );
+
+    plcm = plci_plcm( &plci );
+    for ( int i = 0; i < 100; i++ ) {
+        plcm_store( plcm, &i, sizeof( int ) );
+    }
+    TEST_ASSERT_EQUAL( 99, *(int*)plcm_ref( plcm, 99 * sizeof( int ) ) );
+    plci_del( &plci );
 }
 
 
@@ -1140,8 +2452,8 @@ void test_plls( void )
     plbm_s      plbm;
     plls_s      plls;
     plls_node_p node;
-    //     plls_node_t item;
-    pl_size_t node_size;
+    plls_node_t item;
+    pl_size_t   node_size;
     int       i;
 
     node_size = sizeof( pl_t ) + plls_node_overhead();
@@ -1262,6 +2574,16 @@ void test_plls( void )
     node = plls_head( &plls );
     TEST_ASSERT( strcmp( ss[ 1 ], plls_node_data( *node ) ) == 0 );
 
+    for ( i = 0; i < 4; i++ ) {
+        plls_store( &plls, ss[ i ] );
+    }
+    node = plls_head( &plls );
+    item = *node;
+    plls_clear( &plls );
+    TEST_ASSERT_EQUAL( 0, plls_size( &plls ) );
+    TEST_ASSERT( *plls_head( &plls ) == NULL );
+    TEST_ASSERT( plbm_get( &plbm ) == (pl_t)item );
+
     plbm_del( &plbm );
 }
 
@@ -1372,10 +2694,97 @@ void test_plld( void )
     TEST_ASSERT( plld_node_at_start( node ) );
     TEST_ASSERT( strcmp( ss[ 0 ], plld_node_data( node ) ) == 0 );
 
+    plld_clear( &plld );
+    TEST_ASSERT_EQUAL( 0, plld_size( &plld ) );
+    TEST_ASSERT( plld_head( &plld ) == NULL );
+    TEST_ASSERT( plbm_get( &plbm ) == (pl_t)node );
+    plld_clear( &plld );
+
     plbm_del( &plbm );
 }
 
 
+void test_pllh( void )
+{
+    char*     ss[ 5 ];
+    plbh_s    plbh;
+    pllh_s    pllh;
+    pl_bh_t   node;
+    pl_size_t node_size;
+    int       i;
+
+    node_size = sizeof( pl_t ) + pllh_node_overhead();
+    TEST_ASSERT_EQUAL( plld_node_overhead() / 2, pllh_node_overhead() );
+    ss[ 0 ] = "text0";
+    ss[ 1 ] = "text1";
+    ss[ 2 ] = "text2";
+    ss[ 3 ] = "text3";
+    ss[ 4 ] = "text4";
+
+    plbh_new( &plbh, 4, node_size );
+    pllh = pllh_init( &plbh );
+    pllh_store( &pllh, ss[ 2 ] );
+    pllh_store( &pllh, ss[ 4 ] );
+    node = pllh_node_prev( &pllh, pllh_tail( &pllh ) );
+    pllh_append( &pllh, node, ss[ 3 ] );
+    node = pllh_head( &pllh );
+    pllh_insert( &pllh, node, ss[ 0 ] );
+    pllh_insert( &pllh, node, ss[ 1 ] );
+    TEST_ASSERT_EQUAL( 5, pllh_size( &pllh ) );
+
+    node = pllh_head( &pllh );
+    for ( i = 0; i < 5; i++ ) {
+        TEST_ASSERT( strcmp( ss[ i ], pllh_node_data( &pllh, node ) ) == 0 );
+        node = pllh_node_next( &pllh, node );
+    }
+    TEST_ASSERT_EQUAL( 0, node );
+    TEST_ASSERT( pllh_node_data( &pllh, node ) == NULL );
+
+    node = pllh_tail( &pllh );
+    for ( i = 4; i >= 0; i-- ) {
+        TEST_ASSERT( strcmp( ss[ i ], pllh_node_data( &pllh, node ) ) == 0 );
+        node = pllh_node_prev( &pllh, node );
+    }
+    TEST_ASSERT_EQUAL( 0, node );
+    TEST_ASSERT_EQUAL( 0, pllh_node_next( &pllh, 0 ) );
+    TEST_ASSERT_EQUAL( 0, pllh_node_prev( &pllh, 0 ) );
+
+    /* Remove middle, head, and tail. */
+    node = pllh_node_next( &pllh, pllh_head( &pllh ) );
+    node = pllh_remove( &pllh, node );
+    TEST_ASSERT( strcmp( ss[ 2 ], pllh_node_data( &pllh, node ) ) == 0 );
+    node = pllh_remove( &pllh, pllh_head( &pllh ) );
+    TEST_ASSERT( strcmp( ss[ 2 ], pllh_node_data( &pllh, node ) ) == 0 );
+    TEST_ASSERT_EQUAL( node, pllh_head( &pllh ) );
+    node = pllh_remove( &pllh, pllh_tail( &pllh ) );
+    TEST_ASSERT( strcmp( ss[ 3 ], pllh_node_data( &pllh, node ) ) == 0 );
+    TEST_ASSERT_EQUAL( node, pllh_tail( &pllh ) );
+    TEST_ASSERT_EQUAL( 2, pllh_size( &pllh ) );
+    TEST_ASSERT_EQUAL( 0, pllh_node_next( &pllh, pllh_tail( &pllh ) ) );
+
+    /* Removed nodes are reused. */
+    pllh_store( &pllh, ss[ 4 ] );
+    TEST_ASSERT( pllh_tail( &pllh ) <= 5 );
+    pllh_remove( &pllh, pllh_head( &pllh ) );
+    pllh_remove( &pllh, pllh_head( &pllh ) );
+    TEST_ASSERT_EQUAL( 0, pllh_remove( &pllh, pllh_head( &pllh ) ) );
+    TEST_ASSERT_EQUAL( 0, pllh_head( &pllh ) );
+    TEST_ASSERT_EQUAL( 0, pllh_tail( &pllh ) );
+    TEST_ASSERT_EQUAL( 0, pllh_remove( &pllh, 0 ) );
+
+    for ( i = 0; i < 5; i++ ) {
+        pllh_store( &pllh, ss[ i ] );
+    }
+    pllh_clear( &pllh );
+    TEST_ASSERT_EQUAL( 0, pllh_size( &pllh ) );
+    TEST_ASSERT_EQUAL( 0, pllh_head( &pllh ) );
+    TEST_ASSERT( plbh.head != 0 );
+    TEST_ASSERT_EQUAL( 5, plbh.count );
+
+    plbh_del( &plbh );
+}
+
+
 void test_pllu( void )
 {
     char*         ss[ 5 ];
@@ -1466,5 +2875,353 @@ void test_pllu( void )
     pllu_cursor_prev_item( &cursor, item );
     TEST_ASSERT( strcmp( ss[ 2 ], *(char**)pllu_cursor_item( &cursor ) ) == 0 );
 
+    cursor = pllu_cursor_init( &pllu );
+    pllu_clear( &pllu );
+    TEST_ASSERT_EQUAL( 0, pllu_size( &pllu ) );
+    TEST_ASSERT( pllu_head( &pllu ) == NULL );
+    TEST_ASSERT( plbm_get( &plbm ) == (pl_t)pllu_cursor_node( &cursor ) );
+
     plbm_del( &plbm );
 }
+
+
+void test_plsm( void )
+{
+    plsm_s    plsm;
+    pl_id_t   id[ 100 ];
+    pl_id_t   stale;
+    pl_size_t sum;
+    pl_size_t value;
+
+    plsm_new( &plsm, sizeof( pl_size_t ) );
+    TEST_ASSERT( plsm_ref( &plsm, 0 ) == NULL );
+
+    for ( pl_size_t i = 0; i < 100; i++ ) {
+        id[ i ] = plsm_insert( &plsm, &i );
+        TEST_ASSERT( id[ i ] != 0 );
+    }
+    TEST_ASSERT_EQUAL( 100, plsm_size( &plsm ) );
+    for ( pl_size_t i = 0; i < 100; i++ ) {
+        TEST_ASSERT_EQUAL( i, *(pl_size_t*)plsm_ref( &plsm, id[ i ] ) );
+        TEST_ASSERT_EQUAL( id[ i ], plsm_id( &plsm, i ) );
+    }
+
+    /* Remove moves the last item, and ids stay valid. */
+    TEST_ASSERT_TRUE( plsm_remove( &plsm, id[ 10 ] ) );
+    TEST_ASSERT_FALSE( plsm_remove( &plsm, id[ 10 ] ) );
+    TEST_ASSERT( plsm_ref( &plsm, id[ 10 ] ) == NULL );
+    TEST_ASSERT_EQUAL( 99, plsm_size( &plsm ) );
+    TEST_ASSERT_EQUAL( 99, ( (pl_size_t*)plsm_data( &plsm ) )[ 10 ] );
+    TEST_ASSERT_EQUAL( id[ 99 ], plsm_id( &plsm, 10 ) );
+    for ( pl_size_t i = 0; i < 100; i++ ) {
+        if ( i != 10 ) {
+            TEST_ASSERT_EQUAL( i, *(pl_size_t*)plsm_ref( &plsm, id[ i ] ) );
+        }
+    }
+    TEST_ASSERT_TRUE( plsm_remove( &plsm, id[ 99 ] ) );
+    TEST_ASSERT_EQUAL( 98, plsm_size( &plsm ) );
+
+    /* Slot is reused with new generation. */
+    stale = id[ 99 ];
+    value = 1000;
+    id[ 99 ] = plsm_insert( &plsm, &value );
+    TEST_ASSERT( id[ 99 ] != stale );
+    TEST_ASSERT_EQUAL( stale & 0xffffffff, id[ 99 ] & 0xffffffff );
+    TEST_ASSERT( plsm_ref( &plsm, stale ) == NULL );
+    TEST_ASSERT_EQUAL( 1000, *(pl_size_t*)plsm_ref( &plsm, id[ 99 ] ) );
+    id[ 10 ] = plsm_insert( &plsm, &value );
+    TEST_ASSERT_EQUAL( 100, plcm_used_for_type( &plsm.slot, plsm_slot_s ) );
+
+    /* Dense iteration. */
+    sum = 0;
+    for ( pl_size_t i = 0; i < plsm_size( &plsm ); i++ ) {
+        sum += ( (pl_size_t*)plsm_data( &plsm ) )[ i ];
+    }
+    TEST_ASSERT_EQUAL( 99 * 100 / 2 - 10 - 99 + 2000, sum );
+
+    /* Invalid ids. */
+    TEST_ASSERT( plsm_ref( &plsm, ( (pl_id_t)1 << 32 ) | 1000 ) == NULL );
+    TEST_ASSERT_FALSE( plsm_remove( &plsm, ( (pl_id_t)1 << 32 ) | 1000 ) );
+
+    plsm_clear( &plsm );
+    TEST_ASSERT_EQUAL( 0, plsm_size( &plsm ) );
+    for ( pl_size_t i = 0; i < 100; i++ ) {
+        TEST_ASSERT( plsm_ref( &plsm, id[ i ] ) == NULL );
+    }
+    id[ 0 ] = plsm_insert( &plsm, &value );
+    TEST_ASSERT_EQUAL( 1000, *(pl_size_t*)plsm_ref( &plsm, id[ 0 ] ) );
+    TEST_ASSERT_EQUAL( 100, plcm_used_for_type( &plsm.slot, plsm_slot_s ) );
+
+    plsm_del( &plsm );
+}
+
+
+void test_plgb( void )
+{
+    plgb_s plgb;
+    plsr_s sr;
+
+    plgb_new( &plgb, 8 );
+    TEST_ASSERT_EQUAL( 0, plgb_length( &plgb ) );
+
+    plgb_insert( &plgb, 0, "world", 5 );
+    plgb_insert( &plgb, 0, "hello ", 6 );
+    TEST_ASSERT_EQUAL( 11, plgb_length( &plgb ) );
+    TEST_ASSERT_EQUAL( 'h', *(char*)plgb_ref( &plgb, 0 ) );
+    TEST_ASSERT_EQUAL( 'w', *(char*)plgb_ref( &plgb, 6 ) );
+    TEST_ASSERT_EQUAL( 'd', *(char*)plgb_ref( &plgb, 10 ) );
+
+    sr = plgb_plsr( &plgb );
+    TEST_ASSERT_EQUAL( 11, plsr_length( sr ) );
+    TEST_ASSERT( strcmp( "hello world", plsr_string( sr ) ) == 0 );
+
+    /* Clustered edits at cursor. */
+    plgb_insert( &plgb, 5, ",", 1 );
+    plgb_insert( &plgb, 6, " big", 4 );
+    plgb_remove( &plgb, 10, 1 );
+    plgb_insert( &plgb, 10, "-", 1 );
+    TEST_ASSERT( strcmp( "hello, big-world", plsr_string( plgb_plsr( &plgb ) ) ) == 0 );
+
+    plgb_move( &plgb, 3 );
+    TEST_ASSERT_EQUAL( 3, plgb.gpos );
+    TEST_ASSERT_EQUAL( 'l', *(char*)plgb_ref( &plgb, 3 ) );
+    TEST_ASSERT_EQUAL( 'd', *(char*)plgb_ref( &plgb, 15 ) );
+    plgb_remove( &plgb, 0, 7 );
+    plgb_remove( &plgb, 5, 100 );
+    TEST_ASSERT_EQUAL( 5, plgb_length( &plgb ) );
+    plgb_remove( &plgb, 5, 1 );
+    plgb_remove( &plgb, 20, 1 );
+    TEST_ASSERT_EQUAL( 5, plgb_length( &plgb ) );
+    TEST_ASSERT( plgb.gend <= plcm_size( &plgb.plcm ) );
+    TEST_ASSERT( strcmp( "big-w", plsr_string( plgb_plsr( &plgb ) ) ) == 0 );
+
+    /* Growth with content after gap. */
+    plgb_clear( &plgb );
+    plgb_insert( &plgb, 0, "ab", 2 );
+    for ( int i = 0; i < 1000; i++ ) {
+        plgb_insert( &plgb, 1 + i, "x", 1 );
+    }
+    TEST_ASSERT_EQUAL( 1002, plgb_length( &plgb ) );
+    TEST_ASSERT_EQUAL( 'a', *(char*)plgb_ref( &plgb, 0 ) );
+    TEST_ASSERT_EQUAL( 'x', *(char*)plgb_ref( &plgb, 1000 ) );
+    TEST_ASSERT_EQUAL( 'b', *(char*)plgb_ref( &plgb, 1001 ) );
+    sr = plgb_plsr( &plgb );
+    TEST_ASSERT_EQUAL( 1002, plsr_length( sr ) );
+    TEST_ASSERT_EQUAL( 'b', plsr_string( sr )[ 1001 ] );
+    TEST_ASSERT_EQUAL( 0, plsr_string( sr )[ 1002 ] );
+    plgb_del( &plgb );
+
+    /* Storage can't grow beyond reservation. */
+    plcm_new_reserve( &plgb.plcm, 4096, 4096 );
+    plgb.gpos = 0;
+    plgb.gend = 4096;
+    for ( int i = 0; i < 4096; i++ ) {
+        plgb_insert( &plgb, 0, "x", 1 );
+    }
+    plgb_insert( &plgb, 100, "y", 1 );
+    TEST_ASSERT_EQUAL( 4096, plgb_length( &plgb ) );
+    TEST_ASSERT_EQUAL( 'x', *(char*)plgb_ref( &plgb, 100 ) );
+    TEST_ASSERT( plsr_is_null( plgb_plsr( &plgb ) ) );
+
+    plgb_del( &plgb );
+}
+
+
+void test_plro( void )
+{
+    plbm_s        plbm;
+    plro_s        plro;
+    plro_s        rest;
+    plro_cursor_s cursor;
+    plsr_s        slice;
+    plcm_s        plcm;
+    char          ref[ 4096 ];
+    pl_size_t     len;
+    pl_size_t     pos;
+
+    plbm_new( &plbm, 4096, 16 + plro_node_overhead() );
+    plro = plro_init( &plbm, 16 );
+    TEST_ASSERT_EQUAL( 0, plro_length( &plro ) );
+    TEST_ASSERT( plro_ref( &plro, 0 ) == NULL );
+
+    plro_insert( &plro, 0, "0123456789abcdefghijklmnopqrstuvwxyz", 36 );
+    TEST_ASSERT_EQUAL( 36, plro_length( &plro ) );
+    TEST_ASSERT_EQUAL( 'a', *(char*)plro_ref( &plro, 10 ) );
+    TEST_ASSERT_EQUAL( 'z', *(char*)plro_ref( &plro, 35 ) );
+    TEST_ASSERT( plro_ref( &plro, 36 ) == NULL );
+
+    /* Edits against reference content. */
+    memcpy( ref, "0123456789abcdefghijklmnopqrstuvwxyz", 36 );
+    len = 36;
+    pos = 7;
+    for ( int i = 0; i < 500; i++ ) {
+        pos = ( pos * 31 + 17 ) % ( len + 1 );
+        if ( i % 3 == 2 && len > 10 ) {
+            pl_size_t size;
+            size = ( i % 13 ) + 1;
+            if ( pos + size > len ) {
+                size = len - pos;
+            }
+            plro_remove( &plro, pos, size );
+            memmove( ref + pos, ref + pos + size, len - pos - size );
+            len -= size;
+        } else {
+            const char* str = "ABCDEFGHIJKLMNOPQRSTU";
+            pl_size_t   size;
+            size = ( i % 21 ) + 1;
+            plro_insert( &plro, pos, (pl_t)str, size );
+            memmove( ref + pos + size, ref + pos, len - pos );
+            memcpy( ref + pos, str, size );
+            len += size;
+        }
+    }
+    TEST_ASSERT_EQUAL( len, plro_length( &plro ) );
+    for ( pl_size_t i = 0; i < len; i++ ) {
+        TEST_ASSERT_EQUAL( ref[ i ], *(char*)plro_ref( &plro, i ) );
+    }
+
+    /* Leaf slices. */
+    pos = 0;
+    cursor = plro_cursor_init( &plro, 0 );
+    while ( !plsr_is_null( slice = plro_cursor_next( &cursor ) ) ) {
+        TEST_ASSERT( plsr_length( slice ) > 0 && plsr_length( slice ) <= 16 );
+        TEST_ASSERT( memcmp( ref + pos, plsr_string( slice ), plsr_length( slice ) ) == 0 );
+        pos += plsr_length( slice );
+    }
+    TEST_ASSERT_EQUAL( len, pos );
+
+    /* Split and concat. */
+    rest = plro_split( &plro, 100 );
+    TEST_ASSERT_EQUAL( 100, plro_length( &plro ) );
+    TEST_ASSERT_EQUAL( len - 100, plro_length( &rest ) );
+    TEST_ASSERT_EQUAL( ref[ 100 ], *(char*)plro_ref( &rest, 0 ) );
+    TEST_ASSERT_EQUAL( ref[ 99 ], *(char*)plro_ref( &plro, 99 ) );
+    plro_concat( &rest, &plro );
+    TEST_ASSERT_EQUAL( 0, plro_length( &plro ) );
+    TEST_ASSERT_EQUAL( len, plro_length( &rest ) );
+    TEST_ASSERT_EQUAL( ref[ 0 ], *(char*)plro_ref( &rest, len - 100 ) );
+
+    /* Flatten. */
+    plcm_new( &plcm, 16 );
+    plcm_store( &plcm, "<", 1 );
+    plro_flatten( &rest, &plcm );
+    TEST_ASSERT_EQUAL( len + 1, plcm_used( &plcm ) );
+    TEST_ASSERT( memcmp( ref + 100, plcm_data( &plcm ) + 1, len - 100 ) == 0 );
+    TEST_ASSERT( memcmp( ref, plcm_data( &plcm ) + 1 + len - 100, 100 ) == 0 );
+    plcm_del( &plcm );
+
+    plro_remove( &rest, 10, 1000000 );
+    TEST_ASSERT_EQUAL( 10, plro_length( &rest ) );
+    plro_clear( &rest );
+    TEST_ASSERT_EQUAL( 0, plro_length( &rest ) );
+    plbm_del( &plbm );
+
+    /* Chunk count stays bounded with single byte edits. */
+    plbm_new( &plbm, 65536, 64 + plro_node_overhead() );
+    plro = plro_init( &plbm, 64 );
+    memset( ref, 'x', 64 );
+    for ( int i = 0; i < 2000; i++ ) {
+        plro_insert( &plro, plro_length( &plro ), ref, 64 );
+    }
+    pos = 12345;
+    for ( int i = 0; i < 20000; i++ ) {
+        pos = ( pos * 1103515245 + 12345 ) % 2147483648;
+        if ( i % 2 == 0 ) {
+            plro_remove( &plro, pos % plro_length( &plro ), 1 );
+        } else {
+            plro_insert( &plro, pos % ( plro_length( &plro ) + 1 ), "y", 1 );
+        }
+    }
+    TEST_ASSERT_EQUAL( 128000, plro_length( &plro ) );
+    len = 0;
+    cursor = plro_cursor_init( &plro, 0 );
+    while ( !plsr_is_null( slice = plro_cursor_next( &cursor ) ) ) {
+        len++;
+    }
+    TEST_ASSERT( len <= 2 * 128000 / 64 + 1 );
+    plro_clear( &plro );
+    plbm_del( &plbm );
+}
+
+
+void test_plrb( void )
+{
+    plrb_s    plrb;
+    plsr_s    spans[ 2 ];
+    pl_size_t value;
+
+    plrb_new( &plrb, sizeof( pl_size_t ), 4 );
+    TEST_ASSERT_EQUAL( 0, plrb_count( &plrb ) );
+    TEST_ASSERT_EQUAL( 0, plrb_spans( &plrb, spans ) );
+    TEST_ASSERT_FALSE( plrb_pop_front( &plrb, &value ) );
+    TEST_ASSERT_FALSE( plrb_pop_back( &plrb, &value ) );
+
+    /* Queue with wrap-around. */
+    for ( pl_size_t i = 0; i < 3; i++ ) {
+        plrb_push_back( &plrb, &i );
+    }
+    TEST_ASSERT_TRUE( plrb_pop_front( &plrb, &value ) );
+    TEST_ASSERT_EQUAL( 0, value );
+    TEST_ASSERT_TRUE( plrb_pop_front( &plrb, NULL ) );
+    for ( pl_size_t i = 3; i < 6; i++ ) {
+        plrb_push_back( &plrb, &i );
+    }
+    TEST_ASSERT_EQUAL( 4, plrb_count( &plrb ) );
+    TEST_ASSERT_EQUAL( 4 * sizeof( pl_size_t ), plcm_size( &plrb.plcm ) );
+    for ( pl_size_t i = 0; i < 4; i++ ) {
+        TEST_ASSERT_EQUAL( i + 2, *(pl_size_t*)plrb_ref( &plrb, i ) );
+    }
+    TEST_ASSERT( plrb_ref( &plrb, 4 ) == NULL );
+    TEST_ASSERT_EQUAL( 2, plrb_spans( &plrb, spans ) );
+    TEST_ASSERT_EQUAL( 2 * sizeof( pl_size_t ), plsr_length( spans[ 0 ] ) );
+    TEST_ASSERT_EQUAL( 2, *(pl_size_t*)plsr_string( spans[ 0 ] ) );
+    TEST_ASSERT_EQUAL( 2 * sizeof( pl_size_t ), plsr_length( spans[ 1 ] ) );
+    TEST_ASSERT_EQUAL( 4, *(pl_size_t*)plsr_string( spans[ 1 ] ) );
+
+    /* Growth unwraps. */
+    value = 6;
+    plrb_push_back( &plrb, &value );
+    TEST_ASSERT_EQUAL( 8 * sizeof( pl_size_t ), plcm_size( &plrb.plcm ) );
+    TEST_ASSERT_EQUAL( 1, plrb_spans( &plrb, spans ) );
+    TEST_ASSERT_EQUAL( 5 * sizeof( pl_size_t ), plsr_length( spans[ 0 ] ) );
+    for ( pl_size_t i = 0; i < 5; i++ ) {
+        TEST_ASSERT_EQUAL( i + 2, ( (pl_size_t*)plsr_string( spans[ 0 ] ) )[ i ] );
+    }
+
+    /* Deque at both ends. */
+    value = 1;
+    plrb_push_front( &plrb, &value );
+    value = 0;
+    plrb_push_front( &plrb, &value );
+    TEST_ASSERT_EQUAL( 7, plrb_count( &plrb ) );
+    for ( pl_size_t i = 0; i < 7; i++ ) {
+        TEST_ASSERT_EQUAL( i, *(pl_size_t*)plrb_ref( &plrb, i ) );
+    }
+    TEST_ASSERT_TRUE( plrb_pop_back( &plrb, &value ) );
+    TEST_ASSERT_EQUAL( 6, value );
+    for ( pl_size_t i = 100; i < 200; i++ ) {
+        plrb_push_front( &plrb, &i );
+    }
+    TEST_ASSERT_EQUAL( 106, plrb_count( &plrb ) );
+    TEST_ASSERT_EQUAL( 199, *(pl_size_t*)plrb_ref( &plrb, 0 ) );
+    TEST_ASSERT_EQUAL( 5, *(pl_size_t*)plrb_ref( &plrb, 105 ) );
+    for ( pl_size_t i = 0; i < 100; i++ ) {
+        TEST_ASSERT_TRUE( plrb_pop_front( &plrb, &value ) );
+        TEST_ASSERT_EQUAL( 199 - i, value );
+    }
+    TEST_ASSERT_TRUE( plrb_pop_front( &plrb, &value ) );
+    TEST_ASSERT_EQUAL( 0, value );
+
+    plrb_clear( &plrb );
+    TEST_ASSERT_EQUAL( 0, plrb_count( &plrb ) );
+    plrb_del( &plrb );
+
+    /* Item size of 0 is invalid. */
+    plrb_new( &plrb, 0, 4 );
+    value = 1;
+    plrb_push_back( &plrb, &value );
+    plrb_push_front( &plrb, &value );
+    TEST_ASSERT_EQUAL( 0, plrb_count( &plrb ) );
+    TEST_ASSERT_FALSE( plrb_pop_front( &plrb, &value ) );
+    plrb_del( &plrb );
+}